@@ -0,0 +1,98 @@
+#ifndef SYSTEM_UTILS_ALIGNED_BUFFER_HPP
+#define SYSTEM_UTILS_ALIGNED_BUFFER_HPP
+
+/**
+ * @file AlignedBuffer.hpp
+ *
+ * This module declares the SystemUtils::AlignedBuffer class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SystemUtils {
+
+    /**
+     * This class holds a block of memory whose address is a multiple
+     * of a given alignment, such as is needed for the buffers used
+     * with files opened for direct I/O.  The memory starts out zeroed.
+     */
+    class AlignedBuffer {
+        // Constants
+    public:
+        /**
+         * This is the alignment used unless told otherwise, which
+         * suits the block size of most storage devices.
+         */
+        static constexpr size_t DEFAULT_ALIGNMENT = 4096;
+
+        // Lifecycle management
+    public:
+        ~AlignedBuffer() noexcept;
+        AlignedBuffer(const AlignedBuffer&) = delete;
+        AlignedBuffer(AlignedBuffer&&) noexcept;
+        AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+        AlignedBuffer& operator=(AlignedBuffer&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] size
+         *      This is the number of bytes the buffer should hold.
+         *
+         * @param[in] alignment
+         *      This is the number of which the address of the buffer
+         *      should be a multiple.  It's rounded up to a power of two.
+         */
+        explicit AlignedBuffer(size_t size = 0, size_t alignment = DEFAULT_ALIGNMENT);
+
+        /**
+         * This method returns the address of the first byte of the buffer.
+         *
+         * @return
+         *      The address of the first byte of the buffer is returned,
+         *      or nullptr if the buffer is empty.
+         */
+        uint8_t* GetData() const;
+
+        /**
+         * This method returns the number of bytes the buffer holds.
+         *
+         * @return
+         *      The number of bytes the buffer holds is returned.
+         */
+        size_t GetSize() const;
+
+        /**
+         * This method returns the number of which
+         * the address of the buffer is a multiple.
+         *
+         * @return
+         *      The number of which the address of the
+         *      buffer is a multiple is returned.
+         */
+        size_t GetAlignment() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_ALIGNED_BUFFER_HPP */
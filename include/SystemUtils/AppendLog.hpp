@@ -0,0 +1,166 @@
+#ifndef SYSTEM_UTILS_APPEND_LOG_HPP
+#define SYSTEM_UTILS_APPEND_LOG_HPP
+
+/**
+ * @file AppendLog.hpp
+ *
+ * This module declares the SystemUtils::AppendLog class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace SystemUtils {
+
+    /**
+     * This class appends records to a file, such as a write-ahead
+     * log, and lets callers wait until their records are stored on
+     * the device.
+     *
+     * Records appended from any number of threads are collected in
+     * memory, and a single worker thread writes everything collected
+     * so far to the file with one write and one sync, so that the
+     * cost of each sync is shared by all the records in the batch
+     * (group commit).  Space for the file to grow into is reserved
+     * ahead of time, a segment at a time.
+     *
+     * Records are appended as given, one after another; any framing
+     * needed to tell them apart later is up to the caller.
+     */
+    class AppendLog {
+        // Constants
+    public:
+        /**
+         * This is the number of bytes of space reserved for the log
+         * at a time, unless told otherwise.
+         */
+        static constexpr uint64_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+        // Lifecycle management
+    public:
+        /**
+         * This is the instance destructor.  It closes the log,
+         * waiting for any records appended to be stored.
+         */
+        ~AppendLog() noexcept;
+        AppendLog(const AppendLog&) = delete;
+        AppendLog(AppendLog&&) noexcept;
+        AppendLog& operator=(const AppendLog&) = delete;
+        AppendLog& operator=(AppendLog&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         */
+        AppendLog();
+
+        /**
+         * This method opens the log, creating its file if it doesn't
+         * exist. Records are appended after anything already in the file.
+         *
+         * @param[in] path
+         *      This is the path to the file holding the log.
+         *
+         * @param[in] segmentSize
+         *      This is the number of bytes of space to reserve
+         *      for the file at a time as it grows.
+         *
+         * @return
+         *      An indication of whether or not the log
+         *      was opened is returned.
+         */
+        bool Open(
+            const std::string& path,
+            uint64_t segmentSize = DEFAULT_SEGMENT_SIZE
+        );
+
+        /**
+         * This method closes the log, after waiting for any
+         * records appended to be stored.
+         */
+        void Close();
+
+        /**
+         * This method appends a record to the log.  It returns
+         * right away, before the record is stored.
+         *
+         * @param[in] record
+         *      This is where to fetch the bytes of the record.
+         *
+         * @param[in] size
+         *      This is the number of bytes in the record.
+         *
+         * @return
+         *      The offset in the file just past the end of the record
+         *      is returned.  Once everything up to this offset is stored,
+         *      the record is durable.
+         *
+         * @retval 0
+         *      This is returned if the log isn't open, or if
+         *      storing earlier records failed.
+         */
+        uint64_t Append(const void* record, size_t size);
+
+        /**
+         * This method waits until everything in the log up to
+         * the given offset is stored on the device.
+         *
+         * @param[in] offset
+         *      This is the offset returned when appending a record.
+         *
+         * @return
+         *      An indication of whether or not everything up to
+         *      the given offset was stored is returned. It's false
+         *      if storing failed or the log was closed first.
+         */
+        bool WaitDurable(uint64_t offset);
+
+        /**
+         * This method appends a record to the log and waits until
+         * it's stored on the device.
+         *
+         * @param[in] record
+         *      This is where to fetch the bytes of the record.
+         *
+         * @param[in] size
+         *      This is the number of bytes in the record.
+         *
+         * @return
+         *      An indication of whether or not the record
+         *      was stored is returned.
+         */
+        bool AppendDurable(const void* record, size_t size);
+
+        /**
+         * This method returns the offset in the file up to
+         * which everything is known to be stored on the device.
+         *
+         * @return
+         *      The offset in the file up to which everything is
+         *      known to be stored on the device is returned.
+         */
+        uint64_t GetDurableOffset() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_APPEND_LOG_HPP */
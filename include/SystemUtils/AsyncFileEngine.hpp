@@ -0,0 +1,192 @@
+#ifndef SYSTEM_UTILS_ASYNC_FILE_ENGINE_HPP
+#define SYSTEM_UTILS_ASYNC_FILE_ENGINE_HPP
+
+/**
+ * @file AsyncFileEngine.hpp
+ *
+ * This module declares the SystemUtils::AsyncFileEngine class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "File.hpp"
+
+#include <functional>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class reads and writes files asynchronously. Requests are
+     * handed to the operating system without waiting for earlier ones
+     * to complete, up to a set queue depth, so that many of them can
+     * be in flight at once, and the owner is told when each one
+     * completes through a delegate called by the engine's worker thread.
+     *
+     * Requests beyond the queue depth wait in the engine, and are
+     * started in the order they were submitted as earlier ones complete.
+     */
+    class AsyncFileEngine {
+        // Types
+    public:
+        /**
+         * This is the type of function called when a request completes.
+         *
+         * @param[in] success
+         *      This indicates whether or not the request succeeded.
+         *      Reading past the end of the file is not a failure;
+         *      it just transfers fewer bytes than requested.
+         *
+         * @param[in] bytesTransferred
+         *      This is the number of bytes actually read or written.
+         */
+        typedef std::function< void(bool success, size_t bytesTransferred) > CompletionDelegate;
+
+        /**
+         * These are the kinds of requests the engine can perform.
+         */
+        enum class Operation {
+            /**
+             * Read bytes from the file into the buffer.
+             */
+            Read,
+
+            /**
+             * Write bytes from the buffer to the file.
+             */
+            Write,
+        };
+
+        /**
+         * This holds everything needed to perform one request.
+         */
+        struct Request {
+            /**
+             * This selects whether to read or write.
+             */
+            Operation operation = Operation::Read;
+
+            /**
+             * This is the file to read or write. It must be open,
+             * and must stay open until the request completes.
+             *
+             * Once opened, a file can only ever be served by one
+             * engine.  Requests on it handed to any other engine fail,
+             * and the file's last error says why, until the file is
+             * closed and opened again.
+             */
+            File* file = nullptr;
+
+            /**
+             * This is the offset from the start of the file to the
+             * first byte to read or write.  The current position
+             * in the file is neither used nor changed.
+             */
+            uint64_t offset = 0;
+
+            /**
+             * This is where to put the bytes read, or fetch the
+             * bytes to write.  It must stay valid until the
+             * request completes.
+             */
+            void* buffer = nullptr;
+
+            /**
+             * This is the number of bytes to read or write.
+             * It must fit in 32 bits.
+             */
+            size_t numBytes = 0;
+
+            /**
+             * This is the function to call when the request completes.
+             */
+            CompletionDelegate completionDelegate;
+        };
+
+        // Constants
+    public:
+        /**
+         * This is the number of requests the engine will have
+         * in flight at once unless told otherwise.
+         */
+        static constexpr size_t DEFAULT_QUEUE_DEPTH = 32;
+
+        // Lifecycle management
+    public:
+        ~AsyncFileEngine() noexcept;
+        AsyncFileEngine(const AsyncFileEngine&) = delete;
+        AsyncFileEngine(AsyncFileEngine&&) noexcept;
+        AsyncFileEngine& operator=(const AsyncFileEngine&) = delete;
+        AsyncFileEngine& operator=(AsyncFileEngine&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor. It starts the
+         * worker thread of the engine.
+         *
+         * @param[in] queueDepth
+         *      This is the largest number of requests the engine
+         *      should have in flight at once.
+         */
+        explicit AsyncFileEngine(size_t queueDepth = DEFAULT_QUEUE_DEPTH);
+
+        /**
+         * This method hands the engine a single request.
+         *
+         * @param[in] request
+         *      This is the request to perform.
+         */
+        void Submit(Request request);
+
+        /**
+         * This method hands the engine a batch of requests, which are
+         * started together, up to the queue depth, under a single
+         * acquisition of the engine's lock.
+         *
+         * @param[in] requests
+         *      These are the requests to perform.
+         */
+        void Submit(std::vector< Request > requests);
+
+        /**
+         * This method returns the number of requests which have been
+         * submitted but haven't yet completed.
+         *
+         * @return
+         *      The number of requests which have been submitted
+         *      but haven't yet completed is returned.
+         */
+        size_t GetOutstandingCount() const;
+
+        /**
+         * This method waits until every request submitted so far has
+         * completed and had its delegate called.
+         *
+         * @note
+         *      This must not be called from a completion delegate.
+         */
+        void WaitUntilIdle();
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the
+         * platform-specific part of the implementation and declared
+         * here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_ASYNC_FILE_ENGINE_HPP */
@@ -0,0 +1,155 @@
+#ifndef SYSTEM_UTILS_BUFFERED_READER_HPP
+#define SYSTEM_UTILS_BUFFERED_READER_HPP
+
+/**
+ * @file BufferedReader.hpp
+ *
+ * This module declares the SystemUtils::BufferedReader class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "IFile.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace SystemUtils {
+
+    /**
+     * This class reads from a file through a buffer, so that many
+     * small reads, such as those made by a parser reading a few bytes
+     * at a time, are served from memory rather than each going to
+     * the file.
+     *
+     * The reader takes over the current position in the file: it
+     * reads ahead of what it hands out, so the position in the file
+     * must not be used or changed while the reader is in use.
+     */
+    class BufferedReader {
+        // Constants
+    public:
+        /**
+         * This is the number of bytes the reader buffers
+         * unless told otherwise.
+         */
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 65536;
+
+        // Lifecycle management
+    public:
+        ~BufferedReader() noexcept;
+        BufferedReader(const BufferedReader&) = delete;
+        BufferedReader(BufferedReader&&) noexcept;
+        BufferedReader& operator=(const BufferedReader&) = delete;
+        BufferedReader& operator=(BufferedReader&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] file
+         *      This is the file from which to read, starting at its
+         *      current position.  It must outlive the reader.
+         *
+         * @param[in] bufferSize
+         *      This is the number of bytes to read from the file at
+         *      once.  If zero, nothing is buffered and every read goes
+         *      straight to the file, which is best for files already
+         *      held in memory, such as StringFile.
+         */
+        explicit BufferedReader(IFile& file, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        /**
+         * This method reads up to the given number of bytes.
+         *
+         * @param[out] buffer
+         *      This is where to put the bytes read.
+         *
+         * @param[in] numBytes
+         *      This is the number of bytes to read.
+         *
+         * @return
+         *      The number of bytes actually read is returned.  This is
+         *      less than requested only if the end of the file is reached.
+         */
+        size_t Read(void* buffer, size_t numBytes);
+
+        /**
+         * This method reads exactly the given number of bytes.
+         *
+         * @param[out] buffer
+         *      This is where to put the bytes read.
+         *
+         * @param[in] numBytes
+         *      This is the number of bytes to read.
+         *
+         * @return
+         *      An indication of whether or not all the bytes were read
+         *      is returned. If not, the end of the file was reached,
+         *      and whatever was there has been read.
+         */
+        bool ReadExactly(void* buffer, size_t numBytes);
+
+        /**
+         * This method looks at upcoming bytes without reading them,
+         * so they're still there for the next read.
+         *
+         * @param[out] buffer
+         *      This is where to put the bytes.
+         *
+         * @param[in] numBytes
+         *      This is the number of bytes to look at.  At most the
+         *      buffer size may be looked at once, unless nothing
+         *      is buffered.
+         *
+         * @return
+         *      The number of bytes actually put in the
+         *      buffer is returned.
+         */
+        size_t Peek(void* buffer, size_t numBytes);
+
+        /**
+         * This method reads the next line of text, which ends
+         * either with a line feed or the end of the file.
+         *
+         * @param[out] line
+         *      This is where to store the line read, without the line
+         *      feed or any carriage return just before it.
+         *
+         * @return
+         *      An indication of whether or not a line was read is
+         *      returned. It's false once the end of the file is reached.
+         */
+        bool ReadLine(std::string& line);
+
+        /**
+         * This method returns the position in the file of
+         * the next byte the reader will hand out.
+         *
+         * @return
+         *      The position in the file of the next byte
+         *      the reader will hand out is returned.
+         */
+        uint64_t GetPosition() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_BUFFERED_READER_HPP */
@@ -0,0 +1,134 @@
+#ifndef SYSTEM_UTILS_BUFFERED_WRITER_HPP
+#define SYSTEM_UTILS_BUFFERED_WRITER_HPP
+
+/**
+ * @file BufferedWriter.hpp
+ *
+ * This module declares the SystemUtils::BufferedWriter class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "IFile.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace SystemUtils {
+
+    /**
+     * This class writes to a file through a buffer, collecting
+     * many small writes in memory and handing them to the file
+     * together once the buffer fills up or is flushed.
+     *
+     * The writer takes over the current position in the file, so
+     * the position must not be used or changed while the writer
+     * has bytes buffered.
+     */
+    class BufferedWriter {
+        // Constants
+    public:
+        /**
+         * This is the number of bytes the writer buffers
+         * unless told otherwise.
+         */
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 65536;
+
+        // Lifecycle management
+    public:
+        /**
+         * This is the instance destructor. It flushes
+         * any bytes still buffered.
+         */
+        ~BufferedWriter() noexcept;
+        BufferedWriter(const BufferedWriter&) = delete;
+        BufferedWriter(BufferedWriter&&) noexcept;
+        BufferedWriter& operator=(const BufferedWriter&) = delete;
+        BufferedWriter& operator=(BufferedWriter&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] file
+         *      This is the file to which to write, starting at its
+         *      current position.  It must outlive the writer.
+         *
+         * @param[in] bufferSize
+         *      This is the number of bytes to collect before writing
+         *      them to the file.  If zero, nothing is buffered and
+         *      every write goes straight to the file, which is best
+         *      for files already held in memory, such as StringFile.
+         */
+        explicit BufferedWriter(IFile& file, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        /**
+         * This method writes the given bytes.  They may only be
+         * buffered, to be written to the file later.
+         *
+         * @param[in] buffer
+         *      This is where to fetch the bytes to write.
+         *
+         * @param[in] numBytes
+         *      This is the number of bytes to write.
+         *
+         * @return
+         *      The number of bytes accepted is returned.  It's less
+         *      than requested only if writing to the file failed.
+         */
+        size_t Write(const void* buffer, size_t numBytes);
+
+        /**
+         * This method writes the given string.  It may only be
+         * buffered, to be written to the file later.
+         *
+         * @param[in] text
+         *      This is the string to write.
+         *
+         * @return
+         *      The number of bytes accepted is returned.  It's less
+         *      than the length of the string only if writing to the
+         *      file failed.
+         */
+        size_t Write(const std::string& text);
+
+        /**
+         * This method writes any buffered bytes to the file.
+         *
+         * @return
+         *      An indication of whether or not all buffered bytes
+         *      were written to the file is returned.
+         */
+        bool Flush();
+
+        /**
+         * This method returns the position in the file at which
+         * the next byte written will end up.
+         *
+         * @return
+         *      The position in the file at which the next byte
+         *      written will end up is returned.
+         */
+        uint64_t GetPosition() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_BUFFERED_WRITER_HPP */
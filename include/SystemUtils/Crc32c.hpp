@@ -0,0 +1,198 @@
+#ifndef SYSTEM_UTILS_CRC32C_HPP
+#define SYSTEM_UTILS_CRC32C_HPP
+
+/**
+ * @file Crc32c.hpp
+ *
+ * This module declares the SystemUtils::Crc32c class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "IFile.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SystemUtils {
+
+    /**
+     * This class calculates the CRC-32C (Castagnoli) checksum of
+     * data given to it a piece at a time.
+     *
+     * The checksum is calculated with the CRC instructions of the
+     * processor when it has them (SSE 4.2 or ARMv8), which is
+     * determined at run time, and with lookup tables otherwise.
+     */
+    class Crc32c {
+        // Constants
+    public:
+        /**
+         * This is the number of bytes of a file checksummed by
+         * each thread at a time when checksumming in parallel.
+         */
+        static constexpr uint64_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+        // Lifecycle management
+    public:
+        ~Crc32c() noexcept;
+        Crc32c(const Crc32c&) = delete;
+        Crc32c(Crc32c&&) noexcept;
+        Crc32c& operator=(const Crc32c&) = delete;
+        Crc32c& operator=(Crc32c&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         */
+        Crc32c();
+
+        /**
+         * This method starts the checksum over, as if
+         * no data had been given yet.
+         */
+        void Reset();
+
+        /**
+         * This method adds the given data to the checksum.
+         *
+         * @param[in] data
+         *      This is where to fetch the data to add.
+         *
+         * @param[in] size
+         *      This is the number of bytes to add.
+         */
+        void Update(const void* data, size_t size);
+
+        /**
+         * This method adds the given region of a file to the checksum.
+         *
+         * @param[in] file
+         *      This is the file from which to read the data to add.
+         *      Its current position isn't used or changed.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first byte to add.
+         *
+         * @param[in] length
+         *      This is the number of bytes to add.  If zero, everything
+         *      from the offset to the end of the file is added.
+         *
+         * @return
+         *      An indication of whether or not the whole
+         *      region could be read is returned.
+         */
+        bool Update(
+            const IFile& file,
+            uint64_t offset = 0,
+            uint64_t length = 0
+        );
+
+        /**
+         * This method returns the checksum of all the data given so far.
+         *
+         * @return
+         *      The checksum of all the data given so far is returned.
+         */
+        uint32_t GetValue() const;
+
+        /**
+         * This function calculates the checksum of the given data.
+         *
+         * @param[in] data
+         *      This is where to fetch the data to checksum.
+         *
+         * @param[in] size
+         *      This is the number of bytes to checksum.
+         *
+         * @return
+         *      The checksum of the given data is returned.
+         */
+        static uint32_t Compute(const void* data, size_t size);
+
+        /**
+         * This function calculates the checksum of the given region
+         * of a file, splitting it into chunks which are checksummed
+         * by separate threads, and then combined into the checksum
+         * of the whole region.
+         *
+         * @param[in] file
+         *      This is the file from which to read the data to
+         *      checksum.  Its current position isn't used or changed.
+         *
+         * @param[out] value
+         *      This is where to store the checksum of the region.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first
+         *      byte to checksum.
+         *
+         * @param[in] length
+         *      This is the number of bytes to checksum.  If zero,
+         *      everything from the offset to the end of the
+         *      file is checksummed.
+         *
+         * @param[in] numThreads
+         *      This is the number of threads to use.
+         *
+         * @param[in] chunkSize
+         *      This is the number of bytes to checksum
+         *      in each thread at a time.
+         *
+         * @return
+         *      An indication of whether or not the whole
+         *      region could be read is returned.
+         */
+        static bool Compute(
+            const IFile& file,
+            uint32_t& value,
+            uint64_t offset = 0,
+            uint64_t length = 0,
+            size_t numThreads = 1,
+            uint64_t chunkSize = DEFAULT_CHUNK_SIZE
+        );
+
+        /**
+         * This function combines the checksums of two consecutive
+         * pieces of data into the checksum of both together,
+         * without looking at the data again.
+         *
+         * @param[in] first
+         *      This is the checksum of the first piece of data.
+         *
+         * @param[in] second
+         *      This is the checksum of the second piece of data.
+         *
+         * @param[in] secondSize
+         *      This is the number of bytes in the second piece of data.
+         *
+         * @return
+         *      The checksum of both pieces of data
+         *      together is returned.
+         */
+        static uint32_t Combine(
+            uint32_t first,
+            uint32_t second,
+            uint64_t secondSize
+        );
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_CRC32C_HPP */
@@ -0,0 +1,201 @@
+#ifndef SYSTEM_UTILS_DIRECTORY_ITERATOR_HPP
+#define SYSTEM_UTILS_DIRECTORY_ITERATOR_HPP
+
+/**
+ * @file DirectoryIterator.hpp
+ *
+ * This module declares the SystemUtils::DirectoryIterator class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <functional>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <time.h>
+
+namespace SystemUtils {
+
+    /**
+     * This class lists the entries of a directory one at a time,
+     * fetching them from the operating system in large batches, so
+     * that even a huge directory can be listed without holding all
+     * of its entries in memory at once.
+     *
+     * Along with its name, each entry comes with its type, size,
+     * and last modified time, as delivered in the batch, so there's
+     * no need to look up each entry again to learn them.
+     */
+    class DirectoryIterator {
+        // Types
+    public:
+        /**
+         * These are the kinds of entries found in a directory.
+         */
+        enum class EntryType {
+            /**
+             * The entry is a regular file.
+             */
+            File,
+
+            /**
+             * The entry is a directory.
+             */
+            Directory,
+
+            /**
+             * The entry is a symbolic link or similar redirection
+             * to somewhere else in the file system.
+             */
+            SymbolicLink,
+        };
+
+        /**
+         * This describes one entry in a directory.
+         */
+        struct Entry {
+            /**
+             * This is the name of the entry within its directory.
+             */
+            std::string name;
+
+            /**
+             * This is the path to the entry, made by
+             * appending its name to the directory path.
+             */
+            std::string path;
+
+            /**
+             * This is the kind of entry.
+             */
+            EntryType type = EntryType::File;
+
+            /**
+             * This is the size of the entry in bytes.
+             */
+            uint64_t size = 0;
+
+            /**
+             * This is the time the entry was last modified.
+             */
+            time_t lastModifiedTime = 0;
+        };
+
+        /**
+         * This is the type of function called by Walk for each entry
+         * found.
+         *
+         * @param[in] entry
+         *      This describes the entry found.
+         *
+         * @return
+         *      For a directory, an indication of whether or not
+         *      to walk its entries as well is returned.  This is
+         *      ignored for other kinds of entries.
+         */
+        typedef std::function< bool(const Entry& entry) > Visitor;
+
+        // Constants
+    public:
+        /**
+         * This is the number of bytes of entries fetched from the
+         * operating system at once unless told otherwise.
+         */
+        static constexpr size_t DEFAULT_BATCH_BYTES = 65536;
+
+        // Lifecycle management
+    public:
+        ~DirectoryIterator() noexcept;
+        DirectoryIterator(const DirectoryIterator&) = delete;
+        DirectoryIterator(DirectoryIterator&&) noexcept;
+        DirectoryIterator& operator=(const DirectoryIterator&) = delete;
+        DirectoryIterator& operator=(DirectoryIterator&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] batchBytes
+         *      This is the number of bytes of entries
+         *      to fetch from the operating system at once.
+         */
+        explicit DirectoryIterator(size_t batchBytes = DEFAULT_BATCH_BYTES);
+
+        /**
+         * This method starts listing the given directory.
+         *
+         * @param[in] directory
+         *      This is the path to the directory to list.
+         *
+         * @return
+         *      An indication of whether or not the
+         *      directory was opened is returned.
+         */
+        bool Open(const std::string& directory);
+
+        /**
+         * This method fetches the next entry of the directory,
+         * skipping the "." and ".." entries.
+         *
+         * @param[out] entry
+         *      This is where to store the next entry.
+         *
+         * @return
+         *      An indication of whether or not there was another
+         *      entry is returned.
+         */
+        bool Next(Entry& entry);
+
+        /**
+         * This method stops listing the directory.
+         */
+        void Close();
+
+        /**
+         * This method walks a directory tree, listing each directory
+         * and any subdirectories the visitor asks for on a pool of
+         * threads, so that different directories are listed at once.
+         * Symbolic links are reported but not followed.
+         *
+         * @param[in] directory
+         *      This is the path to the directory at the top of the tree.
+         *
+         * @param[in] visitor
+         *      This is called for each entry found. It may be called
+         *      from several threads at once.
+         *
+         * @param[in] numThreads
+         *      This is the number of threads to use for listing directories.
+         *
+         * @return
+         *      An indication of whether or not every directory
+         *      walked could be listed is returned.
+         */
+        static bool Walk(
+            const std::string& directory,
+            Visitor visitor,
+            size_t numThreads = 1
+        );
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the
+         * platform-specific part of the implementation and declared
+         * here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_DIRECTORY_ITERATOR_HPP */
@@ -1,10 +1,14 @@
 #ifndef SYSTEM_UTILS_FILE_HPP
 #define SYSTEM_UTILS_FILE_HPP
 
+#include "AlignedBuffer.hpp"
 #include "IFile.hpp"
 #include "IFileSystemEntry.hpp"
 
+#include <functional>
 #include <memory>
+#include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -15,7 +19,281 @@ namespace SystemUtils {
      * native operating system.
     */
     class File: public IFileSystemEntry {
+        // Types
+    public:
+        /**
+         * These are the ways in which a region of
+         * the file may be mapped into memory.
+         */
+        enum class MapMode {
+            /**
+             * The mapped memory may only be read.
+             */
+            ReadOnly,
+
+            /**
+             * The mapped memory may be read and written, and
+             * writes are made to the file itself, visible to any
+             * other process which maps or reads the file.
+             */
+            SharedWritable,
+        };
+
+        /**
+         * These are the ways in which a file may use
+         * the operating system's file cache.
+         */
+        enum class CacheMode {
+            /**
+             * Reads and writes go through the file cache.
+             */
+            Cached,
+
+            /**
+             * Reads and writes go directly between the device and
+             * the caller's memory, bypassing the file cache, so
+             * that scanning the file doesn't push other files out
+             * of the cache.  Offsets, lengths, and buffer addresses
+             * must all be multiples of the block size.
+             */
+            Direct,
+        };
+
+        /**
+         * These are the hints which may be given about how
+         * the file, or part of it, is going to be accessed,
+         * so that the operating system can cache it accordingly.
+         */
+        enum class AccessHint {
+            /**
+             * Nothing in particular is expected.
+             */
+            Normal,
+
+            /**
+             * The file will be read from start to end, so it's worth
+             * reading ahead aggressively, and parts already read
+             * needn't stay cached for long.  This is the hint to give
+             * for one-pass scans, so they don't push everything
+             * else out of the cache.
+             */
+            Sequential,
+
+            /**
+             * The file will be accessed in no particular order,
+             * so reading ahead would be wasted effort.
+             */
+            Random,
+
+            /**
+             * The given region will be needed soon, so it's worth
+             * starting to bring it into memory now.
+             */
+            WillNeed,
+
+            /**
+             * The given region won't be needed again soon, such as
+             * a part of the file already consumed, so the memory
+             * caching it may be given to something else.
+             */
+            DontNeed,
+        };
+
+        /**
+         * This holds the progress made copying a directory.
+         */
+        struct CopyProgress {
+            /**
+             * This is the number of files copied so far.
+             */
+            uint64_t filesCopied = 0;
+
+            /**
+             * This is the number of files not copied so far
+             * because they were unchanged.
+             */
+            uint64_t filesSkipped = 0;
+
+            /**
+             * This is the number of bytes in the files copied so far.
+             */
+            uint64_t bytesCopied = 0;
+        };
+
+        /**
+         * This is the type of function called as a directory is copied,
+         * after each file is either copied or skipped.
+         *
+         * @param[in] progress
+         *      This is the progress made copying the directory so far.
+         */
+        typedef std::function< void(const CopyProgress& progress) > CopyProgressDelegate;
+
+        /**
+         * This holds everything known about a file or directory
+         * at one moment, gathered at once.
+         */
+        struct Metadata {
+            /**
+             * This indicates whether or not the file or directory exists.
+             * If not, none of the other properties are meaningful.
+             */
+            bool exists = false;
+
+            /**
+             * This indicates whether or not this is a directory.
+             */
+            bool isDirectory = false;
+
+            /**
+             * This is the size of the file in bytes.
+             */
+            uint64_t size = 0;
+
+            /**
+             * This is the time the contents were last modified, in
+             * nanoseconds since the UNIX epoch (1970-01-01 00:00:00 UTC).
+             */
+            uint64_t lastModifiedTime = 0;
+
+            /**
+             * This is the time the contents or attributes were last
+             * changed, in nanoseconds since the UNIX epoch
+             * (1970-01-01 00:00:00 UTC).
+             */
+            uint64_t changeTime = 0;
+
+            /**
+             * This identifies the file uniquely within its device.
+             * Two paths with the same file and device identifiers
+             * lead to the same file.
+             */
+            uint64_t fileId = 0;
 
+            /**
+             * This identifies the device holding the file.
+             */
+            uint64_t deviceId = 0;
+        };
+
+        /**
+         * This represents a region of the file mapped into memory,
+         * so that it may be accessed directly without copying.
+         * The region is unmapped when the last reference to
+         * this object is released, or when the file is closed,
+         * whichever comes first.
+         */
+        class MappedView {
+            // Lifecycle management
+        public:
+            ~MappedView() noexcept;
+            MappedView(const MappedView&) = delete;
+            MappedView(MappedView&&) noexcept = delete;
+            MappedView& operator=(const MappedView&) = delete;
+            MappedView& operator=(MappedView&&) noexcept = delete;
+
+            // Methods
+        public:
+            /**
+             * This is the instance constructor. It's only used by
+             * the File class, which hands out mapped views.
+             */
+            MappedView();
+
+            /**
+             * This method returns the address of the first byte of the
+             * mapped region of the file.
+             *
+             * @return
+             *      The address of the first byte of the mapped region
+             *      of the file is returned, or nullptr if the region
+             *      is no longer mapped.
+             */
+            uint8_t* GetData() const;
+
+            /**
+             * This method returns the number of bytes in the
+             * mapped region of the file.
+             *
+             * @return
+             *      The number of bytes in the mapped region of the
+             *      file is returned, or zero if the region is no
+             *      longer mapped.
+             */
+            size_t GetSize() const;
+
+            /**
+             * This method writes any changes made through the view
+             * in the given part of the mapped region to the file,
+             * waiting until they're stored on the device.
+             *
+             * @param[in] offset
+             *      This is the offset from the start of the mapped
+             *      region to the first byte to write.
+             *
+             * @param[in] length
+             *      This is the number of bytes to write.  If zero,
+             *      everything from the offset to the end of the
+             *      mapped region is written.
+             *
+             * @return
+             *      An indication of whether or not the changes
+             *      were written is returned.
+             */
+            bool Flush(size_t offset = 0, size_t length = 0);
+
+            /**
+             * This method tells the operating system how the given
+             * part of the mapped region is going to be accessed.
+             *
+             * @param[in] hint
+             *      This is the way in which the memory is expected
+             *      to be accessed.
+             *
+             * @param[in] offset
+             *      This is the offset from the start of the mapped
+             *      region to the first byte to which the hint applies.
+             *
+             * @param[in] length
+             *      This is the number of bytes to which the hint
+             *      applies.  If zero, the hint applies to everything
+             *      from the offset to the end of the mapped region.
+             *
+             * @return
+             *      An indication of whether or not the hint
+             *      was taken is returned.
+             */
+            bool Advise(
+                AccessHint hint,
+                size_t offset = 0,
+                size_t length = 0
+            );
+
+            /**
+             * This method unmaps the region of the file, if it's
+             * still mapped. Memory which was in the region must
+             * not be accessed afterwards.
+             */
+            void Unmap();
+
+            // Private properties
+        private:
+            friend class File;
+
+            /**
+             * This is the type of structure that contains the private
+             * properties of the instance. It is defined in the
+             * platform-specific part of the implementation.
+             */
+            struct Impl;
+
+            /**
+             * This contains the private properties of the instance.
+             */
+            std::unique_ptr< Impl > impl_;
+        };
+
+        // Lifecycle management
     public:
         ~File() noexcept;
         File(const File&) = delete;
@@ -48,6 +326,12 @@ namespace SystemUtils {
         virtual size_t Read(void* buffer, size_t numBytes) override;
         virtual size_t Write(const Buffer& buffer, size_t numBytes = 0, size_t offset = 0) override;
         virtual size_t Write(const void* buffer, size_t numBytes) override;
+        virtual size_t ReadAt(uint64_t offset, void* buffer, size_t numBytes) const override;
+        virtual size_t WriteAt(uint64_t offset, const void* buffer, size_t numBytes) override;
+        virtual size_t ReadV(const std::vector< ReadSegment >& segments) override;
+        virtual size_t WriteV(const std::vector< WriteSegment >& segments) override;
+        virtual size_t ReadVAt(uint64_t offset, const std::vector< ReadSegment >& segments) const override;
+        virtual size_t WriteVAt(uint64_t offset, const std::vector< WriteSegment >& segments) override;
         virtual std::shared_ptr< IFile > Clone() override;
 
         //Public methods
@@ -60,6 +344,198 @@ namespace SystemUtils {
         */
        File(std::string path);
 
+        /**
+         * This method opens the file for reading only.
+         *
+         * @param[in] cacheMode
+         *      This selects how the file uses the file cache.
+         *
+         * @return
+         *      An indication of whether or not the file
+         *      was opened is returned.
+         */
+        bool OpenReadOnly(CacheMode cacheMode);
+
+        /**
+         * This method opens the file for reading and writing,
+         * creating it if it doesn't exist.
+         *
+         * @param[in] cacheMode
+         *      This selects how the file uses the file cache.
+         *
+         * @return
+         *      An indication of whether or not the file
+         *      was opened is returned.
+         */
+        bool OpenReadWrite(CacheMode cacheMode);
+
+        /**
+         * This method returns the size of the blocks to which reads
+         * and writes must be aligned when the file is opened for
+         * direct I/O, which is the block size of the device holding
+         * the file.
+         *
+         * @return
+         *      The size of the blocks to which direct reads and
+         *      writes must be aligned is returned.
+         */
+        size_t GetBlockSize() const;
+
+        /**
+         * This method allocates a buffer suitable for direct reads
+         * and writes of the file, aligned to the block size and
+         * holding a whole number of blocks.
+         *
+         * @param[in] size
+         *      This is the least number of bytes the buffer should
+         *      hold.  It's rounded up to a multiple of the block size.
+         *
+         * @return
+         *      The newly allocated buffer is returned.
+         */
+        AlignedBuffer AllocateBuffer(size_t size) const;
+
+        /**
+         * This method returns a human-readable string describing
+         * the last error that occurred calling another
+         * method on the object.
+         *
+         * @return
+         *      A human-readable string describing the last error
+         *      that occured calling another method of the
+         *      object is returned.
+         */
+        std::string GetLastError() const;
+
+        /**
+         * This method maps a region of the open file into memory, so
+         * that it may be accessed without copying it through a buffer.
+         *
+         * @param[in] offset
+         *      This is the offset from the start of the file
+         *      to the first byte of the region to map.
+         *
+         * @param[in] length
+         *      This is the number of bytes in the region to map. If
+         *      zero, everything from the offset to the end of the
+         *      file is mapped.  A shared writable region extending
+         *      past the end of the file extends the file.
+         *
+         * @param[in] mode
+         *      This selects how the mapped region may be accessed.
+         *      The file must be open for writing to map a region
+         *      which may be written.
+         *
+         * @param[in] hugePages
+         *      This hints that the region is large and will be accessed
+         *      all over, so it's worth having the operating system back
+         *      it with larger pages, or at least bring it all into memory
+         *      up front, to take fewer faults when accessing it.
+         *
+         * @return
+         *      The mapped view of the region of the file is returned.
+         *
+         * @retval nullptr
+         *      This is returned if the region could not be mapped.
+         */
+        std::shared_ptr< MappedView > Map(
+            uint64_t offset,
+            size_t length,
+            MapMode mode,
+            bool hugePages = false
+        );
+
+        /**
+         * This method tells the operating system how the file, or a
+         * region of it, is going to be accessed, so that it can read
+         * ahead, or let go of cached data, accordingly.
+         *
+         * The Normal, Sequential, and Random hints apply to the whole
+         * file and to every later read and write, and must not be given
+         * while other threads are reading or writing the file.
+         * The WillNeed and DontNeed hints apply only to the given
+         * region, once, and DontNeed also applies to any mapped views
+         * of the region.
+         *
+         * @param[in] hint
+         *      This is the way in which the file is expected
+         *      to be accessed.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first byte
+         *      of the region to which the hint applies.
+         *
+         * @param[in] length
+         *      This is the number of bytes in the region to which the
+         *      hint applies.  If zero, the hint applies to everything
+         *      from the offset to the end of the file.
+         *
+         * @return
+         *      An indication of whether or not the hint
+         *      was taken is returned.
+         */
+        bool Advise(
+            AccessHint hint,
+            uint64_t offset = 0,
+            uint64_t length = 0
+        );
+
+        /**
+         * This method waits until everything written to the
+         * file so far is stored on the device.
+         *
+         * @return
+         *      An indication of whether or not everything written to
+         *      the file is known to be stored on the device is returned.
+         */
+        bool Sync();
+
+        /**
+         * This method reserves space on the device for the file to
+         * grow to the given size, without changing the size of the file,
+         * so that later writes extending the file don't need to
+         * allocate space as they go.
+         *
+         * @param[in] size
+         *      This is the size, in bytes, for which to reserve space.
+         *      Space already reserved is never given back by this method.
+         *
+         * @return
+         *      An indication of whether or not the space
+         *      was reserved is returned.
+         */
+        bool Preallocate(uint64_t size);
+
+        /**
+         * This method gathers everything known about the file or
+         * directory with a single query.  If the file is open, the
+         * query is made on the open handle, with no path lookup.
+         *
+         * @return
+         *      The metadata of the file or directory is returned.
+         */
+        Metadata GetMetadata() const;
+
+        /**
+         * This function gathers everything known about each of
+         * the given files or directories.
+         *
+         * @param[in] paths
+         *      These are the paths to the files or directories.
+         *
+         * @param[in] numThreads
+         *      This is the number of threads to use, so that
+         *      queries on slow devices can overlap.
+         *
+         * @return
+         *      The metadata of each file or directory is returned,
+         *      in the same order as the paths given.
+         */
+        static std::vector< Metadata > GetMetadata(
+            const std::vector< std::string >& paths,
+            size_t numThreads = 1
+        );
+
        /**
         * This fuction determines whether or not the given path
         * string indicates an absolute path in the fileSystme or not.
@@ -184,6 +660,52 @@ namespace SystemUtils {
         */
         static bool DeleteDirectory(const std::string& directory);
 
+        /**
+         * This method deletes a directory and all its contents, using
+         * several threads to delete different subdirectories at once.
+         * Links found in the directory are deleted themselves, never
+         * what they lead to.  Everything in the directory is found
+         * relative to the directory holding it, rather than by its
+         * full path, so the tree may be arbitrarily deep.
+         *
+         * @param[in] directory
+         *      This is the directory to delete.
+         *
+         * @param[in] numThreads
+         *      This is the largest number of threads to use.  No threads
+         *      are started unless the directory has subdirectories.
+         *
+         * @return
+         *      A flag indicating whether or not the method succeeded
+         *      is returned.
+         */
+        static bool DeleteDirectory(
+            const std::string& directory,
+            size_t numThreads
+        );
+
+        /**
+         * This method renames a directory aside, next to where it
+         * was, in one step, and then deletes it and all its contents
+         * in the background, so that the caller needn't wait, and the
+         * directory's path may be used again right away.
+         *
+         * @param[in] directory
+         *      This is the directory to delete.
+         *
+         * @return
+         *      A flag indicating whether or not the directory was
+         *      renamed aside is returned.  Whether or not deleting
+         *      it afterwards succeeds isn't reported.
+         */
+        static bool DeleteDirectoryInBackground(const std::string& directory);
+
+        /**
+         * This method waits until every directory handed to
+         * DeleteDirectoryInBackground so far has been deleted.
+         */
+        static void WaitForBackgroundDeletions();
+
         /**
          * This method copies a directory and all its contents.
          * 
@@ -200,6 +722,41 @@ namespace SystemUtils {
             const std::string& newDirectory
         );
 
+        /**
+         * This method copies a directory and all its contents, using
+         * several threads to discover and copy the files in it.
+         *
+         * Each directory is created before anything is copied into it,
+         * and is given the attributes and times of the directory
+         * copied once everything in it has been copied.
+         *
+         * @param[in] existingDirectory
+         *      This is the name of the directory to copy.
+         *
+         * @param[in] newDirectory
+         *      This is the distination path of the new directory.
+         *
+         * @param[in] progressDelegate
+         *      If not nullptr, this is called after each file is copied
+         *      or skipped.  It may be called from any of the threads
+         *      doing the copy, but never from two at once.
+         *
+         * @param[in] skipUnchanged
+         *      This indicates whether or not to skip copying files
+         *      which already exist at the destination with the same
+         *      size and last modified time.
+         *
+         * @return
+         *      Returns a flag that indicate whether or not the method
+         *      succeeded.
+         */
+        static bool CopyDirectory(
+            const std::string& existingDirectory,
+            const std::string& newDirectory,
+            CopyProgressDelegate progressDelegate,
+            bool skipUnchanged = true
+        );
+
         /**
          * This method returns a list of directories tha are considered the root
          * directories in the filesystem. For example, in Windows
@@ -248,6 +805,8 @@ namespace SystemUtils {
          * This is contains the private properties of the instance.
         */
         std::unique_ptr< Impl > impl_;
+
+        friend class AsyncFileEngine;
     };
 }
 
@@ -24,6 +24,38 @@ namespace SystemUtils {
 
     public:
         typedef std::vector< uint8_t > Buffer;
+
+        /**
+         * This is one of several pieces of memory into which
+         * consecutive bytes of the file are read at once.
+         */
+        struct ReadSegment {
+            /**
+             * This is where to put the bytes read into this piece.
+             */
+            void* buffer;
+
+            /**
+             * This is the number of bytes to read into this piece.
+             */
+            size_t numBytes;
+        };
+
+        /**
+         * This is one of several pieces of memory from which
+         * consecutive bytes of the file are written at once.
+         */
+        struct WriteSegment {
+            /**
+             * This is where to fetch the bytes of this piece.
+             */
+            const void* buffer;
+
+            /**
+             * This is the number of bytes in this piece.
+             */
+            size_t numBytes;
+        };
         
         //Methods
     public:
@@ -172,6 +204,101 @@ namespace SystemUtils {
         */
        virtual size_t Write(const void* buffer, size_t numBytes) = 0;
 
+       /**
+        * This method reads a region of the file starting at the given
+        * offset, without using or changing the current position in
+        * the file.  Any number of threads may call this at once to
+        * read different parts of the same file, as long as nothing
+        * else changes the file while they do.
+        *
+        * @param[in] offset
+        *       This is the offset from the start of the file
+        *       to the first byte to read.
+        * @param[out] buffer
+        *       This is where to put the bytes read from the file.
+        * @param[in] numBytes
+        *       This is the number of bytes to read from the file.
+        * @return
+        *       The number of bytes actually read is returned.
+        */
+       virtual size_t ReadAt(uint64_t offset, void* buffer, size_t numBytes) const = 0;
+
+       /**
+        * This method writes a region of the file starting at the given
+        * offset, without using or changing the current position in
+        * the file.  The file is extended if the region goes past
+        * its end.
+        *
+        * @param[in] offset
+        *       This is the offset from the start of the file
+        *       to the first byte to write.
+        * @param[in] buffer
+        *       This is where to fetch the bytes to write to the file.
+        * @param[in] numBytes
+        *       This is the number of bytes to write to the file.
+        * @return
+        *       The number of bytes actually written is returned.
+        */
+       virtual size_t WriteAt(uint64_t offset, const void* buffer, size_t numBytes) = 0;
+
+       /**
+        * This method reads consecutive bytes of the file into several
+        * pieces of memory, filling each piece in turn, as if the
+        * pieces were one buffer, and advances the current position
+        * in the file to be at the byte after the last byte read.
+        *
+        * @param[in] segments
+        *       These are the pieces of memory into which to read.
+        * @return
+        *       The total number of bytes actually read is returned.
+        */
+       virtual size_t ReadV(const std::vector< ReadSegment >& segments) = 0;
+
+       /**
+        * This method writes the bytes held in several pieces of memory
+        * to consecutive bytes of the file, as if the pieces were one
+        * buffer, and advances the current position in the file to be
+        * at the byte after the last byte written.
+        *
+        * @param[in] segments
+        *       These are the pieces of memory to write.
+        * @return
+        *       The total number of bytes actually written is returned.
+        */
+       virtual size_t WriteV(const std::vector< WriteSegment >& segments) = 0;
+
+       /**
+        * This method reads consecutive bytes of the file starting at
+        * the given offset into several pieces of memory, filling each
+        * piece in turn, without using or changing the current
+        * position in the file.
+        *
+        * @param[in] offset
+        *       This is the offset from the start of the file
+        *       to the first byte to read.
+        * @param[in] segments
+        *       These are the pieces of memory into which to read.
+        * @return
+        *       The total number of bytes actually read is returned.
+        */
+       virtual size_t ReadVAt(uint64_t offset, const std::vector< ReadSegment >& segments) const = 0;
+
+       /**
+        * This method writes the bytes held in several pieces of memory
+        * to consecutive bytes of the file starting at the given offset,
+        * without using or changing the current position in the file.
+        * The file is extended if the region goes past its end.
+        *
+        * @param[in] offset
+        *       This is the offset from the start of the file
+        *       to the first byte to write.
+        * @param[in] segments
+        *       These are the pieces of memory to write.
+        * @return
+        *       The total number of bytes actually written is returned.
+        */
+       virtual size_t WriteVAt(uint64_t offset, const std::vector< WriteSegment >& segments) = 0;
+
        /**
         * This method creates a new file object which operates on
         * the same file but has its own current file position.
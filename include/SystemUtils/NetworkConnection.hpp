@@ -25,6 +25,53 @@ namespace SystemUtils {
     */
     class NetworkConnection : public INetworkConnection
     {
+        // Types
+    public:
+        /**
+         * This configures how data sent over the network is
+         * spread out so as not to overflow switch buffers.
+         */
+        struct PacingPolicy {
+            /**
+             * This is the average number of bytes that may be sent each
+             * second. If zero, sending is not paced at all.
+             */
+            double bytesPerSecond = 0.0;
+
+            /**
+             * This is the largest number of bytes that may be sent
+             * at once, after sending has been idle for a while.
+             */
+            double burstBytes = 65536.0;
+        };
+
+        /**
+         * This holds statistics about the pacing of sent data.
+         */
+        struct PacingStatistics {
+            /**
+             * This is the number of bytes sent while pacing was configured.
+             */
+            uint64_t bytesSent = 0;
+
+            /**
+             * This is the number of times sending was held back.
+             */
+            uint64_t throttles = 0;
+
+            /**
+             * This is the total time, in seconds, that sending was held back.
+             */
+            double throttledTime = 0.0;
+
+            /**
+             * This indicates whether or not pacing is being done by the
+             * operating system rather than by the object itself,
+             * in which case sending is never seen to be held back.
+             */
+            bool offloaded = false;
+        };
+
         //Rules of five Life cycle managment
     public:
         ~NetworkConnection() noexcept;
@@ -52,6 +99,27 @@ namespace SystemUtils {
         */
         static uint32_t GetAddressOfHost(const std::string& host);
 
+        /**
+         * This method configures the pacing of data sent over the
+         * connection. The operating system is asked to do the pacing
+         * where it supports it; otherwise the processor thread holds
+         * back sending to keep within the policy.
+         *
+         * @param[in] policy
+         *      This is the pacing policy to apply.
+         */
+        void SetPacing(const PacingPolicy& policy);
+
+        /**
+         * This method returns statistics about
+         * the pacing of data sent over the connection.
+         *
+         * @return
+         *      Statistics about the pacing of data sent
+         *      over the connection are returned.
+         */
+        PacingStatistics GetPacingStatistics() const;
+
         //INetworkConnection interface
     public:
         virtual DiagnosticsSender::UnsubscribeDelegate SubscribeToDiagnostics(
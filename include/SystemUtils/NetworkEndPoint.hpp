@@ -10,13 +10,18 @@
 */
 
 #include <stddef.h>
+#include <stdint.h>
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "NetworkConnection.hpp"
 #include "DiagnosticsSender.hpp"
 
 
 namespace SystemUtils {
+
+    class NetworkEndPointGroup;
     
     /**
      * This class listens for incoming connections from remote objects,
@@ -46,6 +51,216 @@ namespace SystemUtils {
         */
         typedef std::function< void(uint32_t address, uint16_t port, const std::vector< uint8_t >& body) > PacketReceivedDelegate;
 
+        /**
+         * This is the type used to hand the endpoint a datagram body
+         * which may be shared with other owners, such as the same
+         * telemetry record sent to several recipients, without
+         * copying it.
+         */
+        typedef std::shared_ptr< const std::vector< uint8_t > > SharedBuffer;
+
+        /**
+         * This is the type of callback function to be called whenever
+         * a new datagram-oriented message is received by the network
+         * endpoint, when the receiver wants to keep the message
+         * without copying it.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the client who sent the message.
+         *
+         * @param[in] port
+         *      This is the port number of the client who sent the message.
+         *
+         * @param[in] body
+         *      This is the contents of the datagram sent by the client.
+         *      The buffer holding it is returned to the endpoint for reuse
+         *      once the last reference to it is released.
+         */
+        typedef std::function< void(uint32_t address, uint16_t port, SharedBuffer body) > SharedPacketReceivedDelegate;
+
+        /**
+         * This is the type of callback function to be called whenever
+         * a new datagram-oriented message is received by the network
+         * endpoint, when the receiver wants to know when the message
+         * actually arrived at the local host.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the client who sent the message.
+         *
+         * @param[in] port
+         *      This is the port number of the client who sent the message.
+         *
+         * @param[in] body
+         *      This is the contents of the datagram sent by the client.
+         *
+         * @param[in] receiveTime
+         *      This is the time, in seconds, on the same clock as
+         *      SystemUtils::Time::GetTime, when the datagram was received
+         *      by the operating system. If the operating system can't
+         *      report this, it's the time the endpoint first saw it.
+         */
+        typedef std::function< void(uint32_t address, uint16_t port, SharedBuffer body, double receiveTime) > TimestampedPacketReceivedDelegate;
+
+        /**
+         * This is the type of callback function to be called whenever
+         * a datagram is received from a peer with which the endpoint
+         * has no session, when sessions are enabled.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer.
+         *
+         * @param[in] port
+         *      This is the port number of the peer.
+         *
+         * @return
+         *      The function to call with each datagram received from the
+         *      peer, starting with this one, is returned.  If nullptr is
+         *      returned, no session is started and the datagram is handed
+         *      to the endpoint's own packet received delegate.
+         */
+        typedef std::function< SharedPacketReceivedDelegate(uint32_t address, uint16_t port) > NewSessionDelegate;
+
+        /**
+         * This is the type of callback function to be called whenever
+         * a session with a peer is ended for having been idle.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer.
+         *
+         * @param[in] port
+         *      This is the port number of the peer.
+         */
+        typedef std::function< void(uint32_t address, uint16_t port) > SessionClosedDelegate;
+
+        /**
+         * These are the things the endpoint may do when a datagram
+         * is sent while its send queue is full.
+         */
+        enum class SendQueueOverflowPolicy {
+            /**
+             * The datagram being sent is discarded.
+             */
+            DropNewest,
+
+            /**
+             * The oldest datagram waiting in the queue is discarded
+             * to make room for the one being sent.
+             */
+            DropOldest,
+        };
+
+        /**
+         * This holds the limits placed on which incoming connections
+         * a connection-oriented endpoint accepts. A limit of zero
+         * means no limit. Connections over a limit are refused
+         * before any NetworkConnection object is made for them.
+         */
+        struct AdmissionPolicy {
+            /**
+             * This is the maximum number of connections accepted by
+             * the endpoint which may be open at the same time.
+             */
+            size_t maxConnections = 0;
+
+            /**
+             * This is the maximum number of connections accepted by
+             * the endpoint from any single IPv4 address which may
+             * be open at the same time.
+             */
+            size_t maxConnectionsPerAddress = 0;
+
+            /**
+             * This is the maximum sustained number of connections
+             * accepted per second.
+             */
+            double acceptRate = 0.0;
+
+            /**
+             * This is the number of connections which may be accepted
+             * in a burst, above the sustained accept rate.
+             */
+            size_t acceptBurst = 1;
+        };
+
+        /**
+         * This holds the counts of incoming connections the endpoint
+         * has admitted or refused, and why.
+         */
+        struct AdmissionStatistics {
+            /**
+             * This is the number of connections admitted.
+             */
+            uint64_t admitted = 0;
+
+            /**
+             * This is the number of connections refused because the
+             * endpoint already had the maximum number open.
+             */
+            uint64_t rejectedTooManyConnections = 0;
+
+            /**
+             * This is the number of connections refused because the
+             * endpoint already had the maximum number open from the
+             * same address.
+             */
+            uint64_t rejectedTooManyFromAddress = 0;
+
+            /**
+             * This is the number of connections refused because they
+             * came faster than the accept rate allows.
+             */
+            uint64_t rejectedRateLimited = 0;
+
+            /**
+             * This is the number of admitted connections
+             * which are still open.
+             */
+            size_t connectionsOpen = 0;
+        };
+
+        /**
+         * This holds the counts of how the endpoint's worker thread
+         * spent its time waiting for work, so that the processor time
+         * traded for latency in busy poll mode can be judged.
+         */
+        struct BusyPollStatistics {
+            /**
+             * This is the number of times the worker thread found
+             * more work while polling, without having to block.
+             */
+            uint64_t spinWakeups = 0;
+
+            /**
+             * This is the number of times the worker thread
+             * blocked while waiting for work.
+             */
+            uint64_t sleeps = 0;
+
+            /**
+             * This is the total time, in seconds, the worker
+             * thread spent polling for work.
+             */
+            double spinTime = 0.0;
+
+            /**
+             * This is the total time, in seconds, the worker
+             * thread spent blocked while waiting for work.
+             */
+            double sleepTime = 0.0;
+        };
+
+        /**
+         * This configures how datagrams sent by the endpoint are spread
+         * out, so that bursts don't overflow switch buffers.
+         */
+        typedef NetworkConnection::PacingPolicy PacingPolicy;
+
+        /**
+         * This holds statistics about the pacing of datagrams
+         * sent by the endpoint.
+         */
+        typedef NetworkConnection::PacingStatistics PacingStatistics;
+
         /**
         * These are the different sts of behavior that can be 
         * configured for a network endpoint.
@@ -161,6 +376,328 @@ namespace SystemUtils {
             uint16_t port
         );
 
+        /**
+         * This is the same as the other Open method, except that received
+         * datagrams are handed to the given delegate by reference-counted
+         * handle, so the receiver may keep them without copying.
+         *
+         * @param[in] newConnectionDelegate
+         *       This is the callback function to be called whenever
+         *       a new client connects to the network endpoint.
+         *
+         * @param[in] packetReceivedDelegate
+         *       This is the callback function to be called whenever
+         *       a new datagram-oriented message is received by the
+         *       network endpoint.
+         *
+         * @param[in] mode
+         *        This selects the kind of processing to perform with
+         *        the endpoint.
+         *
+         * @param[in] localAddress
+         *        This is the address to use on the network for the endpoint.
+         *
+         * @param[in] groupAddress
+         *        This is the address to select for multicasting, if a multicast
+         *        mode is selected.
+         *
+         * @param[in] port
+         *        This is the port number to use on the network.
+         *
+         * @return
+         *        An indication of whether or not the method was successful is returned.
+         */
+        bool Open(
+            NetworkConnectionDelegate newConnectionDelegate,
+            SharedPacketReceivedDelegate packetReceivedDelegate,
+            Mode mode,
+            uint32_t localAddress,
+            uint32_t groupAddress,
+            uint16_t port
+        );
+
+        /**
+         * This is the same as the other Open method, except that received
+         * datagrams are handed to the given delegate along with the time
+         * they were received by the operating system.
+         *
+         * @param[in] newConnectionDelegate
+         *       This is the callback function to be called whenever
+         *       a new client connects to the network endpoint.
+         *
+         * @param[in] packetReceivedDelegate
+         *       This is the callback function to be called whenever
+         *       a new datagram-oriented message is received by the
+         *       network endpoint.
+         *
+         * @param[in] mode
+         *        This selects the kind of processing to perform with
+         *        the endpoint.
+         *
+         * @param[in] localAddress
+         *        This is the address to use on the network for the endpoint.
+         *
+         * @param[in] groupAddress
+         *        This is the address to select for multicasting, if a multicast
+         *        mode is selected.
+         *
+         * @param[in] port
+         *        This is the port number to use on the network.
+         *
+         * @return
+         *        An indication of whether or not the method was successful is returned.
+         */
+        bool Open(
+            NetworkConnectionDelegate newConnectionDelegate,
+            TimestampedPacketReceivedDelegate packetReceivedDelegate,
+            Mode mode,
+            uint32_t localAddress,
+            uint32_t groupAddress,
+            uint16_t port
+        );
+
+        /**
+         * This method gives the open endpoint's socket to another
+         * process on the local host, so that it can keep serving the
+         * bound port without any connection or datagram being refused
+         * while it takes over, for example during an upgrade.
+         *
+         * The other process must call OpenFromExisting before the timeout.
+         * Once the other process has started processing, this endpoint
+         * is closed. Connections already made aren't handed off.
+         *
+         * @param[in] processId
+         *      This is the identifier of the process taking the socket.
+         *
+         * @param[in] timeout
+         *      This is the longest time, in seconds, to wait
+         *      for the other process to take the socket.
+         *
+         * @return
+         *      An indication of whether or not the other process took
+         *      the socket is returned. If it didn't, this endpoint
+         *      is left open.
+         */
+        bool HandOff(
+            unsigned int processId,
+            double timeout
+        );
+
+        /**
+         * This method opens the endpoint with the socket handed off to
+         * this process by another process's HandOff method. The mode,
+         * addresses and port of the endpoint are those of the other
+         * process's endpoint.
+         *
+         * @param[in] newConnectionDelegate
+         *       This is the function to call whenever a new connection
+         *       is established for the endpoint.
+         *
+         * @param[in] packetReceivedDelegate
+         *       This is the function to call whenever a new datagram
+         *       is received by the endpoint.
+         *
+         * @param[in] timeout
+         *      This is the longest time, in seconds, to wait
+         *      for the other process to hand off its socket.
+         *
+         * @return
+         *      An indication of whether or not the method was successful is returned.
+         */
+        bool OpenFromExisting(
+            NetworkConnectionDelegate newConnectionDelegate,
+            PacketReceivedDelegate packetReceivedDelegate,
+            double timeout
+        );
+
+        /**
+         * This method returns a histogram of the delays between
+         * datagrams being received by the operating system and
+         * being handed to the timestamped packet received delegate.
+         *
+         * Bucket 0 counts delays shorter than one microsecond, and each
+         * bucket i after that counts delays of at least 2^(i-1) microseconds
+         * but shorter than 2^i microseconds. The last bucket also counts
+         * all delays longer than that.
+         *
+         * @return
+         *      The counts of delays in each bucket are returned.
+         */
+        std::vector< uint64_t > GetReceiveLatencyHistogram() const;
+
+        /**
+         * This method selects whether or not the endpoint accepts
+         * datagrams larger than the path MTU of the local host.
+         * By default it does not, so that each receive buffer
+         * is only as large as a packet can actually be on the network.
+         * Larger datagrams are then discarded and counted as truncated.
+         *
+         * @note
+         *      This takes effect the next time the endpoint is opened.
+         *
+         * @param[in] enable
+         *      This indicates whether or not the endpoint should
+         *      accept datagrams of any size.
+         */
+        void EnableLargeDatagrams(bool enable);
+
+        /**
+         * This method returns the number of datagrams which were
+         * discarded because they were larger than the receive buffer.
+         *
+         * @return
+         *      The number of datagrams which were discarded because
+         *      they were larger than the receive buffer is returned.
+         */
+        uint64_t GetReceivePacketsTruncated() const;
+
+        /**
+         * This method has the endpoint's network processing done by
+         * the worker thread of the given group, rather than by a thread
+         * of its own, from the next time the endpoint is opened.
+         *
+         * @note
+         *      Busy poll mode and processor pinning don't apply
+         *      to endpoints in a group.
+         *
+         * @param[in] group
+         *      This is the group which is to do the endpoint's
+         *      network processing.
+         */
+        void JoinGroup(const NetworkEndPointGroup& group);
+
+        /**
+         * This method has the endpoint do its own network processing
+         * again, from the next time the endpoint is opened.
+         */
+        void LeaveGroup();
+
+        /**
+         * This method configures busy poll mode, in which the endpoint's
+         * worker thread keeps polling its socket for a while after
+         * going idle, rather than blocking right away, trading processor
+         * time for a lower latency in handling network traffic.
+         *
+         * @note
+         *      This takes effect the next time the endpoint is opened.
+         *
+         * @param[in] spinBudget
+         *      This is the longest time, in seconds, the worker thread
+         *      keeps polling after going idle, before blocking.
+         *      If zero, busy poll mode is disabled.
+         *
+         * @param[in] processorCore
+         *      This is the index of the processor core to which the worker
+         *      thread should be pinned, or -1 if it may run on any core.
+         *      Cores are numbered across all processor groups.  If there's
+         *      no core with the given index, the thread isn't pinned.
+         */
+        void SetBusyPoll(
+            double spinBudget,
+            int processorCore = -1
+        );
+
+        /**
+         * This method returns the counts of how the endpoint's worker
+         * thread spent its time waiting for work.
+         *
+         * @return
+         *      The counts of how the endpoint's worker thread
+         *      spent its time waiting for work are returned.
+         */
+        BusyPollStatistics GetBusyPollStatistics() const;
+
+        /**
+         * This method sets the limits placed on which incoming
+         * connections the endpoint accepts.
+         *
+         * @note
+         *      Refusal happens before the connection handshake completes
+         *      only if a limit is set when the endpoint is opened.
+         *
+         * @param[in] policy
+         *      This holds the limits to place on incoming connections.
+         */
+        void SetAdmissionPolicy(const AdmissionPolicy& policy);
+
+        /**
+         * This method returns the counts of incoming connections the
+         * endpoint has admitted or refused, and why.
+         *
+         * @return
+         *      The counts of incoming connections the endpoint has
+         *      admitted or refused, and why, are returned.
+         */
+        AdmissionStatistics GetAdmissionStatistics() const;
+
+        /**
+         * This method has the endpoint keep a session for each peer
+         * (address and port) exchanging datagrams with it. Datagrams
+         * from a peer are handed to that peer's own delegate, and
+         * datagrams sent to a peer are queued separately for each
+         * session, so that one busy peer can't hold up the others.
+         * A session ends once no datagram has been sent to or
+         * received from its peer for the given time.
+         *
+         * @note
+         *      This must be called before the endpoint is opened.
+         *      Sessions are discarded, without calling the session
+         *      closed delegate, when the endpoint is closed.
+         *
+         * @param[in] newSessionDelegate
+         *      This is the function to call when a datagram is received
+         *      from a peer with which there's no session, to start one.
+         *      If nullptr, sessions are disabled.
+         *
+         * @param[in] sessionClosedDelegate
+         *      This is the function to call when a session
+         *      ends for having been idle.
+         *
+         * @param[in] idleTimeout
+         *      This is the time, in seconds, a session may be idle.
+         */
+        void EnableSessions(
+            NewSessionDelegate newSessionDelegate,
+            SessionClosedDelegate sessionClosedDelegate,
+            double idleTimeout
+        );
+
+        /**
+         * This method returns the number of sessions the endpoint
+         * currently has with peers.
+         *
+         * @return
+         *      The number of sessions the endpoint currently
+         *      has with peers is returned.
+         */
+        size_t GetSessionCount() const;
+
+        /**
+         * This method configures the pacing of datagrams sent by the
+         * endpoint. The worker thread holds back each datagram until
+         * sending it keeps within the policy. A datagram larger than
+         * the burst size is sent once a full burst is allowed.
+         *
+         * @note
+         *      Pacing is never offloaded to the operating system
+         *      for endpoints, since their datagrams may go to
+         *      many different destinations.
+         *
+         * @param[in] policy
+         *      This is the pacing policy to apply.
+         */
+        void SetPacing(const PacingPolicy& policy);
+
+        /**
+         * This method returns statistics about the pacing
+         * of datagrams sent by the endpoint.
+         *
+         * @return
+         *      Statistics about the pacing of datagrams
+         *      sent by the endpoint are returned.
+         */
+        PacingStatistics GetPacingStatistics() const;
+
         /**
          * This method returns the network port that the endpoint
          * has bound for its use
@@ -191,6 +728,78 @@ namespace SystemUtils {
             const std::vector< uint8_t >& body
         );
 
+        /**
+         * This is the same as the other SendPacket method, except that
+         * the given body is moved into the send queue rather than copied.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the receipients of the message.
+         *
+         * @param[in] port
+         *      This is the port of the receipient of the message.
+         *
+         * @param[in] body
+         *      This is the desired payload of the message.
+         */
+        void SendPacket(
+            uint32_t address,
+            uint16_t port,
+            std::vector< uint8_t >&& body
+        );
+
+        /**
+         * This is the same as the other SendPacket method, except that
+         * the endpoint only holds a reference to the given body until
+         * it has been sent, rather than copying it.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the receipients of the message.
+         *
+         * @param[in] port
+         *      This is the port of the receipient of the message.
+         *
+         * @param[in] body
+         *      This is the desired payload of the message.
+         *      It must not be modified until it has been sent.
+         */
+        void SendPacket(
+            uint32_t address,
+            uint16_t port,
+            SharedBuffer body
+        );
+
+        /**
+         * This method configures the queue which holds datagrams
+         * waiting to be sent by the endpoint. Any datagrams already
+         * queued are discarded.
+         *
+         * @note
+         *      This must not be called while the endpoint is open,
+         *      or while other threads may be sending datagrams.
+         *
+         * @param[in] capacity
+         *      This is the maximum number of datagrams the queue
+         *      may hold. It is rounded up to the next power of two.
+         *
+         * @param[in] overflowPolicy
+         *      This selects what to do when a datagram is sent
+         *      while the queue is full.
+         */
+        void SetSendQueueLimit(
+            size_t capacity,
+            SendQueueOverflowPolicy overflowPolicy
+        );
+
+        /**
+         * This method returns the number of datagrams which were
+         * discarded because the send queue was full.
+         *
+         * @return
+         *      The number of datagrams which were discarded because
+         *      the send queue was full is returned.
+         */
+        uint64_t GetSendPacketsDropped() const;
+
         /**
          * This method is the opposite of the Open method. It stops
          * any and all network activity associated with the endpoint,
@@ -230,6 +839,7 @@ namespace SystemUtils {
          */
         std::unique_ptr< Impl > impl_;
 
+        friend class NetworkEndPointGroup;
     };    
     
 }
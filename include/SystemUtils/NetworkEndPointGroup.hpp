@@ -0,0 +1,79 @@
+#ifndef SYSTEM_UTILS_NETWORK_END_POINT_GROUP_HPP
+#define SYSTEM_UTILS_NETWORK_END_POINT_GROUP_HPP
+
+/**
+ * @file NetworkEndPointGroup.hpp
+ *
+ * This module declares the SystemUtils::NetworkEndPointGroup class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <memory>
+#include <stddef.h>
+
+namespace SystemUtils {
+
+    /**
+     * This class runs a single worker thread which does the network
+     * processing for any number of network endpoints, rather than each
+     * endpoint having its own worker thread.
+     *
+     * Endpoints join a group with NetworkEndPoint::JoinGroup before
+     * they're opened. Each keeps its own delegates, and may be opened
+     * and closed at any time while the group exists.
+     *
+     * @note
+     *      Since all members share one thread, a delegate which takes
+     *      a long time holds up traffic for every endpoint in the group.
+     */
+    class NetworkEndPointGroup {
+        // Lifecycle management
+    public:
+        ~NetworkEndPointGroup() noexcept;
+        NetworkEndPointGroup(const NetworkEndPointGroup&) = delete;
+        NetworkEndPointGroup(NetworkEndPointGroup&&) noexcept;
+        NetworkEndPointGroup& operator=(const NetworkEndPointGroup&) = delete;
+        NetworkEndPointGroup& operator=(NetworkEndPointGroup&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor. It starts the
+         * worker thread of the group.
+         */
+        NetworkEndPointGroup();
+
+        /**
+         * This method returns the number of endpoints currently
+         * open whose network processing is done by the group.
+         *
+         * @return
+         *      The number of endpoints currently open whose network
+         *      processing is done by the group is returned.
+         */
+        size_t GetMemberCount() const;
+
+    public:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the
+         * platform-specific part of the implementation and declared
+         * here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        // Private properties
+    private:
+        /**
+         * This contains the private properties of the instance.
+         * It's shared with the endpoints which have joined the group.
+         */
+        std::shared_ptr< Impl > impl_;
+
+        friend class NetworkEndPoint;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_NETWORK_END_POINT_GROUP_HPP */
@@ -0,0 +1,162 @@
+#ifndef SYSTEM_UTILS_RESOURCE_BUNDLE_HPP
+#define SYSTEM_UTILS_RESOURCE_BUNDLE_HPP
+
+/**
+ * @file ResourceBundle.hpp
+ *
+ * This module declares the SystemUtils::ResourceBundle class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "IFile.hpp"
+
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class serves application resources out of a single bundle
+     * file, so that many small resources can be loaded with one open
+     * and one mapping, rather than one open and read per resource.
+     *
+     * The bundle is laid out as follows, with all numbers little-endian:
+     *
+     * - a 16-byte header: the magic bytes "SURB", then the format
+     *   version, the number of resources, and a reserved word,
+     *   each 32 bits.
+     * - the directory: one 24-byte entry per resource, sorted by name,
+     *   holding the 64-bit offset and size of the resource's contents,
+     *   followed by the 32-bit offset and length of its name.
+     * - the names of the resources.
+     * - the contents of the resources, each aligned to 8 bytes.
+     *
+     * Bundles are made with the Pack function, usually at build time
+     * by the ResourcePacker tool.
+     */
+    class ResourceBundle {
+        // Constants
+    public:
+        /**
+         * This is the version of the bundle format
+         * written and understood by this class.
+         */
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        // Lifecycle management
+    public:
+        ~ResourceBundle() noexcept;
+        ResourceBundle(const ResourceBundle&) = delete;
+        ResourceBundle(ResourceBundle&&) noexcept;
+        ResourceBundle& operator=(const ResourceBundle&) = delete;
+        ResourceBundle& operator=(ResourceBundle&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         */
+        ResourceBundle();
+
+        /**
+         * This method opens the bundle with the given path,
+         * mapping it into memory.
+         *
+         * @param[in] path
+         *      This is the path to the bundle file.
+         *
+         * @return
+         *      An indication of whether or not the bundle was
+         *      opened is returned.  It's false if the file
+         *      couldn't be mapped or isn't a valid bundle.
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * This method closes the bundle.  Resources already handed
+         * out stay readable until they're released.
+         */
+        void Close();
+
+        /**
+         * This method determines whether or not the
+         * bundle holds a resource with the given name.
+         *
+         * @param[in] name
+         *      This is the name of the resource to find.
+         *
+         * @return
+         *      An indication of whether or not the bundle holds
+         *      a resource with the given name is returned.
+         */
+        bool HasResource(const std::string& name) const;
+
+        /**
+         * This method returns a read-only file through which the
+         * contents of the resource with the given name may be read,
+         * straight out of the mapped bundle without copying.
+         *
+         * @param[in] name
+         *      This is the name of the resource to return.
+         *
+         * @return
+         *      The resource is returned.
+         *
+         * @retval nullptr
+         *      This is returned if the bundle isn't open, or
+         *      holds no resource with the given name.
+         */
+        std::shared_ptr< IFile > GetResource(const std::string& name) const;
+
+        /**
+         * This method returns the names of all the
+         * resources held in the bundle.
+         *
+         * @return
+         *      The names of all the resources held in the
+         *      bundle are returned, in sorted order.
+         */
+        std::vector< std::string > GetResourceNames() const;
+
+        /**
+         * This function makes a bundle out of the given files.
+         *
+         * @param[in] resources
+         *      This maps the name of each resource to put in the bundle
+         *      to the path of the file holding its contents.
+         *
+         * @param[in] bundlePath
+         *      This is the path of the bundle file to make.
+         *      Any existing file with this path is replaced.
+         *
+         * @return
+         *      An indication of whether or not the bundle
+         *      was made is returned.
+         */
+        static bool Pack(
+            const std::map< std::string, std::string >& resources,
+            const std::string& bundlePath
+        );
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_RESOURCE_BUNDLE_HPP */
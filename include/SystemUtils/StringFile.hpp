@@ -91,6 +91,12 @@ namespace SystemUtils {
         virtual size_t Read(void* buffer, size_t numBytes) override;
         virtual size_t Write(const Buffer& buffer, size_t numBytes = 0, size_t offset = 0) override;
         virtual size_t Write(const void* buffer, size_t numBytes) override;
+        virtual size_t ReadAt(uint64_t offset, void* buffer, size_t numBytes) const override;
+        virtual size_t WriteAt(uint64_t offset, const void* buffer, size_t numBytes) override;
+        virtual size_t ReadV(const std::vector< ReadSegment >& segments) override;
+        virtual size_t WriteV(const std::vector< WriteSegment >& segments) override;
+        virtual size_t ReadVAt(uint64_t offset, const std::vector< ReadSegment >& segments) const override;
+        virtual size_t WriteVAt(uint64_t offset, const std::vector< WriteSegment >& segments) override;
         virtual std::shared_ptr< IFile > Clone() override;
 
         // Private properties
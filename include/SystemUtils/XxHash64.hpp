@@ -0,0 +1,191 @@
+#ifndef SYSTEM_UTILS_XX_HASH_64_HPP
+#define SYSTEM_UTILS_XX_HASH_64_HPP
+
+/**
+ * @file XxHash64.hpp
+ *
+ * This module declares the SystemUtils::XxHash64 class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "IFile.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class calculates the 64-bit xxHash of data given
+     * to it a piece at a time.  This is a fast non-cryptographic
+     * hash, suitable for detecting accidental changes to data, but
+     * not for guarding against deliberate ones.
+     */
+    class XxHash64 {
+        // Constants
+    public:
+        /**
+         * This is the number of bytes of a file hashed by
+         * each thread at a time when hashing in parallel.
+         */
+        static constexpr uint64_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+        // Lifecycle management
+    public:
+        ~XxHash64() noexcept;
+        XxHash64(const XxHash64&) = delete;
+        XxHash64(XxHash64&&) noexcept;
+        XxHash64& operator=(const XxHash64&) = delete;
+        XxHash64& operator=(XxHash64&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] seed
+         *      This is the value with which to start the hash.
+         */
+        explicit XxHash64(uint64_t seed = 0);
+
+        /**
+         * This method starts the hash over, as if
+         * no data had been given yet.
+         *
+         * @param[in] seed
+         *      This is the value with which to start the hash.
+         */
+        void Reset(uint64_t seed = 0);
+
+        /**
+         * This method adds the given data to the hash.
+         *
+         * @param[in] data
+         *      This is where to fetch the data to add.
+         *
+         * @param[in] size
+         *      This is the number of bytes to add.
+         */
+        void Update(const void* data, size_t size);
+
+        /**
+         * This method adds the given region of a file to the hash.
+         *
+         * @param[in] file
+         *      This is the file from which to read the data to add.
+         *      Its current position isn't used or changed.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first byte to add.
+         *
+         * @param[in] length
+         *      This is the number of bytes to add.  If zero, everything
+         *      from the offset to the end of the file is added.
+         *
+         * @return
+         *      An indication of whether or not the whole
+         *      region could be read is returned.
+         */
+        bool Update(
+            const IFile& file,
+            uint64_t offset = 0,
+            uint64_t length = 0
+        );
+
+        /**
+         * This method returns the hash of all the data given so far.
+         *
+         * @return
+         *      The hash of all the data given so far is returned.
+         */
+        uint64_t GetValue() const;
+
+        /**
+         * This function calculates the hash of the given data.
+         *
+         * @param[in] data
+         *      This is where to fetch the data to hash.
+         *
+         * @param[in] size
+         *      This is the number of bytes to hash.
+         *
+         * @param[in] seed
+         *      This is the value with which to start the hash.
+         *
+         * @return
+         *      The hash of the given data is returned.
+         */
+        static uint64_t Compute(
+            const void* data,
+            size_t size,
+            uint64_t seed = 0
+        );
+
+        /**
+         * This function splits the given region of a file into chunks
+         * and hashes each chunk on its own, in separate threads.
+         *
+         * Unlike a checksum, the hashes of chunks can't be combined
+         * into the hash of the whole, so the list of chunk hashes
+         * is what should be stored and compared to verify the file.
+         *
+         * @param[in] file
+         *      This is the file from which to read the data to
+         *      hash.  Its current position isn't used or changed.
+         *
+         * @param[out] hashes
+         *      This is where to store the hash of each chunk,
+         *      in the order of the chunks in the file.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first byte to hash.
+         *
+         * @param[in] length
+         *      This is the number of bytes to hash.  If zero,
+         *      everything from the offset to the end of the
+         *      file is hashed.
+         *
+         * @param[in] numThreads
+         *      This is the number of threads to use.
+         *
+         * @param[in] chunkSize
+         *      This is the number of bytes in each chunk.
+         *
+         * @param[in] seed
+         *      This is the value with which to start each hash.
+         *
+         * @return
+         *      An indication of whether or not the whole
+         *      region could be read is returned.
+         */
+        static bool ComputeChunks(
+            const IFile& file,
+            std::vector< uint64_t >& hashes,
+            uint64_t offset = 0,
+            uint64_t length = 0,
+            size_t numThreads = 1,
+            uint64_t chunkSize = DEFAULT_CHUNK_SIZE,
+            uint64_t seed = 0
+        );
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_XX_HASH_64_HPP */
@@ -0,0 +1,147 @@
+/**
+ * @file AdmissionController.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::AdmissionController class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "AdmissionController.hpp"
+#include "TokenBucket.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+namespace SystemUtils {
+
+    /**
+     * This holds the private properties of the AdmissionController class.
+     */
+    struct AdmissionController::Impl {
+        // Properties
+
+        /**
+         * This is used to synchronize access to the controller.
+         */
+        mutable std::mutex mutex;
+
+        /**
+         * This holds the limits placed on incoming connections.
+         */
+        NetworkEndPoint::AdmissionPolicy policy;
+
+        /**
+         * This limits the rate at which connections are admitted.
+         */
+        TokenBucket acceptRateLimiter;
+
+        /**
+         * These are the counts of connections admitted or refused.
+         */
+        NetworkEndPoint::AdmissionStatistics statistics;
+
+        /**
+         * This holds the number of admitted connections still open
+         * from each address which has any.
+         */
+        std::map< uint32_t, size_t > connectionsPerAddress;
+
+        // Methods
+
+        /**
+         * This method is called when the ticket of an admitted
+         * connection is released.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer of the connection.
+         */
+        void Release(uint32_t address) {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            --statistics.connectionsOpen;
+            const auto connections = connectionsPerAddress.find(address);
+            if (connections != connectionsPerAddress.end()) {
+                if (--connections->second == 0) {
+                    (void)connectionsPerAddress.erase(connections);
+                }
+            }
+        }
+    };
+
+    AdmissionController::~AdmissionController() noexcept = default;
+    AdmissionController::AdmissionController(AdmissionController&&) noexcept = default;
+    AdmissionController& AdmissionController::operator=(AdmissionController&&) noexcept = default;
+
+    AdmissionController::AdmissionController()
+        : impl_(std::make_shared< Impl >())
+    {
+    }
+
+    void AdmissionController::SetPolicy(const NetworkEndPoint::AdmissionPolicy& policy) {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->policy = policy;
+        impl_->acceptRateLimiter = TokenBucket(
+            policy.acceptRate,
+            (double)std::max(policy.acceptBurst, (size_t)1)
+        );
+    }
+
+    bool AdmissionController::IsLimited() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return (
+            (impl_->policy.maxConnections > 0)
+            || (impl_->policy.maxConnectionsPerAddress > 0)
+            || impl_->acceptRateLimiter.IsLimited()
+        );
+    }
+
+    auto AdmissionController::Admit(
+        uint32_t address,
+        double now,
+        Ticket& ticket
+    ) -> Verdict {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        if (
+            (impl_->policy.maxConnections > 0)
+            && (impl_->statistics.connectionsOpen >= impl_->policy.maxConnections)
+        ) {
+            ++impl_->statistics.rejectedTooManyConnections;
+            return Verdict::TooManyConnections;
+        }
+        if (impl_->policy.maxConnectionsPerAddress > 0) {
+            const auto connections = impl_->connectionsPerAddress.find(address);
+            if (
+                (connections != impl_->connectionsPerAddress.end())
+                && (connections->second >= impl_->policy.maxConnectionsPerAddress)
+            ) {
+                ++impl_->statistics.rejectedTooManyFromAddress;
+                return Verdict::TooManyFromAddress;
+            }
+        }
+        if (!impl_->acceptRateLimiter.TryTake(now)) {
+            ++impl_->statistics.rejectedRateLimited;
+            return Verdict::RateLimited;
+        }
+        ++impl_->statistics.admitted;
+        ++impl_->statistics.connectionsOpen;
+        ++impl_->connectionsPerAddress[address];
+        std::weak_ptr< Impl > weakController(impl_);
+        ticket = Ticket(
+            nullptr,
+            [weakController, address](void*){
+                const auto controller = weakController.lock();
+                if (controller != nullptr) {
+                    controller->Release(address);
+                }
+            }
+        );
+        return Verdict::Admitted;
+    }
+
+    NetworkEndPoint::AdmissionStatistics AdmissionController::GetStatistics() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->statistics;
+    }
+
+}
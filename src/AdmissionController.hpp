@@ -0,0 +1,150 @@
+#ifndef SYSTEM_UTILS_ADMISSION_CONTROLLER_HPP
+#define SYSTEM_UTILS_ADMISSION_CONTROLLER_HPP
+
+/**
+ * @file AdmissionController.hpp
+ *
+ * This module declares the SystemUtils::AdmissionController class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <memory>
+#include <stdint.h>
+#include <SystemUtils/NetworkEndPoint.hpp>
+
+namespace SystemUtils {
+
+    /**
+     * This class decides which incoming connections a network endpoint
+     * admits, according to its admission policy, and keeps count of
+     * the connections admitted and refused.
+     *
+     * Each admitted connection is represented by a ticket, which is
+     * held for as long as the connection is open. Tickets may be
+     * released from any thread, and may outlive the controller itself.
+     */
+    class AdmissionController {
+        // Types
+    public:
+        /**
+         * These are the possible outcomes of asking for admission.
+         */
+        enum class Verdict {
+            /**
+             * The connection is admitted.
+             */
+            Admitted,
+
+            /**
+             * The connection is refused because too many
+             * connections are already open.
+             */
+            TooManyConnections,
+
+            /**
+             * The connection is refused because too many connections
+             * from the same address are already open.
+             */
+            TooManyFromAddress,
+
+            /**
+             * The connection is refused because connections
+             * are coming too quickly.
+             */
+            RateLimited,
+        };
+
+        /**
+         * This is the type of object held by each admitted
+         * connection for as long as it's open.
+         */
+        typedef std::shared_ptr< void > Ticket;
+
+        // Lifecycle management
+    public:
+        ~AdmissionController() noexcept;
+        AdmissionController(const AdmissionController&) = delete;
+        AdmissionController(AdmissionController&&) noexcept;
+        AdmissionController& operator=(const AdmissionController&) = delete;
+        AdmissionController& operator=(AdmissionController&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         */
+        AdmissionController();
+
+        /**
+         * This method sets the limits placed on incoming connections.
+         * Connections already admitted remain admitted.
+         *
+         * @param[in] policy
+         *      This holds the limits to place on incoming connections.
+         */
+        void SetPolicy(const NetworkEndPoint::AdmissionPolicy& policy);
+
+        /**
+         * This method returns an indication of whether or not
+         * the policy places any limit on incoming connections.
+         *
+         * @return
+         *      An indication of whether or not the policy places
+         *      any limit on incoming connections is returned.
+         */
+        bool IsLimited() const;
+
+        /**
+         * This method decides whether or not to admit a connection
+         * from the given address.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer of the connection.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @param[out] ticket
+         *      This is where to store the ticket to be held by the
+         *      connection for as long as it's open, if it's admitted.
+         *
+         * @return
+         *      The decision made about the connection is returned.
+         */
+        Verdict Admit(
+            uint32_t address,
+            double now,
+            Ticket& ticket
+        );
+
+        /**
+         * This method returns the counts of connections
+         * admitted or refused, and why.
+         *
+         * @return
+         *      The counts of connections admitted or refused,
+         *      and why, are returned.
+         */
+        NetworkEndPoint::AdmissionStatistics GetStatistics() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         * It's shared with the tickets handed out, so they can be
+         * counted back in if the controller still exists.
+         */
+        std::shared_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_ADMISSION_CONTROLLER_HPP */
@@ -0,0 +1,76 @@
+/**
+ * @file AlignedBuffer.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::AlignedBuffer class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <SystemUtils/AlignedBuffer.hpp>
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of an AlignedBuffer instance.
+     */
+    struct AlignedBuffer::Impl {
+        /**
+         * This is the memory allocated for the buffer, which is
+         * larger than the buffer so that an aligned block of the
+         * right size can always be found in it.
+         */
+        std::unique_ptr< uint8_t[] > storage;
+
+        /**
+         * This is the address of the first byte of the buffer.
+         */
+        uint8_t* data = nullptr;
+
+        /**
+         * This is the number of bytes the buffer holds.
+         */
+        size_t size = 0;
+
+        /**
+         * This is the number of which the address
+         * of the buffer is a multiple.
+         */
+        size_t alignment = 1;
+    };
+
+    constexpr size_t AlignedBuffer::DEFAULT_ALIGNMENT;
+
+    AlignedBuffer::~AlignedBuffer() noexcept = default;
+    AlignedBuffer::AlignedBuffer(AlignedBuffer&&) noexcept = default;
+    AlignedBuffer& AlignedBuffer::operator=(AlignedBuffer&&) noexcept = default;
+
+    AlignedBuffer::AlignedBuffer(size_t size, size_t alignment)
+        : impl_(new Impl())
+    {
+        while (impl_->alignment < alignment) {
+            impl_->alignment <<= 1;
+        }
+        impl_->size = size;
+        if (size == 0) {
+            return;
+        }
+        impl_->storage.reset(new uint8_t[size + impl_->alignment - 1]());
+        const auto address = (uintptr_t)impl_->storage.get();
+        const auto mask = (uintptr_t)(impl_->alignment - 1);
+        impl_->data = (uint8_t*)((address + mask) & ~mask);
+    }
+
+    uint8_t* AlignedBuffer::GetData() const {
+        return impl_->data;
+    }
+
+    size_t AlignedBuffer::GetSize() const {
+        return impl_->size;
+    }
+
+    size_t AlignedBuffer::GetAlignment() const {
+        return impl_->alignment;
+    }
+
+}
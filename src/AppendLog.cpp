@@ -0,0 +1,252 @@
+/**
+ * @file AppendLog.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::AppendLog class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <SystemUtils/AppendLog.hpp>
+#include <SystemUtils/File.hpp>
+#include <thread>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of an AppendLog instance.
+     */
+    struct AppendLog::Impl {
+        // Properties
+
+        /**
+         * This is the file holding the log.
+         */
+        std::unique_ptr< File > file;
+
+        /**
+         * This is the number of bytes of space to reserve
+         * for the file at a time as it grows.
+         */
+        uint64_t segmentSize = DEFAULT_SEGMENT_SIZE;
+
+        /**
+         * This is used to synchronize access to the log.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake up the flusher when records are
+         * appended or when the log is being closed.
+         */
+        std::condition_variable flushCondition;
+
+        /**
+         * This is used to wake up callers waiting
+         * for records to be stored.
+         */
+        std::condition_variable durableCondition;
+
+        /**
+         * These are the bytes of records appended
+         * but not yet handed to the flusher.
+         */
+        std::vector< uint8_t > pending;
+
+        /**
+         * These are the bytes of records being written by the flusher.
+         * It trades places with the pending records each batch, so
+         * that neither needs to be allocated again.
+         */
+        std::vector< uint8_t > writing;
+
+        /**
+         * This is the offset in the file just past
+         * the last record appended.
+         */
+        uint64_t appendedEnd = 0;
+
+        /**
+         * This is the offset in the file up to which
+         * everything is stored on the device.
+         */
+        uint64_t durableEnd = 0;
+
+        /**
+         * This is the offset in the file up to which space is
+         * reserved.  It's only used by the flusher.
+         */
+        uint64_t allocatedEnd = 0;
+
+        /**
+         * This flag indicates whether or not the log is open.
+         */
+        bool open = false;
+
+        /**
+         * This flag indicates whether or not the flusher should
+         * stop once it has written everything appended.
+         */
+        bool stop = false;
+
+        /**
+         * This flag indicates whether or not writing
+         * to the file has failed.
+         */
+        bool failed = false;
+
+        /**
+         * This is the thread which writes appended
+         * records to the file in batches.
+         */
+        std::thread flusher;
+
+        // Methods
+
+        /**
+         * This method is called as the body of the flusher thread.
+         * Each time around, it takes every record appended so far,
+         * writes them to the file at once, waits for them to be stored,
+         * and then wakes up everyone waiting for them.
+         */
+        void Flush() {
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            for (;;) {
+                flushCondition.wait(
+                    lock,
+                    [this]{ return (stop || !pending.empty()); }
+                );
+                if (pending.empty()) {
+                    return;
+                }
+                writing.swap(pending);
+                const auto offset = durableEnd;
+                const auto end = appendedEnd;
+                lock.unlock();
+                if (end > allocatedEnd) {
+                    allocatedEnd = ((end + segmentSize - 1) / segmentSize) * segmentSize;
+                    (void)file->Preallocate(allocatedEnd);
+                }
+                const auto success = (
+                    (file->WriteAt(offset, writing.data(), writing.size()) == writing.size())
+                    && file->Sync()
+                );
+                writing.clear();
+                lock.lock();
+                if (success) {
+                    durableEnd = end;
+                } else {
+                    failed = true;
+                    pending.clear();
+                }
+                durableCondition.notify_all();
+            }
+        }
+    };
+
+    constexpr uint64_t AppendLog::DEFAULT_SEGMENT_SIZE;
+
+    AppendLog::~AppendLog() noexcept {
+        if (impl_ != nullptr) {
+            Close();
+        }
+    }
+    AppendLog::AppendLog(AppendLog&&) noexcept = default;
+    AppendLog& AppendLog::operator=(AppendLog&&) noexcept = default;
+
+    AppendLog::AppendLog()
+        : impl_(new Impl())
+    {
+    }
+
+    bool AppendLog::Open(
+        const std::string& path,
+        uint64_t segmentSize
+    ) {
+        Close();
+        std::unique_ptr< File > file(new File(path));
+        if (!file->OpenReadWrite()) {
+            return false;
+        }
+        const auto size = file->GetSize();
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->file = std::move(file);
+        impl_->segmentSize = ((segmentSize == 0) ? 1 : segmentSize);
+        impl_->appendedEnd = size;
+        impl_->durableEnd = size;
+        impl_->allocatedEnd = size;
+        impl_->open = true;
+        impl_->stop = false;
+        impl_->failed = false;
+        impl_->flusher = std::thread(&Impl::Flush, impl_.get());
+        return true;
+    }
+
+    void AppendLog::Close() {
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            if (!impl_->open) {
+                return;
+            }
+            impl_->stop = true;
+            impl_->flushCondition.notify_one();
+        }
+        impl_->flusher.join();
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->open = false;
+        impl_->file->Close();
+        impl_->file.reset();
+        impl_->durableCondition.notify_all();
+    }
+
+    uint64_t AppendLog::Append(const void* record, size_t size) {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        if (
+            !impl_->open
+            || impl_->stop
+            || impl_->failed
+        ) {
+            return 0;
+        }
+        impl_->pending.insert(
+            impl_->pending.end(),
+            (const uint8_t*)record,
+            (const uint8_t*)record + size
+        );
+        impl_->appendedEnd += size;
+        impl_->flushCondition.notify_one();
+        return impl_->appendedEnd;
+    }
+
+    bool AppendLog::WaitDurable(uint64_t offset) {
+        std::unique_lock< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->durableCondition.wait(
+            lock,
+            [this, offset]{
+                return (
+                    (impl_->durableEnd >= offset)
+                    || impl_->failed
+                    || !impl_->open
+                );
+            }
+        );
+        return (impl_->durableEnd >= offset);
+    }
+
+    bool AppendLog::AppendDurable(const void* record, size_t size) {
+        const auto offset = Append(record, size);
+        if (offset == 0) {
+            return false;
+        }
+        return WaitDurable(offset);
+    }
+
+    uint64_t AppendLog::GetDurableOffset() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->durableEnd;
+    }
+
+}
@@ -0,0 +1,165 @@
+/**
+ * @file BufferPool.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::BufferPool class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "BufferPool.hpp"
+
+#include <mutex>
+
+namespace SystemUtils {
+
+    /**
+     * This holds the private properties of the BufferPool class.
+     */
+    struct BufferPool::Impl {
+        // Properties
+
+        /**
+         * This is the number of bytes in each buffer
+         * handed out by the pool.
+         */
+        size_t bufferSize = 0;
+
+        /**
+         * This is the maximum number of released buffers
+         * the pool keeps for reuse.
+         */
+        size_t maxBuffersPooled = 0;
+
+        /**
+         * This is used to synchronize access to the pool.
+         */
+        std::mutex mutex;
+
+        /**
+         * These are the released buffers kept for reuse.
+         */
+        std::vector< std::vector< uint8_t >* > freeBuffers;
+
+        // Lifecycle management
+
+        ~Impl() noexcept {
+            for (auto buffer: freeBuffers) {
+                delete buffer;
+            }
+        }
+
+        // Methods
+
+        /**
+         * This method is called when the last reference to a buffer
+         * handed out by the pool is released.
+         *
+         * @param[in] buffer
+         *      This is the buffer which was released.
+         */
+        void Release(std::vector< uint8_t >* buffer) {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            if (freeBuffers.size() < maxBuffersPooled) {
+                freeBuffers.push_back(buffer);
+            } else {
+                delete buffer;
+            }
+        }
+
+        /**
+         * This method takes a released buffer for reuse, or allocates
+         * a new one with room for the pool's buffer size if there are
+         * none.  The buffer's size is left as it was.
+         *
+         * @return
+         *      The buffer taken is returned.
+         */
+        std::vector< uint8_t >* Take() {
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                if (!freeBuffers.empty()) {
+                    const auto buffer = freeBuffers.back();
+                    freeBuffers.pop_back();
+                    return buffer;
+                }
+            }
+            const auto buffer = new std::vector< uint8_t >();
+            buffer->reserve(bufferSize);
+            return buffer;
+        }
+
+        /**
+         * This function hands out the given buffer, arranging for it
+         * to go back to the given pool once the last reference to it
+         * is released, or be freed if the pool is gone by then.
+         *
+         * @param[in] pool
+         *      This is the pool to which the buffer belongs.
+         *
+         * @param[in] buffer
+         *      This is the buffer to hand out.
+         *
+         * @return
+         *      A reference to the buffer is returned.
+         */
+        static std::shared_ptr< std::vector< uint8_t > > Wrap(
+            const std::shared_ptr< Impl >& pool,
+            std::vector< uint8_t >* buffer
+        ) {
+            std::weak_ptr< Impl > weakPool(pool);
+            return std::shared_ptr< std::vector< uint8_t > >(
+                buffer,
+                [weakPool](std::vector< uint8_t >* releasedBuffer){
+                    const auto livePool = weakPool.lock();
+                    if (livePool == nullptr) {
+                        delete releasedBuffer;
+                    } else {
+                        livePool->Release(releasedBuffer);
+                    }
+                }
+            );
+        }
+    };
+
+    BufferPool::~BufferPool() noexcept = default;
+    BufferPool::BufferPool(BufferPool&&) noexcept = default;
+    BufferPool& BufferPool::operator=(BufferPool&&) noexcept = default;
+
+    BufferPool::BufferPool(size_t bufferSize, size_t maxBuffersPooled)
+        : impl_(std::make_shared< Impl >())
+    {
+        impl_->bufferSize = bufferSize;
+        impl_->maxBuffersPooled = maxBuffersPooled;
+        impl_->freeBuffers.reserve(maxBuffersPooled);
+    }
+
+    std::shared_ptr< std::vector< uint8_t > > BufferPool::Acquire() {
+        const auto buffer = impl_->Take();
+        buffer->resize(impl_->bufferSize);
+        return Impl::Wrap(impl_, buffer);
+    }
+
+    std::shared_ptr< std::vector< uint8_t > > BufferPool::Acquire(
+        const void* data,
+        size_t size
+    ) {
+        // Assigning from a range within the buffer's capacity copies
+        // the bytes straight in, without zero-filling the buffer first,
+        // as resizing it would.
+        const auto buffer = impl_->Take();
+        const auto bytes = (const uint8_t*)data;
+        buffer->assign(bytes, bytes + size);
+        return Impl::Wrap(impl_, buffer);
+    }
+
+    size_t BufferPool::GetBufferSize() const noexcept {
+        return impl_->bufferSize;
+    }
+
+    size_t BufferPool::GetBuffersPooled() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->freeBuffers.size();
+    }
+
+}
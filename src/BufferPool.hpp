@@ -0,0 +1,129 @@
+#ifndef SYSTEM_UTILS_BUFFER_POOL_HPP
+#define SYSTEM_UTILS_BUFFER_POOL_HPP
+
+/**
+ * @file BufferPool.hpp
+ *
+ * This module declares the SystemUtils::BufferPool class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class hands out reference-counted buffers of a fixed size,
+     * and takes them back for reuse once the last reference to them
+     * is released, so that steady streams of messages don't need
+     * a fresh allocation each.
+     *
+     * Buffers may be released from any thread, and may outlive
+     * the pool itself.
+     */
+    class BufferPool {
+        // Lifecycle management
+    public:
+        ~BufferPool() noexcept;
+        BufferPool(const BufferPool&) = delete;
+        BufferPool(BufferPool&&) noexcept;
+        BufferPool& operator=(const BufferPool&) = delete;
+        BufferPool& operator=(BufferPool&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] bufferSize
+         *      This is the number of bytes in each buffer
+         *      handed out by the pool.
+         *
+         * @param[in] maxBuffersPooled
+         *      This is the maximum number of released buffers
+         *      the pool keeps for reuse. Buffers released beyond
+         *      this are freed.
+         */
+        BufferPool(size_t bufferSize, size_t maxBuffersPooled);
+
+        /**
+         * This method hands out a buffer from the pool, allocating
+         * a new one if none are available for reuse.
+         *
+         * @return
+         *      A buffer holding the pool's buffer size in bytes
+         *      is returned. It goes back to the pool once the last
+         *      reference to it is released. It may be resized,
+         *      as long as its size never grows beyond the pool's
+         *      buffer size.
+         */
+        std::shared_ptr< std::vector< uint8_t > > Acquire();
+
+        /**
+         * This method hands out a buffer from the pool holding a copy
+         * of the given data, allocating a new one if none are available
+         * for reuse.  Unlike the other Acquire method, the buffer isn't
+         * first filled out to the pool's buffer size, so only the bytes
+         * copied are written.
+         *
+         * @param[in] data
+         *      This is where to fetch the data to copy.
+         *
+         * @param[in] size
+         *      This is the number of bytes to copy.
+         *      It must not be more than the pool's buffer size.
+         *
+         * @return
+         *      A buffer holding a copy of the given data is returned.
+         *      It goes back to the pool once the last reference to it
+         *      is released.
+         */
+        std::shared_ptr< std::vector< uint8_t > > Acquire(
+            const void* data,
+            size_t size
+        );
+
+        /**
+         * This method returns the number of bytes in each buffer
+         * handed out by the pool.
+         *
+         * @return
+         *      The number of bytes in each buffer handed out
+         *      by the pool is returned.
+         */
+        size_t GetBufferSize() const noexcept;
+
+        /**
+         * This method returns the number of released buffers
+         * currently kept by the pool for reuse.
+         *
+         * @return
+         *      The number of released buffers currently kept
+         *      by the pool for reuse is returned.
+         */
+        size_t GetBuffersPooled() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         * It's shared with the buffers handed out, so they can find
+         * their way back to the pool if it still exists.
+         */
+        std::shared_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_BUFFER_POOL_HPP */
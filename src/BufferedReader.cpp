@@ -0,0 +1,211 @@
+/**
+ * @file BufferedReader.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::BufferedReader class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <algorithm>
+#include <string.h>
+#include <SystemUtils/BufferedReader.hpp>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is the number of bytes looked at, at a time, when
+     * searching for the end of a line in an unbuffered file.
+     */
+    constexpr size_t UNBUFFERED_LINE_CHUNK = 256;
+
+}
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of a BufferedReader instance.
+     */
+    struct BufferedReader::Impl {
+        /**
+         * This is the file from which to read.
+         */
+        IFile& file;
+
+        /**
+         * This holds bytes read from the file but
+         * not yet handed out.
+         */
+        std::vector< uint8_t > buffer;
+
+        /**
+         * This is the offset in the buffer of the
+         * next byte to hand out.
+         */
+        size_t head = 0;
+
+        /**
+         * This is the offset in the buffer just
+         * past the last byte read from the file.
+         */
+        size_t tail = 0;
+
+        explicit Impl(IFile& file)
+            : file(file)
+        {
+        }
+
+        /**
+         * This method returns the number of bytes read from
+         * the file but not yet handed out.
+         *
+         * @return
+         *      The number of bytes read from the file but
+         *      not yet handed out is returned.
+         */
+        size_t GetBuffered() const {
+            return tail - head;
+        }
+
+        /**
+         * This method moves any bytes not yet handed out to the front
+         * of the buffer, and reads from the file to fill the rest.
+         *
+         * @return
+         *      The number of bytes read from the file is returned.
+         */
+        size_t Fill() {
+            if (head > 0) {
+                if (head < tail) {
+                    (void)memmove(buffer.data(), buffer.data() + head, tail - head);
+                }
+                tail -= head;
+                head = 0;
+            }
+            if (tail == buffer.size()) {
+                return 0;
+            }
+            const auto amountRead = file.Read(buffer.data() + tail, buffer.size() - tail);
+            tail += amountRead;
+            return amountRead;
+        }
+    };
+
+    constexpr size_t BufferedReader::DEFAULT_BUFFER_SIZE;
+
+    BufferedReader::~BufferedReader() noexcept = default;
+    BufferedReader::BufferedReader(BufferedReader&&) noexcept = default;
+    BufferedReader& BufferedReader::operator=(BufferedReader&&) noexcept = default;
+
+    BufferedReader::BufferedReader(IFile& file, size_t bufferSize)
+        : impl_(new Impl(file))
+    {
+        impl_->buffer.resize(bufferSize);
+    }
+
+    size_t BufferedReader::Read(void* buffer, size_t numBytes) {
+        auto output = (uint8_t*)buffer;
+        size_t total = 0;
+        while (total < numBytes) {
+            const auto buffered = impl_->GetBuffered();
+            if (buffered > 0) {
+                const auto amount = std::min(buffered, numBytes - total);
+                (void)memcpy(output + total, impl_->buffer.data() + impl_->head, amount);
+                impl_->head += amount;
+                total += amount;
+                continue;
+            }
+
+            // Large reads skip the buffer and go straight
+            // to the caller's memory.
+            const auto remaining = numBytes - total;
+            if (remaining >= impl_->buffer.size()) {
+                const auto amountRead = impl_->file.Read(output + total, remaining);
+                total += amountRead;
+                if (amountRead < remaining) {
+                    break;
+                }
+                continue;
+            }
+            if (impl_->Fill() == 0) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    bool BufferedReader::ReadExactly(void* buffer, size_t numBytes) {
+        return (Read(buffer, numBytes) == numBytes);
+    }
+
+    size_t BufferedReader::Peek(void* buffer, size_t numBytes) {
+        if (impl_->buffer.empty()) {
+            return impl_->file.Peek(buffer, numBytes);
+        }
+        numBytes = std::min(numBytes, impl_->buffer.size());
+        while (
+            (impl_->GetBuffered() < numBytes)
+            && (impl_->Fill() > 0)
+        ) {
+        }
+        const auto amount = std::min(numBytes, impl_->GetBuffered());
+        (void)memcpy(buffer, impl_->buffer.data() + impl_->head, amount);
+        return amount;
+    }
+
+    bool BufferedReader::ReadLine(std::string& line) {
+        line.clear();
+        bool readAnything = false;
+        bool foundEnd = false;
+        if (impl_->buffer.empty()) {
+            char chunk[UNBUFFERED_LINE_CHUNK];
+            while (!foundEnd) {
+                const auto amount = impl_->file.Peek(chunk, sizeof(chunk));
+                if (amount == 0) {
+                    break;
+                }
+                readAnything = true;
+                const auto end = (const char*)memchr(chunk, '\n', amount);
+                const auto lineAmount = ((end == nullptr) ? amount : (size_t)(end - chunk));
+                (void)line.append(chunk, lineAmount);
+                foundEnd = (end != nullptr);
+                impl_->file.SetPosition(
+                    impl_->file.GetPosition() + lineAmount + (foundEnd ? 1 : 0)
+                );
+            }
+        } else {
+            while (!foundEnd) {
+                if (
+                    (impl_->GetBuffered() == 0)
+                    && (impl_->Fill() == 0)
+                ) {
+                    break;
+                }
+                readAnything = true;
+
+                // memchr is vectorized by the C runtime, so this
+                // scans many bytes per instruction for the line feed.
+                const auto start = impl_->buffer.data() + impl_->head;
+                const auto buffered = impl_->GetBuffered();
+                const auto end = (const uint8_t*)memchr(start, '\n', buffered);
+                const auto lineAmount = ((end == nullptr) ? buffered : (size_t)(end - start));
+                (void)line.append((const char*)start, lineAmount);
+                foundEnd = (end != nullptr);
+                impl_->head += lineAmount + (foundEnd ? 1 : 0);
+            }
+        }
+        if (
+            !line.empty()
+            && (line[line.length() - 1] == '\r')
+        ) {
+            line.pop_back();
+        }
+        return readAnything;
+    }
+
+    uint64_t BufferedReader::GetPosition() const {
+        return impl_->file.GetPosition() - impl_->GetBuffered();
+    }
+
+}
@@ -0,0 +1,104 @@
+/**
+ * @file BufferedWriter.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::BufferedWriter class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <string.h>
+#include <SystemUtils/BufferedWriter.hpp>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of a BufferedWriter instance.
+     */
+    struct BufferedWriter::Impl {
+        /**
+         * This is the file to which to write.
+         */
+        IFile& file;
+
+        /**
+         * This holds bytes written but not yet handed to the file.
+         * Its capacity is the buffer size.
+         */
+        std::vector< uint8_t > buffer;
+
+        /**
+         * This is the number of bytes to collect
+         * before writing them to the file.
+         */
+        size_t bufferSize = 0;
+
+        explicit Impl(IFile& file)
+            : file(file)
+        {
+        }
+    };
+
+    constexpr size_t BufferedWriter::DEFAULT_BUFFER_SIZE;
+
+    BufferedWriter::~BufferedWriter() noexcept {
+        if (impl_ != nullptr) {
+            (void)Flush();
+        }
+    }
+    BufferedWriter::BufferedWriter(BufferedWriter&&) noexcept = default;
+    BufferedWriter& BufferedWriter::operator=(BufferedWriter&& other) noexcept {
+        if (this != &other) {
+            if (impl_ != nullptr) {
+                (void)Flush();
+            }
+            impl_ = std::move(other.impl_);
+        }
+        return *this;
+    }
+
+    BufferedWriter::BufferedWriter(IFile& file, size_t bufferSize)
+        : impl_(new Impl(file))
+    {
+        impl_->bufferSize = bufferSize;
+        impl_->buffer.reserve(bufferSize);
+    }
+
+    size_t BufferedWriter::Write(const void* buffer, size_t numBytes) {
+        const auto input = (const uint8_t*)buffer;
+        if (impl_->buffer.size() + numBytes <= impl_->bufferSize) {
+            impl_->buffer.insert(impl_->buffer.end(), input, input + numBytes);
+            return numBytes;
+        }
+        if (!Flush()) {
+            return 0;
+        }
+
+        // Writes which won't fit in the buffer go
+        // straight to the file.
+        if (numBytes >= impl_->bufferSize) {
+            return impl_->file.Write(buffer, numBytes);
+        }
+        impl_->buffer.insert(impl_->buffer.end(), input, input + numBytes);
+        return numBytes;
+    }
+
+    size_t BufferedWriter::Write(const std::string& text) {
+        return Write(text.data(), text.length());
+    }
+
+    bool BufferedWriter::Flush() {
+        if (impl_->buffer.empty()) {
+            return true;
+        }
+        const auto amountWritten = impl_->file.Write(impl_->buffer.data(), impl_->buffer.size());
+        (void)impl_->buffer.erase(impl_->buffer.begin(), impl_->buffer.begin() + amountWritten);
+        return impl_->buffer.empty();
+    }
+
+    uint64_t BufferedWriter::GetPosition() const {
+        return impl_->file.GetPosition() + impl_->buffer.size();
+    }
+
+}
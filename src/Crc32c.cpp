@@ -0,0 +1,555 @@
+/**
+ * @file Crc32c.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::Crc32c class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+#include <SystemUtils/Crc32c.hpp>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SYSTEM_UTILS_CRC32C_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <nmmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define SYSTEM_UTILS_CRC32C_ARM64
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <Windows.h>
+#else
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define SYSTEM_UTILS_TARGET_CRC
+#elif defined(SYSTEM_UTILS_CRC32C_X86)
+#define SYSTEM_UTILS_TARGET_CRC __attribute__((target("sse4.2")))
+#elif defined(SYSTEM_UTILS_CRC32C_ARM64)
+#define SYSTEM_UTILS_TARGET_CRC __attribute__((target("+crc")))
+#endif
+
+namespace {
+
+    /**
+     * This is the CRC-32C polynomial, in reversed bit order.
+     */
+    constexpr uint32_t POLYNOMIAL = 0x82F63B78;
+
+    /**
+     * This is the number of bytes read from a file at a time.
+     */
+    constexpr size_t READ_SIZE = 65536;
+
+    /**
+     * This is the type of function which extends a CRC-32C
+     * calculation (without the final inversion) over more data.
+     *
+     * @param[in] crc
+     *      This is the calculation so far.
+     *
+     * @param[in] data
+     *      This is where to fetch the data to add.
+     *
+     * @param[in] size
+     *      This is the number of bytes to add.
+     *
+     * @return
+     *      The calculation including the added data is returned.
+     */
+    typedef uint32_t (*Extender)(uint32_t crc, const uint8_t* data, size_t size);
+
+    /**
+     * These are the lookup tables used to calculate the checksum
+     * eight bytes at a time when the processor has no CRC instructions.
+     */
+    struct Tables {
+        uint32_t table[8][256];
+
+        Tables() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = ((crc & 1) ? ((crc >> 1) ^ POLYNOMIAL) : (crc >> 1));
+                }
+                table[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (size_t slice = 1; slice < 8; ++slice) {
+                    table[slice][i] = (
+                        (table[slice - 1][i] >> 8)
+                        ^ table[0][table[slice - 1][i] & 0xFF]
+                    );
+                }
+            }
+        }
+    };
+
+    /**
+     * This function extends a CRC-32C calculation over more data
+     * using lookup tables.
+     *
+     * @param[in] crc
+     *      This is the calculation so far.
+     *
+     * @param[in] data
+     *      This is where to fetch the data to add.
+     *
+     * @param[in] size
+     *      This is the number of bytes to add.
+     *
+     * @return
+     *      The calculation including the added data is returned.
+     */
+    uint32_t ExtendWithTables(uint32_t crc, const uint8_t* data, size_t size) {
+        static const Tables tables;
+        const auto& table = tables.table;
+        while (size >= 8) {
+            uint32_t low, high;
+            (void)memcpy(&low, data, 4);
+            (void)memcpy(&high, data + 4, 4);
+            low ^= crc;
+            crc = (
+                table[7][low & 0xFF]
+                ^ table[6][(low >> 8) & 0xFF]
+                ^ table[5][(low >> 16) & 0xFF]
+                ^ table[4][low >> 24]
+                ^ table[3][high & 0xFF]
+                ^ table[2][(high >> 8) & 0xFF]
+                ^ table[1][(high >> 16) & 0xFF]
+                ^ table[0][high >> 24]
+            );
+            data += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+            --size;
+        }
+        return crc;
+    }
+
+#if defined(SYSTEM_UTILS_CRC32C_X86)
+    /**
+     * This function extends a CRC-32C calculation over more data
+     * using the SSE 4.2 CRC instructions.
+     *
+     * @param[in] crc
+     *      This is the calculation so far.
+     *
+     * @param[in] data
+     *      This is where to fetch the data to add.
+     *
+     * @param[in] size
+     *      This is the number of bytes to add.
+     *
+     * @return
+     *      The calculation including the added data is returned.
+     */
+    SYSTEM_UTILS_TARGET_CRC
+    uint32_t ExtendWithInstructions(uint32_t crc, const uint8_t* data, size_t size) {
+#if defined(_M_X64) || defined(__x86_64__)
+        uint64_t crc64 = crc;
+        while (size >= 8) {
+            uint64_t word;
+            (void)memcpy(&word, data, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+            data += 8;
+            size -= 8;
+        }
+        crc = (uint32_t)crc64;
+#endif
+        while (size >= 4) {
+            uint32_t word;
+            (void)memcpy(&word, data, 4);
+            crc = _mm_crc32_u32(crc, word);
+            data += 4;
+            size -= 4;
+        }
+        while (size > 0) {
+            crc = _mm_crc32_u8(crc, *data++);
+            --size;
+        }
+        return crc;
+    }
+
+    /**
+     * This function determines whether or not the processor
+     * has the SSE 4.2 CRC instructions.
+     *
+     * @return
+     *      An indication of whether or not the processor has
+     *      the SSE 4.2 CRC instructions is returned.
+     */
+    bool HasCrcInstructions() {
+#ifdef _MSC_VER
+        int registers[4];
+        __cpuid(registers, 1);
+        return ((registers[2] & (1 << 20)) != 0);
+#else
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+            return false;
+        }
+        return ((ecx & bit_SSE4_2) != 0);
+#endif
+    }
+#elif defined(SYSTEM_UTILS_CRC32C_ARM64)
+    /**
+     * This function extends a CRC-32C calculation over more data
+     * using the ARMv8 CRC instructions.
+     *
+     * @param[in] crc
+     *      This is the calculation so far.
+     *
+     * @param[in] data
+     *      This is where to fetch the data to add.
+     *
+     * @param[in] size
+     *      This is the number of bytes to add.
+     *
+     * @return
+     *      The calculation including the added data is returned.
+     */
+    SYSTEM_UTILS_TARGET_CRC
+    uint32_t ExtendWithInstructions(uint32_t crc, const uint8_t* data, size_t size) {
+        while (size >= 8) {
+            uint64_t word;
+            (void)memcpy(&word, data, 8);
+            crc = __crc32cd(crc, word);
+            data += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            crc = __crc32cb(crc, *data++);
+            --size;
+        }
+        return crc;
+    }
+
+    /**
+     * This function determines whether or not the processor
+     * has the ARMv8 CRC instructions.
+     *
+     * @return
+     *      An indication of whether or not the processor has
+     *      the ARMv8 CRC instructions is returned.
+     */
+    bool HasCrcInstructions() {
+#ifdef _MSC_VER
+        return (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE) != 0);
+#else
+        return ((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0);
+#endif
+    }
+#endif
+
+    /**
+     * This function returns the fastest function available on this
+     * processor for extending a CRC-32C calculation over more data.
+     *
+     * @return
+     *      The fastest function available on this processor for
+     *      extending a CRC-32C calculation is returned.
+     */
+    Extender SelectExtender() {
+#if defined(SYSTEM_UTILS_CRC32C_X86) || defined(SYSTEM_UTILS_CRC32C_ARM64)
+        if (HasCrcInstructions()) {
+            return ExtendWithInstructions;
+        }
+#endif
+        return ExtendWithTables;
+    }
+
+    /**
+     * This function adds the given data to a checksum.
+     *
+     * @param[in] crc
+     *      This is the checksum of the data so far.
+     *
+     * @param[in] data
+     *      This is where to fetch the data to add.
+     *
+     * @param[in] size
+     *      This is the number of bytes to add.
+     *
+     * @return
+     *      The checksum including the added data is returned.
+     */
+    uint32_t Extend(uint32_t crc, const void* data, size_t size) {
+        static const Extender extender = SelectExtender();
+        return ~extender(~crc, (const uint8_t*)data, size);
+    }
+
+    /**
+     * This function multiplies two polynomials modulo the
+     * CRC-32C polynomial, in reversed bit order.
+     *
+     * @param[in] a
+     *      This is the first polynomial to multiply.
+     *
+     * @param[in] b
+     *      This is the second polynomial to multiply.
+     *
+     * @return
+     *      The product of the two polynomials, modulo the
+     *      CRC-32C polynomial, is returned.
+     */
+    uint32_t MultiplyModulo(uint32_t a, uint32_t b) {
+        uint32_t product = 0;
+        for (uint32_t bit = 0x80000000; bit != 0; bit >>= 1) {
+            if ((a & bit) != 0) {
+                product ^= b;
+            }
+            b = ((b & 1) ? ((b >> 1) ^ POLYNOMIAL) : (b >> 1));
+        }
+        return product;
+    }
+
+    /**
+     * This function computes x raised to the power of eight times
+     * the given number, modulo the CRC-32C polynomial, which is
+     * the factor by which a checksum is shifted past that many
+     * bytes of zeros.
+     *
+     * @param[in] numBytes
+     *      This is the number of bytes past which to shift.
+     *
+     * @return
+     *      The factor by which to multiply a checksum to shift
+     *      it past the given number of bytes is returned.
+     */
+    uint32_t ShiftFactor(uint64_t numBytes) {
+        // powers[k] is x^(2^k) modulo the polynomial.
+        static const struct Powers {
+            uint32_t powers[64];
+
+            Powers() {
+                powers[0] = 0x40000000;
+                for (size_t k = 1; k < 64; ++k) {
+                    powers[k] = MultiplyModulo(powers[k - 1], powers[k - 1]);
+                }
+            }
+        } powers;
+        uint32_t factor = 0x80000000;
+        for (size_t k = 3; numBytes != 0; ++k, numBytes >>= 1) {
+            if ((numBytes & 1) != 0) {
+                factor = MultiplyModulo(powers.powers[k % 64], factor);
+            }
+        }
+        return factor;
+    }
+
+    /**
+     * This function adds the given region of a file to a checksum.
+     *
+     * @param[in] crc
+     *      This is the checksum of the data so far.
+     *
+     * @param[in] file
+     *      This is the file from which to read the data to add.
+     *
+     * @param[in] offset
+     *      This is the offset in the file of the first byte to add.
+     *
+     * @param[in] length
+     *      This is the number of bytes to add.
+     *
+     * @param[out] success
+     *      This is where to store an indication of whether
+     *      or not the whole region could be read.
+     *
+     * @return
+     *      The checksum including the added data is returned.
+     */
+    uint32_t ExtendFromFile(
+        uint32_t crc,
+        const SystemUtils::IFile& file,
+        uint64_t offset,
+        uint64_t length,
+        bool& success
+    ) {
+        std::vector< uint8_t > buffer((size_t)std::min((uint64_t)READ_SIZE, length));
+        while (length > 0) {
+            const auto amount = (size_t)std::min((uint64_t)buffer.size(), length);
+            const auto amountRead = file.ReadAt(offset, buffer.data(), amount);
+            crc = Extend(crc, buffer.data(), amountRead);
+            if (amountRead < amount) {
+                success = false;
+                return crc;
+            }
+            offset += amount;
+            length -= amount;
+        }
+        success = true;
+        return crc;
+    }
+
+    /**
+     * This function works out how much of a file to read,
+     * given an offset and length which may be zero,
+     * meaning "to the end of the file".
+     *
+     * @param[in] file
+     *      This is the file to read.
+     *
+     * @param[in] offset
+     *      This is the offset in the file of the first byte to read.
+     *
+     * @param[in] length
+     *      This is the number of bytes requested, or zero
+     *      to read everything from the offset to the end.
+     *
+     * @return
+     *      The number of bytes to read is returned.
+     */
+    uint64_t GetRegionLength(
+        const SystemUtils::IFile& file,
+        uint64_t offset,
+        uint64_t length
+    ) {
+        if (length != 0) {
+            return length;
+        }
+        const auto size = file.GetSize();
+        return ((offset < size) ? (size - offset) : 0);
+    }
+
+}
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of a Crc32c instance.
+     */
+    struct Crc32c::Impl {
+        /**
+         * This is the checksum of the data given so far.
+         */
+        uint32_t value = 0;
+    };
+
+    constexpr uint64_t Crc32c::DEFAULT_CHUNK_SIZE;
+
+    Crc32c::~Crc32c() noexcept = default;
+    Crc32c::Crc32c(Crc32c&&) noexcept = default;
+    Crc32c& Crc32c::operator=(Crc32c&&) noexcept = default;
+
+    Crc32c::Crc32c()
+        : impl_(new Impl())
+    {
+    }
+
+    void Crc32c::Reset() {
+        impl_->value = 0;
+    }
+
+    void Crc32c::Update(const void* data, size_t size) {
+        impl_->value = Extend(impl_->value, data, size);
+    }
+
+    bool Crc32c::Update(
+        const IFile& file,
+        uint64_t offset,
+        uint64_t length
+    ) {
+        bool success;
+        impl_->value = ExtendFromFile(
+            impl_->value,
+            file,
+            offset,
+            GetRegionLength(file, offset, length),
+            success
+        );
+        return success;
+    }
+
+    uint32_t Crc32c::GetValue() const {
+        return impl_->value;
+    }
+
+    uint32_t Crc32c::Compute(const void* data, size_t size) {
+        return Extend(0, data, size);
+    }
+
+    bool Crc32c::Compute(
+        const IFile& file,
+        uint32_t& value,
+        uint64_t offset,
+        uint64_t length,
+        size_t numThreads,
+        uint64_t chunkSize
+    ) {
+        length = GetRegionLength(file, offset, length);
+        if (chunkSize == 0) {
+            chunkSize = DEFAULT_CHUNK_SIZE;
+        }
+        const auto numChunks = (size_t)((length + chunkSize - 1) / chunkSize);
+        if (
+            (numThreads <= 1)
+            || (numChunks <= 1)
+        ) {
+            bool success;
+            value = ExtendFromFile(0, file, offset, length, success);
+            return success;
+        }
+        std::vector< uint32_t > chunkValues(numChunks);
+        std::mutex mutex;
+        bool success = true;
+        {
+            WorkerPool workers(std::min(numThreads, numChunks));
+            for (size_t i = 0; i < numChunks; ++i) {
+                workers.Post(
+                    [&, i]{
+                        const auto chunkOffset = i * chunkSize;
+                        bool chunkSuccess;
+                        chunkValues[i] = ExtendFromFile(
+                            0,
+                            file,
+                            offset + chunkOffset,
+                            std::min(chunkSize, length - chunkOffset),
+                            chunkSuccess
+                        );
+                        if (!chunkSuccess) {
+                            std::lock_guard< decltype(mutex) > lock(mutex);
+                            success = false;
+                        }
+                    }
+                );
+            }
+            workers.Wait();
+        }
+        value = chunkValues[0];
+        for (size_t i = 1; i < numChunks; ++i) {
+            const auto chunkOffset = i * chunkSize;
+            value = Combine(
+                value,
+                chunkValues[i],
+                std::min(chunkSize, length - chunkOffset)
+            );
+        }
+        return success;
+    }
+
+    uint32_t Crc32c::Combine(
+        uint32_t first,
+        uint32_t second,
+        uint64_t secondSize
+    ) {
+        return MultiplyModulo(ShiftFactor(secondSize), first) ^ second;
+    }
+
+}
@@ -0,0 +1,57 @@
+/**
+ * @file DirectoryIterator.cpp
+ *
+ * This module contains the platform-independent part of the
+ * implementation of the SystemUtils::DirectoryIterator class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "WorkerPool.hpp"
+
+#include <atomic>
+#include <SystemUtils/DirectoryIterator.hpp>
+
+namespace SystemUtils {
+
+    constexpr size_t DirectoryIterator::DEFAULT_BATCH_BYTES;
+
+    bool DirectoryIterator::Walk(
+        const std::string& directory,
+        Visitor visitor,
+        size_t numThreads
+    ) {
+        WorkerPool pool(numThreads);
+        std::atomic< bool > failed(false);
+        std::function< void(const std::string&) > walkDirectory;
+        walkDirectory = [&pool, &failed, &visitor, &walkDirectory](const std::string& path){
+            DirectoryIterator iterator;
+            if (!iterator.Open(path)) {
+                failed = true;
+                return;
+            }
+            Entry entry;
+            while (iterator.Next(entry)) {
+                if (
+                    visitor(entry)
+                    && (entry.type == EntryType::Directory)
+                ) {
+                    const auto subdirectoryPath = entry.path;
+                    pool.Post(
+                        [&walkDirectory, subdirectoryPath]{
+                            walkDirectory(subdirectoryPath);
+                        }
+                    );
+                }
+            }
+        };
+        pool.Post(
+            [&walkDirectory, directory]{
+                walkDirectory(directory);
+            }
+        );
+        pool.Wait();
+        return !failed;
+    }
+
+}
@@ -41,6 +41,38 @@ namespace SystemUtils {
         return Write(&buffer[offset], numBytes);
     }
 
+    void File::Impl::SetLastError(const std::string& error) {
+        std::lock_guard< decltype(lastErrorMutex) > lock(lastErrorMutex);
+        lastError = error;
+    }
+
+    std::string File::GetLastError() const {
+        std::lock_guard< decltype(impl_->lastErrorMutex) > lock(impl_->lastErrorMutex);
+        return impl_->lastError;
+    }
+
+    AlignedBuffer File::AllocateBuffer(size_t size) const {
+        const auto blockSize = GetBlockSize();
+        return AlignedBuffer(
+            ((size + blockSize - 1) / blockSize) * blockSize,
+            blockSize
+        );
+    }
+
+    void File::Impl::UnmapViews() {
+        std::vector< std::weak_ptr< MappedView > > views;
+        {
+            std::lock_guard< decltype(mappedViewsMutex) > lock(mappedViewsMutex);
+            views.swap(mappedViews);
+        }
+        for (const auto& weakView: views) {
+            const auto view = weakView.lock();
+            if (view != nullptr) {
+                view->Unmap();
+            }
+        }
+    }
+
     bool File::CreateDirectory(const std::string& directory) {
         std::string directoryWithSeparator(directory);
         if (
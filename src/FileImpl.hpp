@@ -8,6 +8,9 @@
  * © 2024 by Hatem Nabli
 */
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 #include <SystemUtils\File.hpp>
 
 
@@ -26,11 +29,34 @@ namespace SystemUtils {
         */
        std::unique_ptr< Platform > platform_;
 
+        /**
+         * This is used to synchronize access to the list of views
+         * of the file mapped into memory.
+         */
+        std::mutex mappedViewsMutex;
+
+        /**
+         * These are the views of the file which have been mapped into
+         * memory, so that they can be unmapped when the file is closed.
+         */
+        std::vector< std::weak_ptr< MappedView > > mappedViews;
+
+        /**
+         * This is used to synchronize access to the last error.
+         */
+        std::mutex lastErrorMutex;
+
+        /**
+         * This is a human-readable description of the last error
+         * that occurred calling a method of the file.
+         */
+        std::string lastError;
+
        ~Impl() noexcept;
        Impl(const Impl&) = delete;
-       Impl(Impl&&) noexcept;
+       Impl(Impl&&) noexcept = delete;
        Impl& operator=(const Impl&) = delete;
-       Impl& operator=(Impl&&);
+       Impl& operator=(Impl&&) = delete;
 
         /**
         * This is the default constructor.
@@ -46,6 +72,21 @@ namespace SystemUtils {
          *    in it are ceated if they don't already exist.
          */
         static bool CreatePath(std::string path);
+
+        /**
+         * This method unmaps all views of the file
+         * which are still mapped into memory.
+         */
+        void UnmapViews();
+
+        /**
+         * This method records the last error that occurred
+         * calling a method of the file.
+         *
+         * @param[in] error
+         *      This is a human-readable description of the error.
+         */
+        void SetLastError(const std::string& error);
     };
 
 }
@@ -0,0 +1,115 @@
+/**
+ * @file InterfaceAddressCache.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::InterfaceAddressCache class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "InterfaceAddressCache.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace SystemUtils {
+
+    /**
+     * This holds the private properties of the InterfaceAddressCache class.
+     */
+    struct InterfaceAddressCache::Impl {
+        /**
+         * This is the function to call to query the operating
+         * system for the current addresses of the network interfaces.
+         */
+        QueryDelegate query;
+
+        /**
+         * This is used to synchronize access to the known addresses.
+         * It is held while querying them, so that a change reported
+         * during a query is never overwritten by the query's result.
+         */
+        std::mutex addressesMutex;
+
+        /**
+         * This flag indicates whether or not the addresses
+         * are currently known.
+         */
+        bool valid = false;
+
+        /**
+         * These are the known addresses of the network interfaces.
+         */
+        std::vector< uint32_t > addresses;
+
+        /**
+         * This is used to synchronize access to the subscriptions.
+         * It is held while change delegates are called, so that
+         * unsubscribing waits for any call in progress.
+         */
+        std::recursive_mutex subscriptionsMutex;
+
+        /**
+         * These are the current subscriptions to changes,
+         * keyed by subscription identifier.
+         */
+        std::map< int, ChangeDelegate > subscriptions;
+
+        /**
+         * This is the identifier to assign to the next subscription.
+         */
+        int nextSubscriptionId = 1;
+    };
+
+    InterfaceAddressCache::~InterfaceAddressCache() noexcept = default;
+    InterfaceAddressCache::InterfaceAddressCache(InterfaceAddressCache&&) noexcept = default;
+    InterfaceAddressCache& InterfaceAddressCache::operator=(InterfaceAddressCache&&) noexcept = default;
+
+    InterfaceAddressCache::InterfaceAddressCache(QueryDelegate query)
+        : impl_(std::make_shared< Impl >())
+    {
+        impl_->query = query;
+    }
+
+    std::vector< uint32_t > InterfaceAddressCache::GetAddresses() {
+        std::lock_guard< decltype(impl_->addressesMutex) > lock(impl_->addressesMutex);
+        if (!impl_->valid) {
+            impl_->addresses = impl_->query();
+            impl_->valid = true;
+        }
+        return impl_->addresses;
+    }
+
+    void InterfaceAddressCache::Invalidate() {
+        {
+            std::lock_guard< decltype(impl_->addressesMutex) > lock(impl_->addressesMutex);
+            impl_->valid = false;
+        }
+        std::lock_guard< decltype(impl_->subscriptionsMutex) > lock(impl_->subscriptionsMutex);
+        // Look up each next subscription afresh, since a delegate
+        // may unsubscribe while it's being called.
+        auto subscription = impl_->subscriptions.begin();
+        while (subscription != impl_->subscriptions.end()) {
+            const auto subscriptionId = subscription->first;
+            const auto delegate = subscription->second;
+            delegate();
+            subscription = impl_->subscriptions.upper_bound(subscriptionId);
+        }
+    }
+
+    auto InterfaceAddressCache::Subscribe(ChangeDelegate delegate) -> UnsubscribeDelegate {
+        std::lock_guard< decltype(impl_->subscriptionsMutex) > lock(impl_->subscriptionsMutex);
+        const auto subscriptionId = impl_->nextSubscriptionId++;
+        impl_->subscriptions[subscriptionId] = delegate;
+        std::weak_ptr< Impl > weakImpl(impl_);
+        return [weakImpl, subscriptionId]{
+            const auto impl = weakImpl.lock();
+            if (impl == nullptr) {
+                return;
+            }
+            std::lock_guard< decltype(impl->subscriptionsMutex) > lock(impl->subscriptionsMutex);
+            (void)impl->subscriptions.erase(subscriptionId);
+        };
+    }
+
+}
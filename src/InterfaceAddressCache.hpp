@@ -0,0 +1,125 @@
+#ifndef SYSTEM_UTILS_INTERFACE_ADDRESS_CACHE_HPP
+#define SYSTEM_UTILS_INTERFACE_ADDRESS_CACHE_HPP
+
+/**
+ * @file InterfaceAddressCache.hpp
+ *
+ * This module declares the SystemUtils::InterfaceAddressCache class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class remembers the IPv4 addresses of the network interfaces
+     * of the local host, so that they are only queried from the
+     * operating system again after something tells the cache they
+     * have changed.
+     *
+     * It also lets interested parties know when the addresses
+     * have changed.
+     */
+    class InterfaceAddressCache {
+        // Types
+    public:
+        /**
+         * This is the type of function called to query the operating
+         * system for the current addresses of the network interfaces.
+         *
+         * @return
+         *      The IPv4 addresses of all active network interfaces
+         *      on the local host are returned.
+         */
+        typedef std::function< std::vector< uint32_t >() > QueryDelegate;
+
+        /**
+         * This is the type of function called whenever the addresses
+         * of the network interfaces may have changed.
+         */
+        typedef std::function< void() > ChangeDelegate;
+
+        /**
+         * This is the type of function used to end a subscription
+         * to changes of the network interface addresses.
+         */
+        typedef std::function< void() > UnsubscribeDelegate;
+
+        // Lifecycle management
+    public:
+        ~InterfaceAddressCache() noexcept;
+        InterfaceAddressCache(const InterfaceAddressCache&) = delete;
+        InterfaceAddressCache(InterfaceAddressCache&&) noexcept;
+        InterfaceAddressCache& operator=(const InterfaceAddressCache&) = delete;
+        InterfaceAddressCache& operator=(InterfaceAddressCache&&) noexcept;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] query
+         *      This is the function to call to query the operating
+         *      system for the current addresses of the network interfaces.
+         */
+        explicit InterfaceAddressCache(QueryDelegate query);
+
+        /**
+         * This method returns the IPv4 addresses of all active network
+         * interfaces on the local host, querying them from the operating
+         * system only if they're not already known.
+         *
+         * @return
+         *      The IPv4 addresses of all active network interfaces
+         *      on the local host are returned.
+         */
+        std::vector< uint32_t > GetAddresses();
+
+        /**
+         * This method is called whenever the addresses of the network
+         * interfaces have changed. It forgets the known addresses, and
+         * calls all the change delegates subscribed.
+         */
+        void Invalidate();
+
+        /**
+         * This method forms a new subscription to changes of the
+         * network interface addresses.
+         *
+         * @param[in] delegate
+         *      This is the function to call whenever the addresses
+         *      of the network interfaces may have changed. It's called
+         *      from whichever thread learns of the change, so it should
+         *      do no more than signal the subscriber's own thread.
+         *
+         * @return
+         *      A function is returned which may be called to terminate
+         *      the subscription. Once it returns, the change delegate
+         *      is no longer being called, and never will be again.
+         */
+        UnsubscribeDelegate Subscribe(ChangeDelegate delegate);
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance. It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         * It's shared with the unsubscribe delegates handed out.
+         */
+        std::shared_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_INTERFACE_ADDRESS_CACHE_HPP */
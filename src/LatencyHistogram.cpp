@@ -0,0 +1,53 @@
+/**
+ * @file LatencyHistogram.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::LatencyHistogram class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "LatencyHistogram.hpp"
+
+namespace SystemUtils {
+
+    constexpr size_t LatencyHistogram::NUM_BUCKETS;
+
+    LatencyHistogram::LatencyHistogram() {
+        Reset();
+    }
+
+    void LatencyHistogram::Record(double delay) {
+        const double microseconds = delay * 1000000.0;
+        size_t bucket = 0;
+        if (microseconds >= 1.0) {
+            const uint64_t wholeMicroseconds = (
+                (microseconds >= (double)(1ULL << (NUM_BUCKETS - 1)))
+                ? (1ULL << (NUM_BUCKETS - 1))
+                : (uint64_t)microseconds
+            );
+            while (
+                (bucket < NUM_BUCKETS - 1)
+                && ((wholeMicroseconds >> bucket) != 0)
+            ) {
+                ++bucket;
+            }
+        }
+        (void)counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector< uint64_t > LatencyHistogram::GetCounts() const {
+        std::vector< uint64_t > counts(NUM_BUCKETS);
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            counts[i] = counts_[i].load(std::memory_order_relaxed);
+        }
+        return counts;
+    }
+
+    void LatencyHistogram::Reset() {
+        for (auto& count: counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+}
@@ -0,0 +1,83 @@
+#ifndef SYSTEM_UTILS_LATENCY_HISTOGRAM_HPP
+#define SYSTEM_UTILS_LATENCY_HISTOGRAM_HPP
+
+/**
+ * @file LatencyHistogram.hpp
+ *
+ * This module declares the SystemUtils::LatencyHistogram class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class counts measured delays in buckets whose bounds grow
+     * by powers of two, from one microsecond up to about half an hour.
+     *
+     * Bucket 0 counts delays shorter than one microsecond, and each
+     * bucket i after that counts delays of at least 2^(i-1) microseconds
+     * but shorter than 2^i microseconds. The last bucket also counts
+     * all delays longer than that.
+     *
+     * Delays may be recorded from one thread while
+     * the counts are read from others.
+     */
+    class LatencyHistogram {
+        // Constants
+    public:
+        /**
+         * This is the number of buckets in the histogram.
+         */
+        static constexpr size_t NUM_BUCKETS = 32;
+
+        // Lifecycle management
+    public:
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         */
+        LatencyHistogram();
+
+        /**
+         * This method counts the given delay in the histogram.
+         *
+         * @param[in] delay
+         *      This is the delay to count, in seconds.
+         *      Negative delays are counted as zero.
+         */
+        void Record(double delay);
+
+        /**
+         * This method returns the counts of delays in each bucket.
+         *
+         * @return
+         *      The counts of delays in each bucket are returned.
+         */
+        std::vector< uint64_t > GetCounts() const;
+
+        /**
+         * This method forgets all delays counted so far.
+         */
+        void Reset();
+
+        // Private properties
+    private:
+        /**
+         * These are the counts of delays in each bucket.
+         */
+        std::atomic< uint64_t > counts_[NUM_BUCKETS];
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_LATENCY_HISTOGRAM_HPP */
@@ -0,0 +1,234 @@
+#ifndef SYSTEM_UTILS_MPSC_QUEUE_HPP
+#define SYSTEM_UTILS_MPSC_QUEUE_HPP
+
+/**
+ * @file MpscQueue.hpp
+ *
+ * This module declares the SystemUtils::MpscQueue class template.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+namespace SystemUtils {
+
+    /**
+     * This is a bounded queue which any number of threads may fill,
+     * and which is drained by one consumer thread, without any of them
+     * taking a lock.
+     *
+     * The queue is a ring of cells, each tagged with a sequence number
+     * which tells producers and consumers whose turn it is to use the
+     * cell (this is Dmitry Vyukov's bounded queue algorithm).
+     *
+     * @note
+     *      Removing elements is also safe from producer threads, which
+     *      is what allows a producer to evict the oldest element when
+     *      the queue is full.
+     *
+     * @tparam T
+     *      This is the type of element held in the queue. It must be
+     *      default-constructible and move-assignable.
+     */
+    template< typename T > class MpscQueue {
+        // Lifecycle management
+    public:
+        ~MpscQueue() noexcept = default;
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue(MpscQueue&&) noexcept = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+        MpscQueue& operator=(MpscQueue&&) noexcept = delete;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] capacity
+         *      This is the minimum number of elements the queue
+         *      is able to hold. It is rounded up to the next
+         *      power of two.
+         */
+        explicit MpscQueue(size_t capacity) {
+            size_t roundedCapacity = 2;
+            while (roundedCapacity < capacity) {
+                roundedCapacity <<= 1;
+            }
+            cells_.reset(new Cell[roundedCapacity]);
+            mask_ = roundedCapacity - 1;
+            for (size_t i = 0; i < roundedCapacity; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            enqueuePosition_.store(0, std::memory_order_relaxed);
+            dequeuePosition_.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * This method moves the given element onto the end of the
+         * queue, if there is room for it.
+         *
+         * @param[in,out] element
+         *      This is the element to move onto the end of the queue.
+         *      It is left untouched if the queue is full.
+         *
+         * @return
+         *      An indication of whether or not the element was
+         *      placed in the queue is returned.
+         */
+        bool TryPush(T&& element) {
+            Cell* cell;
+            size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells_[position & mask_];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = (intptr_t)sequence - (intptr_t)position;
+                if (difference == 0) {
+                    if (
+                        enqueuePosition_.compare_exchange_weak(
+                            position,
+                            position + 1,
+                            std::memory_order_relaxed
+                        )
+                    ) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = enqueuePosition_.load(std::memory_order_relaxed);
+                }
+            }
+            cell->element = std::move(element);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * This method removes the element at the front of the queue,
+         * if there is one.
+         *
+         * @param[out] element
+         *      This is where to move the element removed from the queue.
+         *
+         * @return
+         *      An indication of whether or not an element was
+         *      removed from the queue is returned.
+         */
+        bool TryPop(T& element) {
+            Cell* cell;
+            size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells_[position & mask_];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = (intptr_t)sequence - (intptr_t)(position + 1);
+                if (difference == 0) {
+                    if (
+                        dequeuePosition_.compare_exchange_weak(
+                            position,
+                            position + 1,
+                            std::memory_order_relaxed
+                        )
+                    ) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = dequeuePosition_.load(std::memory_order_relaxed);
+                }
+            }
+            element = std::move(cell->element);
+            cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * This method returns the maximum number of elements
+         * the queue can hold.
+         *
+         * @return
+         *      The maximum number of elements the queue can hold
+         *      is returned.
+         */
+        size_t GetCapacity() const noexcept {
+            return mask_ + 1;
+        }
+
+        /**
+         * This method returns the number of elements currently
+         * held in the queue.
+         *
+         * @note
+         *      The value is only a snapshot, since other threads
+         *      may be pushing or popping elements at the same time.
+         *
+         * @return
+         *      The number of elements currently held in the queue
+         *      is returned.
+         */
+        size_t GetSize() const noexcept {
+            const size_t dequeuePosition = dequeuePosition_.load(std::memory_order_relaxed);
+            const size_t enqueuePosition = enqueuePosition_.load(std::memory_order_relaxed);
+            if (enqueuePosition <= dequeuePosition) {
+                return 0;
+            }
+            return enqueuePosition - dequeuePosition;
+        }
+
+        // Private properties
+    private:
+        /**
+         * This is one slot of the ring of elements.
+         */
+        struct Cell {
+            /**
+             * This tells whether the cell is ready to be filled
+             * by a producer, or ready to be drained by the consumer.
+             */
+            std::atomic< size_t > sequence;
+
+            /**
+             * This is the element held in the cell.
+             */
+            T element;
+        };
+
+        /**
+         * These are the slots of the ring of elements.
+         */
+        std::unique_ptr< Cell[] > cells_;
+
+        /**
+         * This is used to map ever-increasing positions onto
+         * cells of the ring.
+         */
+        size_t mask_ = 0;
+
+        /**
+         * This is the position at which the next element
+         * will be pushed.
+         */
+        std::atomic< size_t > enqueuePosition_;
+
+        /**
+         * This keeps the two positions on separate cache lines,
+         * so that producers and the consumer don't keep stealing
+         * the same line from each other.
+         */
+        char padding_[64];
+
+        /**
+         * This is the position from which the next element
+         * will be popped.
+         */
+        std::atomic< size_t > dequeuePosition_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_MPSC_QUEUE_HPP */
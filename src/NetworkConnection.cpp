@@ -81,6 +81,20 @@ namespace SystemUtils
         }
     }
 
+    void NetworkConnection::SetPacing(const PacingPolicy& policy) {
+        impl_->SetPacing(policy);
+    }
+
+    auto NetworkConnection::GetPacingStatistics() const -> PacingStatistics {
+        const auto pacerStatistics = impl_->pacer.GetStatistics(impl_->clock.GetTime());
+        PacingStatistics statistics;
+        statistics.bytesSent = pacerStatistics.bytesSent;
+        statistics.throttles = pacerStatistics.throttles;
+        statistics.throttledTime = pacerStatistics.throttledTime;
+        statistics.offloaded = impl_->pacingOffloaded;
+        return statistics;
+    }
+
     uint32_t NetworkConnection::GetAddressOfHost(const std::string& hostName) {
         return Impl::GetAddressOfHost(hostName);
     }
@@ -10,7 +10,11 @@
  * © 2024 by Hatem Nabli
 */
 
+#include "Pacer.hpp"
+
+#include <atomic>
 #include <SystemUtils/NetworkConnection.hpp>
+#include <SystemUtils/Time.hpp>
 
 
 namespace SystemUtils
@@ -89,6 +93,35 @@ namespace SystemUtils
         */
         DiagnosticsSender diagnosticsSender;
 
+        /**
+         * This is held for as long as the connection is open, if it
+         * was admitted by a network endpoint, so that the endpoint
+         * can count the connections it has open.
+         */
+        std::shared_ptr< void > admissionTicket;
+
+        /**
+         * This is used to measure time for pacing sent data.
+         */
+        Time clock;
+
+        /**
+         * This holds back sending to keep within the pacing policy,
+         * unless pacing is offloaded to the operating system.
+         */
+        Pacer pacer;
+
+        /**
+         * This is the pacing policy configured for the connection.
+         */
+        PacingPolicy pacingPolicy;
+
+        /**
+         * This indicates whether or not the operating
+         * system is pacing the data sent.
+         */
+        std::atomic< bool > pacingOffloaded{false};
+
         ~Impl() noexcept;
         Impl(const Impl&) = delete;
         Impl(Impl&&) noexcept = delete;
@@ -163,6 +196,21 @@ namespace SystemUtils
         */
         bool Close(CloseProcedure procedure);
 
+        /**
+         * This method configures the pacing of data sent over the
+         * connection, asking the operating system to do it if possible.
+         *
+         * @param[in] policy
+         *      This is the pacing policy to apply.
+         */
+        void SetPacing(const PacingPolicy& policy);
+
+        /**
+         * This method applies the configured pacing policy
+         * to the connection's socket.
+         */
+        void ApplyPacing();
+
         /**
          * This helper method is called from various places to standdarize
          * what the class does when is wants to immediately close
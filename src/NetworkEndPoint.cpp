@@ -10,6 +10,8 @@
 #include "NetworkEndPointImpl.hpp"
 #include <SystemUtils/NetworkEndPoint.hpp>
 
+#include <algorithm>
+
 namespace SystemUtils {
 
     NetworkEndPoint::~NetworkEndPoint() noexcept = default;
@@ -34,7 +36,36 @@ namespace SystemUtils {
         uint16_t port,
         const std::vector< uint8_t >& body
     ) {
-        impl_->SendPacket(address, port, body);
+        impl_->SendPacket(address, port, std::make_shared< const std::vector< uint8_t > >(body));
+    }
+
+    void NetworkEndPoint::SendPacket(
+        uint32_t address,
+        uint16_t port,
+        std::vector< uint8_t >&& body
+    ) {
+        impl_->SendPacket(address, port, std::make_shared< const std::vector< uint8_t > >(std::move(body)));
+    }
+
+    void NetworkEndPoint::SendPacket(
+        uint32_t address,
+        uint16_t port,
+        SharedBuffer body
+    ) {
+        impl_->SendPacket(address, port, std::move(body));
+    }
+
+    void NetworkEndPoint::SetSendQueueLimit(
+        size_t capacity,
+        SendQueueOverflowPolicy overflowPolicy
+    ) {
+        impl_->outputQueue.reset(new MpscQueue< Impl::Packet >(capacity));
+        impl_->sendQueueCapacity = capacity;
+        impl_->overflowPolicy = overflowPolicy;
+    }
+
+    uint64_t NetworkEndPoint::GetSendPacketsDropped() const {
+        return impl_->packetsDropped.load(std::memory_order_relaxed);
     }
 
     bool NetworkEndPoint::Open(
@@ -47,6 +78,8 @@ namespace SystemUtils {
     ) {
         impl_->newConnectionDelegate = networkConnectionDelegate;
         impl_->packetReceivedDelegate = packetReceivedDelegate;
+        impl_->sharedPacketReceivedDelegate = nullptr;
+        impl_->timestampedPacketReceivedDelegate = nullptr;
         impl_->mode = mode;
         impl_->localAddress = localAddress;
         impl_->groupAddress = groupAddress;
@@ -54,6 +87,133 @@ namespace SystemUtils {
         return impl_->Open();
     }
 
+    bool NetworkEndPoint::Open(
+        NetworkConnectionDelegate networkConnectionDelegate,
+        SharedPacketReceivedDelegate packetReceivedDelegate,
+        Mode mode,
+        uint32_t localAddress,
+        uint32_t groupAddress,
+        uint16_t port
+    ) {
+        impl_->newConnectionDelegate = networkConnectionDelegate;
+        impl_->packetReceivedDelegate = nullptr;
+        impl_->sharedPacketReceivedDelegate = packetReceivedDelegate;
+        impl_->timestampedPacketReceivedDelegate = nullptr;
+        impl_->mode = mode;
+        impl_->localAddress = localAddress;
+        impl_->groupAddress = groupAddress;
+        impl_->port = port;
+        return impl_->Open();
+    }
+
+    bool NetworkEndPoint::Open(
+        NetworkConnectionDelegate networkConnectionDelegate,
+        TimestampedPacketReceivedDelegate packetReceivedDelegate,
+        Mode mode,
+        uint32_t localAddress,
+        uint32_t groupAddress,
+        uint16_t port
+    ) {
+        impl_->newConnectionDelegate = networkConnectionDelegate;
+        impl_->packetReceivedDelegate = nullptr;
+        impl_->sharedPacketReceivedDelegate = nullptr;
+        impl_->timestampedPacketReceivedDelegate = packetReceivedDelegate;
+        impl_->mode = mode;
+        impl_->localAddress = localAddress;
+        impl_->groupAddress = groupAddress;
+        impl_->port = port;
+        return impl_->Open();
+    }
+
+    bool NetworkEndPoint::HandOff(
+        unsigned int processId,
+        double timeout
+    ) {
+        return impl_->HandOff(processId, timeout);
+    }
+
+    bool NetworkEndPoint::OpenFromExisting(
+        NetworkConnectionDelegate networkConnectionDelegate,
+        PacketReceivedDelegate packetReceivedDelegate,
+        double timeout
+    ) {
+        impl_->newConnectionDelegate = networkConnectionDelegate;
+        impl_->packetReceivedDelegate = packetReceivedDelegate;
+        impl_->sharedPacketReceivedDelegate = nullptr;
+        impl_->timestampedPacketReceivedDelegate = nullptr;
+        return impl_->OpenFromExisting(timeout);
+    }
+
+    std::vector< uint64_t > NetworkEndPoint::GetReceiveLatencyHistogram() const {
+        return impl_->receiveLatency.GetCounts();
+    }
+
+    void NetworkEndPoint::EnableLargeDatagrams(bool enable) {
+        impl_->largeDatagrams = enable;
+    }
+
+    uint64_t NetworkEndPoint::GetReceivePacketsTruncated() const {
+        return impl_->packetsTruncated.load(std::memory_order_relaxed);
+    }
+
+    void NetworkEndPoint::JoinGroup(const NetworkEndPointGroup& group) {
+        impl_->group = group.impl_;
+    }
+
+    void NetworkEndPoint::LeaveGroup() {
+        impl_->group = nullptr;
+    }
+
+    void NetworkEndPoint::SetBusyPoll(
+        double spinBudget,
+        int processorCore
+    ) {
+        impl_->busyPollBudget = spinBudget;
+        impl_->processorCore = processorCore;
+    }
+
+    auto NetworkEndPoint::GetBusyPollStatistics() const -> BusyPollStatistics {
+        std::lock_guard< decltype(impl_->busyPollStatisticsMutex) > lock(impl_->busyPollStatisticsMutex);
+        return impl_->busyPollStatistics;
+    }
+
+    void NetworkEndPoint::SetAdmissionPolicy(const AdmissionPolicy& policy) {
+        impl_->admissionController.SetPolicy(policy);
+    }
+
+    auto NetworkEndPoint::GetAdmissionStatistics() const -> AdmissionStatistics {
+        return impl_->admissionController.GetStatistics();
+    }
+
+    void NetworkEndPoint::EnableSessions(
+        NewSessionDelegate newSessionDelegate,
+        SessionClosedDelegate sessionClosedDelegate,
+        double idleTimeout
+    ) {
+        impl_->newSessionDelegate = newSessionDelegate;
+        impl_->sessionClosedDelegate = sessionClosedDelegate;
+        impl_->sessionIdleTimeout = idleTimeout;
+    }
+
+    size_t NetworkEndPoint::GetSessionCount() const {
+        std::lock_guard< decltype(impl_->sessionsMutex) > lock(impl_->sessionsMutex);
+        return impl_->sessions.GetSize();
+    }
+
+    void NetworkEndPoint::SetPacing(const PacingPolicy& policy) {
+        impl_->pacingEnabled = (policy.bytesPerSecond > 0.0);
+        impl_->pacer.SetRate(policy.bytesPerSecond, policy.burstBytes);
+    }
+
+    auto NetworkEndPoint::GetPacingStatistics() const -> PacingStatistics {
+        const auto pacerStatistics = impl_->pacer.GetStatistics(impl_->clock.GetTime());
+        PacingStatistics statistics;
+        statistics.bytesSent = pacerStatistics.bytesSent;
+        statistics.throttles = pacerStatistics.throttles;
+        statistics.throttledTime = pacerStatistics.throttledTime;
+        return statistics;
+    }
+
     uint16_t NetworkEndPoint::GetBoundPort() const {
         return impl_->port;
     }
@@ -65,4 +225,199 @@ namespace SystemUtils {
     std::vector< uint32_t > NetworkEndPoint::GetInterfaceAddresses() {
         return Impl::GetInterfaceAddresses();
     }
+
+    bool NetworkEndPoint::Impl::EnqueuePacket(Packet&& packet) {
+        for (;;) {
+            if (outputQueue->TryPush(std::move(packet))) {
+                return true;
+            }
+            if (overflowPolicy == SendQueueOverflowPolicy::DropNewest) {
+                (void)packetsDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            Packet oldestPacket;
+            if (outputQueue->TryPop(oldestPacket)) {
+                (void)packetsDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void NetworkEndPoint::Impl::ClearOutputQueue() {
+        Packet packet;
+        while (outputQueue->TryPop(packet)) {
+        }
+        nonSessionOutput.clear();
+        sessionsWithOutput.clear();
+        std::lock_guard< decltype(sessionsMutex) > lock(sessionsMutex);
+        sessions.Clear();
+    }
+
+    void NetworkEndPoint::Impl::SortOutput() {
+        Packet packet;
+        while (outputQueue->TryPop(packet)) {
+            const auto session = sessions.Find(packet.address, packet.port);
+            if (session == nullptr) {
+                if (nonSessionOutput.size() >= sendQueueCapacity) {
+                    (void)packetsDropped.fetch_add(1, std::memory_order_relaxed);
+                    if (overflowPolicy == SendQueueOverflowPolicy::DropNewest) {
+                        continue;
+                    }
+                    nonSessionOutput.pop_front();
+                }
+                nonSessionOutput.push_back(std::move(packet));
+                continue;
+            }
+            auto& sessionOutputQueue = (*session)->outputQueue;
+            if (sessionOutputQueue.size() >= sendQueueCapacity) {
+                (void)packetsDropped.fetch_add(1, std::memory_order_relaxed);
+                if (overflowPolicy == SendQueueOverflowPolicy::DropNewest) {
+                    continue;
+                }
+                sessionOutputQueue.pop_front();
+            }
+            if (sessionOutputQueue.empty()) {
+                sessionsWithOutput.push_back(*session);
+            }
+            sessionOutputQueue.push_back(std::move(packet.body));
+        }
+    }
+
+    bool NetworkEndPoint::Impl::TakeNextPacket() {
+        if (newSessionDelegate == nullptr) {
+            return outputQueue->TryPop(workerPacket);
+        }
+        SortOutput();
+
+        // Take turns between datagrams to peers without sessions
+        // and the session queues, so neither can starve the other.
+        sessionOutputFirst = !sessionOutputFirst;
+        if (
+            !sessionOutputFirst
+            && !nonSessionOutput.empty()
+        ) {
+            workerPacket = std::move(nonSessionOutput.front());
+            nonSessionOutput.pop_front();
+            return true;
+        }
+        if (!sessionsWithOutput.empty()) {
+            const auto session = std::move(sessionsWithOutput.front());
+            sessionsWithOutput.pop_front();
+            workerPacket.address = session->address;
+            workerPacket.port = session->port;
+            workerPacket.body = std::move(session->outputQueue.front());
+            session->outputQueue.pop_front();
+            session->lastActivity = clock.GetTime();
+            if (!session->outputQueue.empty()) {
+                sessionsWithOutput.push_back(session);
+            }
+            return true;
+        }
+        if (!nonSessionOutput.empty()) {
+            workerPacket = std::move(nonSessionOutput.front());
+            nonSessionOutput.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool NetworkEndPoint::Impl::HasMoreOutput() {
+        return (
+            (outputQueue->GetSize() > 0)
+            || !nonSessionOutput.empty()
+            || !sessionsWithOutput.empty()
+        );
+    }
+
+    void NetworkEndPoint::Impl::EndIdleSessions(double now) {
+        if (now < nextSessionSweep) {
+            return;
+        }
+        nextSessionSweep = now + sessionIdleTimeout / 2.0;
+        std::vector< std::shared_ptr< Session > > idleSessions;
+        {
+            std::lock_guard< decltype(sessionsMutex) > lock(sessionsMutex);
+            const auto idleSince = now - sessionIdleTimeout;
+            (void)sessions.EraseIf(
+                [idleSince, &idleSessions](
+                    uint32_t,
+                    uint16_t,
+                    const std::shared_ptr< Session >& session
+                ){
+                    if (
+                        (session->lastActivity >= idleSince)
+                        || !session->outputQueue.empty()
+                    ) {
+                        return false;
+                    }
+                    idleSessions.push_back(session);
+                    return true;
+                }
+            );
+        }
+        if (sessionClosedDelegate != nullptr) {
+            for (const auto& session: idleSessions) {
+                sessionClosedDelegate(session->address, session->port);
+            }
+        }
+    }
+
+    double NetworkEndPoint::Impl::GetWaitTime() {
+        auto waitTime = paceWait;
+        if (
+            (newSessionDelegate != nullptr)
+            && (sessionIdleTimeout > 0.0)
+        ) {
+            const auto sweepWait = std::max(0.001, nextSessionSweep - clock.GetTime());
+            if (
+                (waitTime <= 0.0)
+                || (sweepWait < waitTime)
+            ) {
+                waitTime = sweepWait;
+            }
+        }
+        return waitTime;
+    }
+
+    void NetworkEndPoint::Impl::DeliverPacket(
+        uint32_t address,
+        uint16_t port,
+        SharedBuffer body,
+        double receiveTime
+    ) {
+        if (newSessionDelegate != nullptr) {
+            const auto now = clock.GetTime();
+            // Only the worker thread changes the sessions, so it
+            // needn't hold the lock just to look one up.
+            std::shared_ptr< Session > session;
+            const auto existingSession = sessions.Find(address, port);
+            if (existingSession != nullptr) {
+                session = *existingSession;
+                session->lastActivity = now;
+            }
+            if (session == nullptr) {
+                const auto sessionDelegate = newSessionDelegate(address, port);
+                if (sessionDelegate != nullptr) {
+                    session = std::make_shared< Session >();
+                    session->address = address;
+                    session->port = port;
+                    session->packetReceivedDelegate = sessionDelegate;
+                    session->lastActivity = now;
+                    std::lock_guard< decltype(sessionsMutex) > lock(sessionsMutex);
+                    (void)sessions.Insert(address, port, session);
+                }
+            }
+            if (session != nullptr) {
+                session->packetReceivedDelegate(address, port, std::move(body));
+                return;
+            }
+        }
+        if (timestampedPacketReceivedDelegate != nullptr) {
+            receiveLatency.Record(clock.GetTime() - receiveTime);
+            timestampedPacketReceivedDelegate(address, port, std::move(body), receiveTime);
+        } else if (sharedPacketReceivedDelegate != nullptr) {
+            sharedPacketReceivedDelegate(address, port, std::move(body));
+        } else if (packetReceivedDelegate != nullptr) {
+            packetReceivedDelegate(address, port, *body);
+        }
+    }
 }
\ No newline at end of file
@@ -10,17 +10,86 @@
  * © 2024 by Hatem Nabli 
 */
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 #include <vector>
 
 #include <SystemUtils/DiagnosticsSender.hpp>
 #include <SystemUtils/NetworkEndPoint.hpp>
+#include <SystemUtils/NetworkEndPointGroup.hpp>
+#include <SystemUtils/Time.hpp>
+
+#include "AdmissionController.hpp"
+#include "BufferPool.hpp"
+#include "InterfaceAddressCache.hpp"
+#include "LatencyHistogram.hpp"
+#include "MpscQueue.hpp"
+#include "Pacer.hpp"
+#include "PeerTable.hpp"
 
 namespace SystemUtils {
 
 
     struct NetworkEndPoint::Impl {
+        // Types
+
+        /**
+         * This is used to hold all information about
+         * a datagram to be sent.
+         */
+        struct Packet {
+            /**
+             * This is the IPv4 address of the datagram recipient.
+             */
+            uint32_t address = 0;
+
+            /**
+             * This is the port number of the datagram recipient.
+             */
+            uint16_t port = 0;
+
+            /**
+             * This is the message to send in the datagram.
+             */
+            SharedBuffer body;
+        };
+
+        /**
+         * This holds everything the endpoint keeps
+         * for a session with one peer.
+         */
+        struct Session {
+            /**
+             * This is the IPv4 address of the peer.
+             */
+            uint32_t address = 0;
+
+            /**
+             * This is the port number of the peer.
+             */
+            uint16_t port = 0;
+
+            /**
+             * This is the function to call with each
+             * datagram received from the peer.
+             */
+            SharedPacketReceivedDelegate packetReceivedDelegate;
+
+            /**
+             * This holds datagrams waiting to be sent to the peer.
+             */
+            std::deque< SharedBuffer > outputQueue;
+
+            /**
+             * This is the time, in seconds, when a datagram was
+             * last sent to or received from the peer.
+             */
+            double lastActivity = 0.0;
+        };
+
         // Properties
 
         /**
@@ -42,6 +111,22 @@ namespace SystemUtils {
         */
         PacketReceivedDelegate packetReceivedDelegate;
 
+        /**
+         * This is the callback function to be called whenever
+         * a new datagram-oriented message is received by the
+         * network endpoint, if the owner wants to keep received
+         * messages without copying them.
+         */
+        SharedPacketReceivedDelegate sharedPacketReceivedDelegate;
+
+        /**
+         * This is the callback function to be called whenever
+         * a new datagram-oriented message is received by the
+         * network endpoint, if the owner wants to know when
+         * received messages arrived at the local host.
+         */
+        TimestampedPacketReceivedDelegate timestampedPacketReceivedDelegate;
+
         /**
          * This is the IPv4 address of the network interface
          * bound by this endpoint. If zero, then all network
@@ -72,6 +157,203 @@ namespace SystemUtils {
         */
         DiagnosticsSender diagnosticsSender;
 
+        /**
+         * This temporarily holds messages to be sent across the network
+         * by the worker thread. It is filled by the SendPacket method,
+         * from any number of threads, without locking.
+         */
+        std::unique_ptr< MpscQueue< Packet > > outputQueue;
+
+        /**
+         * This selects what to do when a datagram is sent
+         * while the output queue is full.
+         */
+        SendQueueOverflowPolicy overflowPolicy = SendQueueOverflowPolicy::DropNewest;
+
+        /**
+         * This counts the datagrams discarded because
+         * the output queue was full.
+         */
+        std::atomic< uint64_t > packetsDropped;
+
+        /**
+         * This is the number of datagrams each send queue can hold.
+         */
+        size_t sendQueueCapacity;
+
+        /**
+         * This is the function to call to start a session with a peer,
+         * or nullptr if the endpoint doesn't keep sessions.
+         */
+        NewSessionDelegate newSessionDelegate;
+
+        /**
+         * This is the function to call when a session
+         * ends for having been idle.
+         */
+        SessionClosedDelegate sessionClosedDelegate;
+
+        /**
+         * This is the time, in seconds, a session may be idle.
+         */
+        double sessionIdleTimeout = 0.0;
+
+        /**
+         * This is used to synchronize changes to the sessions made by
+         * the worker thread with other threads counting them.  The worker
+         * thread is the only one to change or look up sessions, so it
+         * doesn't need the lock just to look one up.
+         */
+        std::mutex sessionsMutex;
+
+        /**
+         * These are the sessions the endpoint has with peers.
+         */
+        PeerTable< std::shared_ptr< Session > > sessions;
+
+        /**
+         * These are the sessions with datagrams waiting to be sent,
+         * in the order in which they get to send their next one.
+         * Only the worker thread uses this.
+         */
+        std::deque< std::shared_ptr< Session > > sessionsWithOutput;
+
+        /**
+         * These are datagrams waiting to be sent to peers with which
+         * the endpoint has no session.  Only the worker thread uses this.
+         */
+        std::deque< Packet > nonSessionOutput;
+
+        /**
+         * This flag indicates whether or not the worker thread should
+         * look for the next datagram to send in the session queues
+         * before the queue of datagrams to peers without sessions.
+         */
+        bool sessionOutputFirst = false;
+
+        /**
+         * This is the time, in seconds, when the worker thread should
+         * next look for idle sessions to end.
+         */
+        double nextSessionSweep = 0.0;
+
+        /**
+         * This flag indicates whether or not the endpoint accepts
+         * datagrams larger than the path MTU of the local host.
+         */
+        bool largeDatagrams = false;
+
+        /**
+         * This hands out the buffers into which datagrams are received.
+         * It's set up when the endpoint is opened.
+         */
+        std::unique_ptr< BufferPool > receiveBufferPool;
+
+        /**
+         * This counts the datagrams discarded because they
+         * were larger than the receive buffer.
+         */
+        std::atomic< uint64_t > packetsTruncated;
+
+        /**
+         * This is used to end the endpoint's subscription to changes
+         * of the local network interface addresses, if it has one.
+         */
+        InterfaceAddressCache::UnsubscribeDelegate unsubscribeFromInterfaceChanges;
+
+        /**
+         * This flag is set when the local network interface addresses
+         * have changed, to tell the worker thread to check whether
+         * there are new interfaces on which to join the multicast group.
+         */
+        std::atomic< bool > interfacesChanged;
+
+        /**
+         * This decides which incoming connections are admitted.
+         */
+        AdmissionController admissionController;
+
+        /**
+         * This is used to measure the rate of incoming connections,
+         * and to pace outgoing datagrams.
+         */
+        Time clock;
+
+        /**
+         * This holds back sending of datagrams to keep
+         * within the pacing policy.
+         */
+        Pacer pacer;
+
+        /**
+         * This indicates whether or not a pacing policy is configured.
+         */
+        std::atomic< bool > pacingEnabled{false};
+
+        /**
+         * This is the time, in seconds, until the next datagram
+         * may be sent, if sending is being held back by the pacer,
+         * or zero if it isn't.
+         */
+        double paceWait = 0.0;
+
+        /**
+         * This counts the delays between datagrams being received by
+         * the operating system and being handed to the timestamped
+         * packet received delegate.
+         */
+        LatencyHistogram receiveLatency;
+
+        /**
+         * This is the longest time, in seconds, the worker thread keeps
+         * polling the socket after it goes idle, before blocking.
+         * If zero, the worker thread blocks as soon as it goes idle.
+         */
+        double busyPollBudget = 0.0;
+
+        /**
+         * This is the index of the processor core to which the worker
+         * thread is pinned, or -1 if it may run on any core.
+         */
+        int processorCore = -1;
+
+        /**
+         * This is used to synchronize access to the busy poll statistics.
+         */
+        std::mutex busyPollStatisticsMutex;
+
+        /**
+         * These are the counts of how the worker thread
+         * spent its time waiting for work.
+         */
+        BusyPollStatistics busyPollStatistics;
+
+        /**
+         * This is the group which is to do the endpoint's network
+         * processing, or null if the endpoint does its own.
+         */
+        std::shared_ptr< NetworkEndPointGroup::Impl > group;
+
+        /**
+         * This is where the worker thread receives datagrams.  It's
+         * kept at the receive buffer pool's buffer size, and each
+         * datagram is copied from it into a buffer from the pool just
+         * big enough to hold it, so that pooled buffers, once shrunk
+         * to fit one datagram, needn't be refilled for the next.
+         */
+        std::vector< uint8_t > workerReceiveBuffer;
+
+        /**
+         * This is the datagram the worker thread is trying to send.
+         */
+        Packet workerPacket;
+
+        /**
+         * This flag indicates whether or not the worker thread
+         * has a datagram it's trying to send.
+         */
+        bool workerPacketPending = false;
+
         // Lifecycle Management
         ~Impl() noexcept;
         Impl(const Impl&) = delete;
@@ -92,6 +374,53 @@ namespace SystemUtils {
         */
         bool Open();
 
+        /**
+         * This method prepares the events used in processing and starts
+         * processing on the endpoint's socket, either on its own worker
+         * thread or as a member of the endpoint's group.
+         *
+         * @return
+         *      An indication of whether or not processing
+         *      was started successfully is returned.
+         */
+        bool StartProcessing();
+
+        /**
+         * This method gives the endpoint's socket to the given process,
+         * which takes it with the OpenFromExisting method, and closes
+         * the endpoint once the other process has started processing.
+         *
+         * @param[in] processId
+         *      This is the identifier of the process taking the socket.
+         *
+         * @param[in] timeout
+         *      This is the longest time, in seconds, to wait
+         *      for the other process to take the socket.
+         *
+         * @return
+         *      An indication of whether or not the other process
+         *      took the socket is returned.  The endpoint is left
+         *      open if it didn't.
+         */
+        bool HandOff(
+            unsigned int processId,
+            double timeout
+        );
+
+        /**
+         * This method opens the endpoint with a socket handed off
+         * to this process by another process's HandOff method.
+         *
+         * @param[in] timeout
+         *      This is the longest time, in seconds, to wait
+         *      for the other process to hand off its socket.
+         *
+         * @return
+         *      An indication of whether or not the endpoint
+         *      was opened successfully is returned.
+         */
+        bool OpenFromExisting(double timeout);
+
         /**
          * This is the main function called for the worker thread
          * of the object. It support sending and receiving of messages,
@@ -116,9 +445,141 @@ namespace SystemUtils {
        void SendPacket(
             uint32_t address,
             uint16_t port,
-            const std::vector< uint8_t >& body
+            SharedBuffer body
        );
 
+        /**
+         * This method places the given datagram in the output queue,
+         * applying the overflow policy if the queue is full.
+         *
+         * @param[in] packet
+         *      This is the datagram to place in the output queue.
+         *
+         * @return
+         *      An indication of whether or not the given datagram
+         *      was placed in the output queue is returned.
+         */
+        bool EnqueuePacket(Packet&& packet);
+
+        /**
+         * This method moves the datagrams senders have put in the
+         * output queue into the queue of the session for each one's
+         * peer, or the queue of datagrams to peers without sessions.
+         * Senders only ever touch the lock-free output queue, and
+         * this is done on the worker thread, so sending doesn't
+         * take any lock even when the endpoint keeps sessions.
+         */
+        void SortOutput();
+
+        /**
+         * This method takes the next datagram to send, from either the
+         * output queue or the session queues, and holds it in the
+         * worker packet.
+         *
+         * @return
+         *      An indication of whether or not there
+         *      was a datagram to send is returned.
+         */
+        bool TakeNextPacket();
+
+        /**
+         * This method returns an indication of whether or not
+         * there are more datagrams waiting to be sent.
+         *
+         * @return
+         *      An indication of whether or not there are more
+         *      datagrams waiting to be sent is returned.
+         */
+        bool HasMoreOutput();
+
+        /**
+         * This method ends any sessions which have been idle for too
+         * long, if it's time to look for them.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         */
+        void EndIdleSessions(double now);
+
+        /**
+         * This method returns the longest time the worker thread
+         * may wait for network traffic before it has something to
+         * do regardless, such as sending a datagram held back by
+         * pacing or ending idle sessions.
+         *
+         * @return
+         *      The longest time, in seconds, the worker thread may wait
+         *      is returned, or zero if it may wait indefinitely.
+         */
+        double GetWaitTime();
+
+        /**
+         * This method does whatever network processing the endpoint
+         * has ready to be done without blocking: accepting one waiting
+         * connection, or receiving one waiting datagram, and sending
+         * one queued datagram.
+         *
+         * @note
+         *      The processing mutex must be held by the caller.
+         *
+         * @param[out] moreWork
+         *      This is set to indicate whether or not there may be
+         *      more processing ready to be done right away.
+         *
+         * @param[out] workDone
+         *      This is set to indicate whether or not any
+         *      network traffic was handled.
+         *
+         * @return
+         *      An indication of whether or not the endpoint is still
+         *      open is returned. It's closed if processing fails.
+         */
+        bool ProcessNetworkTraffic(
+            bool& moreWork,
+            bool& workDone
+        );
+
+        /**
+         * This method requests membership in the multicast group on each
+         * network interface of the local host on which the endpoint hasn't
+         * yet joined it.
+         *
+         * @return
+         *      An indication of whether or not the endpoint is now a member
+         *      of the multicast group on every interface is returned.
+         */
+        bool JoinMulticastGroup();
+
+        /**
+         * This method discards all datagrams waiting in the output
+         * queues, along with any sessions the endpoint has with peers.
+         */
+        void ClearOutputQueue();
+
+        /**
+         * This method hands a received datagram to whichever
+         * packet received delegate the owner provided.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the datagram sender.
+         *
+         * @param[in] port
+         *      This is the port number of the datagram sender.
+         *
+         * @param[in] body
+         *      This is the contents of the datagram.
+         *
+         * @param[in] receiveTime
+         *      This is the time, in seconds, on the same clock as
+         *      SystemUtils::Time::GetTime, when the datagram was received.
+         */
+        void DeliverPacket(
+            uint32_t address,
+            uint16_t port,
+            SharedBuffer body,
+            double receiveTime
+        );
+
         /**
          * This method is the opposite of the Open method. It stops
          * any and all network activity associated with the endpoint,
@@ -134,6 +595,9 @@ namespace SystemUtils {
          * This is a helper free function which determines the IPv4
          * addresses of all active network interfaces on the local 
          * host.
+         *
+         * The addresses are kept in a process-wide cache, which is
+         * only refreshed once the operating system reports a change.
          * 
          * @return
          *      The IPv4 addresses of all active network interfaces on
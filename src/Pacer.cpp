@@ -0,0 +1,74 @@
+/**
+ * @file Pacer.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::Pacer class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "Pacer.hpp"
+
+#include <algorithm>
+
+namespace SystemUtils {
+
+    void Pacer::SetRate(double bytesPerSecond, double burstBytes) {
+        std::lock_guard< decltype(mutex_) > lock(mutex_);
+        bucket_ = TokenBucket(bytesPerSecond, burstBytes);
+        throttledSince_ = -1.0;
+    }
+
+    bool Pacer::IsLimited() {
+        std::lock_guard< decltype(mutex_) > lock(mutex_);
+        return bucket_.IsLimited();
+    }
+
+    size_t Pacer::Allow(
+        double now,
+        size_t bytes,
+        bool whole,
+        double& wait
+    ) {
+        std::lock_guard< decltype(mutex_) > lock(mutex_);
+        if (!bucket_.IsLimited()) {
+            return bytes;
+        }
+        const auto needed = (whole ? (double)bytes : 1.0);
+        wait = bucket_.GetWaitTime(now, needed);
+        size_t allowed = 0;
+        if (wait <= 0.0) {
+            if (whole) {
+                allowed = bytes;
+            } else {
+                allowed = (size_t)std::min((double)bytes, bucket_.GetAvailable(now));
+            }
+        }
+        if (allowed == 0) {
+            if (throttledSince_ < 0.0) {
+                throttledSince_ = now;
+                ++statistics_.throttles;
+            }
+        } else if (throttledSince_ >= 0.0) {
+            statistics_.throttledTime += now - throttledSince_;
+            throttledSince_ = -1.0;
+        }
+        return allowed;
+    }
+
+    void Pacer::Consume(double now, size_t bytes) {
+        std::lock_guard< decltype(mutex_) > lock(mutex_);
+        bucket_.Take(now, (double)bytes);
+        statistics_.bytesSent += bytes;
+    }
+
+    auto Pacer::GetStatistics(double now) -> Statistics {
+        std::lock_guard< decltype(mutex_) > lock(mutex_);
+        auto statistics = statistics_;
+        if (throttledSince_ >= 0.0) {
+            statistics.throttledTime += std::max(0.0, now - throttledSince_);
+        }
+        return statistics;
+    }
+
+}
@@ -0,0 +1,168 @@
+#ifndef SYSTEM_UTILS_PACER_HPP
+#define SYSTEM_UTILS_PACER_HPP
+
+/**
+ * @file Pacer.hpp
+ *
+ * This module declares the SystemUtils::Pacer class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "TokenBucket.hpp"
+
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SystemUtils {
+
+    /**
+     * This class spreads out data sent over the network so that it
+     * doesn't exceed a configured number of bytes per second,
+     * apart from bursts of a configured size, and keeps track
+     * of how long sending was held back.
+     *
+     * The policy may be changed and the statistics read from
+     * any thread while another thread is sending.
+     */
+    class Pacer {
+        // Types
+    public:
+        /**
+         * This holds the statistics kept by the pacer.
+         */
+        struct Statistics {
+            /**
+             * This is the number of bytes sent.
+             */
+            uint64_t bytesSent = 0;
+
+            /**
+             * This is the number of times sending was held back.
+             */
+            uint64_t throttles = 0;
+
+            /**
+             * This is the total time, in seconds, that
+             * sending was held back.
+             */
+            double throttledTime = 0.0;
+        };
+
+        // Lifecycle management
+    public:
+        Pacer(const Pacer&) = delete;
+        Pacer& operator=(const Pacer&) = delete;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.  Initially the
+         * pacer doesn't hold back any sending.
+         */
+        Pacer() = default;
+
+        /**
+         * This method sets the rate at which data may be sent.
+         *
+         * @param[in] bytesPerSecond
+         *      This is the average number of bytes that may be sent
+         *      each second.  If zero, sending isn't held back at all.
+         *
+         * @param[in] burstBytes
+         *      This is the largest number of bytes that
+         *      may be sent at once.
+         */
+        void SetRate(double bytesPerSecond, double burstBytes);
+
+        /**
+         * This method returns an indication of whether or not
+         * the pacer holds back any sending at all.
+         *
+         * @return
+         *      An indication of whether or not the pacer
+         *      holds back any sending at all is returned.
+         */
+        bool IsLimited();
+
+        /**
+         * This method determines how much of the given amount of
+         * data may be sent right now.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @param[in] bytes
+         *      This is the number of bytes waiting to be sent.
+         *
+         * @param[in] whole
+         *      This indicates whether or not the data must be sent
+         *      all at once, as with a datagram. Data larger than the
+         *      burst size may then be sent once a full burst is allowed.
+         *
+         * @param[out] wait
+         *      If nothing may be sent right now, this is set to the
+         *      time, in seconds, until something may be sent.
+         *
+         * @return
+         *      The number of bytes which may be sent right now is returned.
+         *      This is either zero or, if whole is set, all of them.
+         */
+        size_t Allow(
+            double now,
+            size_t bytes,
+            bool whole,
+            double& wait
+        );
+
+        /**
+         * This method accounts for data which was sent.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @param[in] bytes
+         *      This is the number of bytes sent.
+         */
+        void Consume(double now, size_t bytes);
+
+        /**
+         * This method returns the statistics kept by the pacer.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds, used to include
+         *      any time sending is being held back right now.
+         *
+         * @return
+         *      The statistics kept by the pacer are returned.
+         */
+        Statistics GetStatistics(double now);
+
+        // Private properties
+    private:
+        /**
+         * This is used to synchronize access to the pacer.
+         */
+        std::mutex mutex_;
+
+        /**
+         * This is used to hold back sending.
+         */
+        TokenBucket bucket_;
+
+        /**
+         * These are the statistics kept by the pacer.
+         */
+        Statistics statistics_;
+
+        /**
+         * This is the time, in seconds, when sending was last held
+         * back, or a negative number if it isn't held back now.
+         */
+        double throttledSince_ = -1.0;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_PACER_HPP */
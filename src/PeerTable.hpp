@@ -0,0 +1,317 @@
+#ifndef SYSTEM_UTILS_PEER_TABLE_HPP
+#define SYSTEM_UTILS_PEER_TABLE_HPP
+
+/**
+ * @file PeerTable.hpp
+ *
+ * This module declares the SystemUtils::PeerTable class template.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This is a hash table of values kept for network peers, each
+     * identified by IPv4 address and port number, meant to be looked
+     * up for every datagram received.
+     *
+     * The table uses open addressing with linear probing, so a lookup
+     * touches one run of adjacent slots rather than chasing pointers,
+     * and removal shifts later entries back into the freed slot
+     * instead of leaving tombstones behind.
+     *
+     * @note
+     *      This class is not thread-safe; callers must
+     *      synchronize access to it.
+     *
+     * @tparam T
+     *      This is the type of value kept for each peer. It must be
+     *      default-constructible and move-assignable.
+     */
+    template< typename T > class PeerTable {
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] capacity
+         *      This is the number of peers the table should be able
+         *      to hold before it needs to grow.
+         */
+        explicit PeerTable(size_t capacity = 8) {
+            size_t slots = 16;
+            while (slots < capacity * 2) {
+                slots <<= 1;
+            }
+            slots_.resize(slots);
+        }
+
+        /**
+         * This method returns the number of peers in the table.
+         *
+         * @return
+         *      The number of peers in the table is returned.
+         */
+        size_t GetSize() const {
+            return size_;
+        }
+
+        /**
+         * This method looks up the value kept for the given peer.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer.
+         *
+         * @param[in] port
+         *      This is the port number of the peer.
+         *
+         * @return
+         *      A pointer to the value kept for the peer is returned,
+         *      or nullptr if the peer isn't in the table. The pointer
+         *      is only good until the table is next changed.
+         */
+        T* Find(uint32_t address, uint16_t port) {
+            const auto key = MakeKey(address, port);
+            const auto mask = slots_.size() - 1;
+            for (auto i = Hash(key) & mask;; i = (i + 1) & mask) {
+                auto& slot = slots_[i];
+                if (slot.key == key) {
+                    return &slot.value;
+                }
+                if (slot.key == EMPTY) {
+                    return nullptr;
+                }
+            }
+        }
+
+        /**
+         * This method sets the value kept for the given peer,
+         * adding the peer to the table if it isn't there already.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer.
+         *
+         * @param[in] port
+         *      This is the port number of the peer.
+         *
+         * @param[in] value
+         *      This is the value to keep for the peer.
+         *
+         * @return
+         *      A reference to the value kept for the peer is returned.
+         *      It is only good until the table is next changed.
+         */
+        T& Insert(uint32_t address, uint16_t port, T value) {
+            if ((size_ + 1) * 2 > slots_.size()) {
+                Grow();
+            }
+            const auto key = MakeKey(address, port);
+            const auto mask = slots_.size() - 1;
+            for (auto i = Hash(key) & mask;; i = (i + 1) & mask) {
+                auto& slot = slots_[i];
+                if (slot.key == EMPTY) {
+                    slot.key = key;
+                    ++size_;
+                }
+                if (slot.key == key) {
+                    slot.value = std::move(value);
+                    return slot.value;
+                }
+            }
+        }
+
+        /**
+         * This method removes the given peer from the table.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer.
+         *
+         * @param[in] port
+         *      This is the port number of the peer.
+         *
+         * @return
+         *      An indication of whether or not the peer
+         *      was in the table is returned.
+         */
+        bool Erase(uint32_t address, uint16_t port) {
+            const auto key = MakeKey(address, port);
+            const auto mask = slots_.size() - 1;
+            auto i = Hash(key) & mask;
+            for (;; i = (i + 1) & mask) {
+                if (slots_[i].key == key) {
+                    break;
+                }
+                if (slots_[i].key == EMPTY) {
+                    return false;
+                }
+            }
+
+            // Move back any later entry in the same run which
+            // would no longer be found once slot i is empty.
+            for (auto j = (i + 1) & mask; slots_[j].key != EMPTY; j = (j + 1) & mask) {
+                const auto home = Hash(slots_[j].key) & mask;
+                const bool reachable = (
+                    (i <= j)
+                    ? ((i < home) && (home <= j))
+                    : ((i < home) || (home <= j))
+                );
+                if (!reachable) {
+                    slots_[i].key = slots_[j].key;
+                    slots_[i].value = std::move(slots_[j].value);
+                    i = j;
+                }
+            }
+            slots_[i].key = EMPTY;
+            slots_[i].value = T();
+            --size_;
+            return true;
+        }
+
+        /**
+         * This method removes from the table every peer
+         * for which the given function returns true.
+         *
+         * @param[in] predicate
+         *      This is the function to call with the address, port,
+         *      and value of each peer in the table. It must not
+         *      change the table.
+         *
+         * @return
+         *      The number of peers removed is returned.
+         */
+        template< typename Predicate > size_t EraseIf(Predicate predicate) {
+            std::vector< uint64_t > keys;
+            for (auto& slot: slots_) {
+                if (
+                    (slot.key != EMPTY)
+                    && predicate((uint32_t)(slot.key >> 16), (uint16_t)slot.key, slot.value)
+                ) {
+                    keys.push_back(slot.key);
+                }
+            }
+            for (auto key: keys) {
+                (void)Erase((uint32_t)(key >> 16), (uint16_t)key);
+            }
+            return keys.size();
+        }
+
+        /**
+         * This method removes all peers from the table.
+         */
+        void Clear() {
+            for (auto& slot: slots_) {
+                slot.key = EMPTY;
+                slot.value = T();
+            }
+            size_ = 0;
+        }
+
+        // Private types
+    private:
+        /**
+         * This is one place in the table where a peer may be kept.
+         */
+        struct Slot {
+            /**
+             * This identifies the peer kept in the slot,
+             * or is EMPTY if the slot is free.
+             */
+            uint64_t key = EMPTY;
+
+            /**
+             * This is the value kept for the peer.
+             */
+            T value;
+        };
+
+        // Private constants
+    private:
+        /**
+         * This marks a slot as free.  No peer has this key,
+         * since keys only use the lower 48 bits.
+         */
+        static constexpr uint64_t EMPTY = ~(uint64_t)0;
+
+        // Private methods
+    private:
+        /**
+         * This function combines a peer's address and port
+         * into the key used to identify it in the table.
+         *
+         * @param[in] address
+         *      This is the IPv4 address of the peer.
+         *
+         * @param[in] port
+         *      This is the port number of the peer.
+         *
+         * @return
+         *      The key identifying the peer is returned.
+         */
+        static uint64_t MakeKey(uint32_t address, uint16_t port) {
+            return (((uint64_t)address << 16) | port);
+        }
+
+        /**
+         * This function scrambles the bits of a key, so that peers
+         * which differ only slightly, such as in their port numbers,
+         * are spread out across the table.
+         *
+         * @param[in] key
+         *      This is the key to scramble.
+         *
+         * @return
+         *      The scrambled key is returned.
+         */
+        static size_t Hash(uint64_t key) {
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            key ^= key >> 33;
+            key *= 0xC4CEB9FE1A85EC53ull;
+            key ^= key >> 33;
+            return (size_t)key;
+        }
+
+        /**
+         * This method doubles the number of slots in the table.
+         */
+        void Grow() {
+            std::vector< Slot > oldSlots(slots_.size() * 2);
+            oldSlots.swap(slots_);
+            size_ = 0;
+            for (auto& slot: oldSlots) {
+                if (slot.key != EMPTY) {
+                    (void)Insert(
+                        (uint32_t)(slot.key >> 16),
+                        (uint16_t)slot.key,
+                        std::move(slot.value)
+                    );
+                }
+            }
+        }
+
+        // Private properties
+    private:
+        /**
+         * These are the places in the table where peers may be kept.
+         * There are always a power of two of them, and at least
+         * half of them are free.
+         */
+        std::vector< Slot > slots_;
+
+        /**
+         * This is the number of peers in the table.
+         */
+        size_t size_ = 0;
+    };
+
+    template< typename T > constexpr uint64_t PeerTable< T >::EMPTY;
+
+}
+
+#endif /* SYSTEM_UTILS_PEER_TABLE_HPP */
@@ -0,0 +1,561 @@
+/**
+ * @file ResourceBundle.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::ResourceBundle class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <algorithm>
+#include <string.h>
+#include <SystemUtils/File.hpp>
+#include <SystemUtils/ResourceBundle.hpp>
+
+namespace {
+
+    /**
+     * These are the bytes at the start of every bundle.
+     */
+    constexpr char MAGIC[4] = {'S', 'U', 'R', 'B'};
+
+    /**
+     * This is the number of bytes in the header of a bundle.
+     */
+    constexpr size_t HEADER_SIZE = 16;
+
+    /**
+     * This is the number of bytes in each directory entry of a bundle.
+     */
+    constexpr size_t ENTRY_SIZE = 24;
+
+    /**
+     * This is the alignment of the contents of each resource
+     * within a bundle.
+     */
+    constexpr uint64_t CONTENTS_ALIGNMENT = 8;
+
+    /**
+     * This is the number of bytes copied at a time
+     * when packing a bundle.
+     */
+    constexpr size_t COPY_SIZE = 65536;
+
+    /**
+     * This describes where one resource is found in a bundle.
+     */
+    struct Entry {
+        /**
+         * This is the offset in the bundle of the resource's contents.
+         */
+        uint64_t contentsOffset = 0;
+
+        /**
+         * This is the number of bytes in the resource's contents.
+         */
+        uint64_t contentsSize = 0;
+
+        /**
+         * This is the offset in the bundle of the resource's name.
+         */
+        uint32_t nameOffset = 0;
+
+        /**
+         * This is the number of bytes in the resource's name.
+         */
+        uint32_t nameLength = 0;
+    };
+
+    /**
+     * This function reads a directory entry from a bundle.
+     *
+     * @param[in] data
+     *      This is where to fetch the directory entry.
+     *
+     * @return
+     *      The directory entry is returned.
+     */
+    Entry ReadEntry(const uint8_t* data) {
+        Entry entry;
+        (void)memcpy(&entry.contentsOffset, data, 8);
+        (void)memcpy(&entry.contentsSize, data + 8, 8);
+        (void)memcpy(&entry.nameOffset, data + 16, 4);
+        (void)memcpy(&entry.nameLength, data + 20, 4);
+        return entry;
+    }
+
+    /**
+     * This function writes a directory entry for a bundle.
+     *
+     * @param[in] entry
+     *      This is the directory entry to write.
+     *
+     * @param[out] data
+     *      This is where to store the directory entry.
+     */
+    void WriteEntry(const Entry& entry, uint8_t* data) {
+        (void)memcpy(data, &entry.contentsOffset, 8);
+        (void)memcpy(data + 8, &entry.contentsSize, 8);
+        (void)memcpy(data + 16, &entry.nameOffset, 4);
+        (void)memcpy(data + 20, &entry.nameLength, 4);
+    }
+
+    /**
+     * This is a read-only file whose contents are a resource held
+     * in a mapped bundle.  It keeps the bundle open and mapped for
+     * as long as it's around.
+     */
+    class ResourceFile
+        : public SystemUtils::IFile
+    {
+        // Properties
+    private:
+        /**
+         * This is the bundle file holding the resource.  It's held
+         * because closing it would unmap the view.
+         */
+        std::shared_ptr< SystemUtils::File > file_;
+
+        /**
+         * This is the mapped bundle holding the resource.
+         */
+        std::shared_ptr< SystemUtils::File::MappedView > view_;
+
+        /**
+         * This is the address of the first byte of the resource.
+         */
+        const uint8_t* data_;
+
+        /**
+         * This is the number of bytes in the resource.
+         */
+        size_t size_;
+
+        /**
+         * This is the current position in the resource.
+         */
+        uint64_t position_ = 0;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] file
+         *      This is the bundle file holding the resource.
+         *
+         * @param[in] view
+         *      This is the mapped bundle holding the resource.
+         *
+         * @param[in] data
+         *      This is the address of the first byte of the resource.
+         *
+         * @param[in] size
+         *      This is the number of bytes in the resource.
+         */
+        ResourceFile(
+            std::shared_ptr< SystemUtils::File > file,
+            std::shared_ptr< SystemUtils::File::MappedView > view,
+            const uint8_t* data,
+            size_t size
+        )
+            : file_(file)
+            , view_(view)
+            , data_(data)
+            , size_(size)
+        {
+        }
+
+        // SystemUtils::IFile
+    public:
+        virtual uint64_t GetSize() const override {
+            return size_;
+        }
+
+        virtual bool SetSize(uint64_t) override {
+            return false;
+        }
+
+        virtual uint64_t GetPosition() const override {
+            return position_;
+        }
+
+        virtual void SetPosition(uint64_t position) override {
+            position_ = position;
+        }
+
+        virtual size_t Peek(Buffer& buffer, size_t numBytes, size_t offset) const override {
+            if (numBytes == 0) {
+                numBytes = buffer.size();
+            }
+            if (numBytes == 0) {
+                return 0;
+            }
+            return Peek(&buffer[offset], numBytes);
+        }
+
+        virtual size_t Peek(void* buffer, size_t numBytes) const override {
+            return ReadAt(position_, buffer, numBytes);
+        }
+
+        virtual size_t Read(Buffer& buffer, size_t numBytes, size_t offset) override {
+            if (numBytes == 0) {
+                numBytes = buffer.size();
+            }
+            if (numBytes == 0) {
+                return 0;
+            }
+            return Read(&buffer[offset], numBytes);
+        }
+
+        virtual size_t Read(void* buffer, size_t numBytes) override {
+            const auto amountRead = ReadAt(position_, buffer, numBytes);
+            position_ += amountRead;
+            return amountRead;
+        }
+
+        virtual size_t Write(const Buffer&, size_t, size_t) override {
+            return 0;
+        }
+
+        virtual size_t Write(const void*, size_t) override {
+            return 0;
+        }
+
+        virtual size_t ReadAt(uint64_t offset, void* buffer, size_t numBytes) const override {
+            if (offset >= size_) {
+                return 0;
+            }
+            const auto amount = std::min(numBytes, size_ - (size_t)offset);
+            (void)memcpy(buffer, data_ + offset, amount);
+            return amount;
+        }
+
+        virtual size_t WriteAt(uint64_t, const void*, size_t) override {
+            return 0;
+        }
+
+        virtual size_t ReadV(const std::vector< ReadSegment >& segments) override {
+            const auto amountRead = ReadVAt(position_, segments);
+            position_ += amountRead;
+            return amountRead;
+        }
+
+        virtual size_t WriteV(const std::vector< WriteSegment >&) override {
+            return 0;
+        }
+
+        virtual size_t ReadVAt(uint64_t offset, const std::vector< ReadSegment >& segments) const override {
+            size_t total = 0;
+            for (const auto& segment: segments) {
+                const auto amountRead = ReadAt(offset + total, segment.buffer, segment.numBytes);
+                total += amountRead;
+                if (amountRead < segment.numBytes) {
+                    break;
+                }
+            }
+            return total;
+        }
+
+        virtual size_t WriteVAt(uint64_t, const std::vector< WriteSegment >&) override {
+            return 0;
+        }
+
+        virtual std::shared_ptr< IFile > Clone() override {
+            return std::make_shared< ResourceFile >(file_, view_, data_, size_);
+        }
+    };
+
+}
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of a ResourceBundle instance.
+     */
+    struct ResourceBundle::Impl {
+        // Properties
+
+        /**
+         * This is the bundle file.
+         */
+        std::shared_ptr< File > file;
+
+        /**
+         * This is the mapped bundle.
+         */
+        std::shared_ptr< File::MappedView > view;
+
+        /**
+         * This is the number of resources in the bundle.
+         */
+        uint32_t count = 0;
+
+        // Methods
+
+        /**
+         * This method returns the name of the resource
+         * with the given directory entry.
+         *
+         * @param[in] entry
+         *      This is the directory entry of the resource.
+         *
+         * @return
+         *      The name of the resource is returned.
+         */
+        std::string GetName(const Entry& entry) const {
+            return std::string(
+                (const char*)view->GetData() + entry.nameOffset,
+                entry.nameLength
+            );
+        }
+
+        /**
+         * This method returns the directory entry with the given index.
+         *
+         * @param[in] index
+         *      This is the index of the directory entry to return.
+         *
+         * @return
+         *      The directory entry is returned.
+         */
+        Entry GetEntry(size_t index) const {
+            return ReadEntry(view->GetData() + HEADER_SIZE + index * ENTRY_SIZE);
+        }
+
+        /**
+         * This method searches the directory for
+         * the resource with the given name.
+         *
+         * @param[in] name
+         *      This is the name of the resource to find.
+         *
+         * @param[out] entry
+         *      This is where to store the directory entry
+         *      of the resource, if found.
+         *
+         * @return
+         *      An indication of whether or not the
+         *      resource was found is returned.
+         */
+        bool Find(const std::string& name, Entry& entry) const {
+            if (view == nullptr) {
+                return false;
+            }
+            const auto data = view->GetData();
+            size_t low = 0;
+            size_t high = count;
+            while (low < high) {
+                const auto middle = low + (high - low) / 2;
+                const auto candidate = GetEntry(middle);
+                const auto commonLength = std::min((size_t)candidate.nameLength, name.length());
+                auto comparison = memcmp(data + candidate.nameOffset, name.data(), commonLength);
+                if (comparison == 0) {
+                    if (candidate.nameLength < name.length()) {
+                        comparison = -1;
+                    } else if (candidate.nameLength > name.length()) {
+                        comparison = 1;
+                    }
+                }
+                if (comparison == 0) {
+                    entry = candidate;
+                    return true;
+                } else if (comparison < 0) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * This method checks that the mapped file is a valid bundle,
+         * with everything in its directory lying within the file.
+         *
+         * @return
+         *      An indication of whether or not the mapped
+         *      file is a valid bundle is returned.
+         */
+        bool Validate() {
+            const auto data = view->GetData();
+            const auto size = (uint64_t)view->GetSize();
+            if (size < HEADER_SIZE) {
+                return false;
+            }
+            uint32_t version;
+            (void)memcpy(&version, data + 4, 4);
+            (void)memcpy(&count, data + 8, 4);
+            if (
+                (memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+                || (version != FORMAT_VERSION)
+                || (HEADER_SIZE + (uint64_t)count * ENTRY_SIZE > size)
+            ) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                const auto entry = GetEntry(i);
+                if (
+                    ((uint64_t)entry.nameOffset + entry.nameLength > size)
+                    || (entry.contentsOffset > size)
+                    || (entry.contentsSize > size - entry.contentsOffset)
+                ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    constexpr uint32_t ResourceBundle::FORMAT_VERSION;
+
+    ResourceBundle::~ResourceBundle() noexcept = default;
+    ResourceBundle::ResourceBundle(ResourceBundle&&) noexcept = default;
+    ResourceBundle& ResourceBundle::operator=(ResourceBundle&&) noexcept = default;
+
+    ResourceBundle::ResourceBundle()
+        : impl_(new Impl())
+    {
+    }
+
+    bool ResourceBundle::Open(const std::string& path) {
+        Close();
+        const auto file = std::make_shared< File >(path);
+        if (!file->OpenReadOnly()) {
+            return false;
+        }
+        const auto view = file->Map(0, 0, File::MapMode::ReadOnly);
+        if (view == nullptr) {
+            return false;
+        }
+        impl_->file = file;
+        impl_->view = view;
+        if (!impl_->Validate()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void ResourceBundle::Close() {
+        impl_->view.reset();
+        impl_->file.reset();
+        impl_->count = 0;
+    }
+
+    bool ResourceBundle::HasResource(const std::string& name) const {
+        Entry entry;
+        return impl_->Find(name, entry);
+    }
+
+    std::shared_ptr< IFile > ResourceBundle::GetResource(const std::string& name) const {
+        Entry entry;
+        if (!impl_->Find(name, entry)) {
+            return nullptr;
+        }
+        return std::make_shared< ResourceFile >(
+            impl_->file,
+            impl_->view,
+            impl_->view->GetData() + entry.contentsOffset,
+            (size_t)entry.contentsSize
+        );
+    }
+
+    std::vector< std::string > ResourceBundle::GetResourceNames() const {
+        std::vector< std::string > names;
+        if (impl_->view == nullptr) {
+            return names;
+        }
+        names.reserve(impl_->count);
+        for (size_t i = 0; i < impl_->count; ++i) {
+            names.push_back(impl_->GetName(impl_->GetEntry(i)));
+        }
+        return names;
+    }
+
+    bool ResourceBundle::Pack(
+        const std::map< std::string, std::string >& resources,
+        const std::string& bundlePath
+    ) {
+        // Lay out the header, directory, and names, which together
+        // make up the head of the bundle.  The map is already sorted
+        // by name, which is the order the directory needs.
+        const auto count = resources.size();
+        std::vector< uint8_t > head(HEADER_SIZE + count * ENTRY_SIZE);
+        (void)memcpy(head.data(), MAGIC, sizeof(MAGIC));
+        const auto version = FORMAT_VERSION;
+        const auto count32 = (uint32_t)count;
+        (void)memcpy(head.data() + 4, &version, 4);
+        (void)memcpy(head.data() + 8, &count32, 4);
+        std::vector< Entry > entries(count);
+        size_t index = 0;
+        for (const auto& resource: resources) {
+            entries[index].nameOffset = (uint32_t)head.size();
+            entries[index].nameLength = (uint32_t)resource.first.length();
+            (void)head.insert(head.end(), resource.first.begin(), resource.first.end());
+            ++index;
+        }
+
+        // Open every resource up front to learn its size,
+        // which is needed to lay out the directory.
+        std::vector< std::unique_ptr< File > > files;
+        uint64_t end = head.size();
+        index = 0;
+        for (const auto& resource: resources) {
+            std::unique_ptr< File > file(new File(resource.second));
+            if (!file->OpenReadOnly()) {
+                return false;
+            }
+            end = ((end + CONTENTS_ALIGNMENT - 1) / CONTENTS_ALIGNMENT) * CONTENTS_ALIGNMENT;
+            entries[index].contentsOffset = end;
+            entries[index].contentsSize = file->GetSize();
+            end += entries[index].contentsSize;
+            WriteEntry(entries[index], head.data() + HEADER_SIZE + index * ENTRY_SIZE);
+            files.push_back(std::move(file));
+            ++index;
+        }
+
+        // Write the head and then the contents of each resource.
+        File bundle(bundlePath);
+        if (
+            !bundle.OpenReadWrite()
+            || !bundle.SetSize(0)
+            || (bundle.WriteAt(0, head.data(), head.size()) != head.size())
+        ) {
+            return false;
+        }
+        std::vector< uint8_t > buffer(COPY_SIZE);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t copied = 0;
+            while (copied < entries[i].contentsSize) {
+                const auto amount = (size_t)std::min(
+                    (uint64_t)buffer.size(),
+                    entries[i].contentsSize - copied
+                );
+                if (
+                    (files[i]->ReadAt(copied, buffer.data(), amount) != amount)
+                    || (
+                        bundle.WriteAt(
+                            entries[i].contentsOffset + copied,
+                            buffer.data(),
+                            amount
+                        ) != amount
+                    )
+                ) {
+                    bundle.Destroy();
+                    return false;
+                }
+                copied += amount;
+            }
+        }
+
+        // Make sure the bundle ends at the end of the last resource,
+        // even if that resource is empty and lies past the names.
+        if (!bundle.SetSize(end)) {
+            bundle.Destroy();
+            return false;
+        }
+        return true;
+    }
+
+}
@@ -9,33 +9,152 @@
 #include <SystemUtils/StringFile.hpp>
 
 #include <algorithm>
-#include <deque>
+#include <string.h>
 #include <string>
+#include <vector>
 
 namespace SystemUtils {
 
     struct StringFile::Impl
     {
+        // Properties
+
+        /**
+         * This holds the contents of the file, starting at
+         * the head offset.  Bytes before the head have been
+         * removed from the front of the file, but not yet
+         * reclaimed.
+        */
+        std::vector< uint8_t > value;
+
         /**
-         * This is the contents of the file.
+         * This is the offset in the value of the first byte of the file.
         */
-        std::deque< uint8_t > value;
+        size_t head = 0;
 
         /**
         * This is the current position of the file.
         */
         size_t position = 0;
+
+        // Methods
+
+        /**
+         * This method returns the number of bytes in the file.
+         *
+         * @return
+         *      The number of bytes in the file is returned.
+        */
+        size_t Size() const {
+            return value.size() - head;
+        }
+
+        /**
+         * This method returns a pointer to the first byte of the file.
+         *
+         * @return
+         *      A pointer to the first byte of the file is returned.
+        */
+        uint8_t* Data() {
+            return value.data() + head;
+        }
+
+        /**
+         * This method returns a pointer to the first byte of the file.
+         *
+         * @return
+         *      A pointer to the first byte of the file is returned.
+        */
+        const uint8_t* Data() const {
+            return value.data() + head;
+        }
+
+        /**
+         * This method changes the number of bytes in the file.
+         *
+         * @param[in] size
+         *      This is the new number of bytes in the file.
+        */
+        void Resize(size_t size) {
+            value.resize(head + size);
+        }
+
+        /**
+         * This method replaces the contents of the file.
+         *
+         * @param[in] begin
+         *      This points to the first byte of the new contents.
+         *
+         * @param[in] end
+         *      This points just past the last byte of the new contents.
+        */
+        template< typename Iterator > void Assign(Iterator begin, Iterator end) {
+            value.assign(begin, end);
+            head = 0;
+        }
+
+        /**
+         * This method copies bytes out of the file.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first byte to copy.
+         *
+         * @param[out] buffer
+         *      This is where to put the bytes copied.
+         *
+         * @param[in] numBytes
+         *      This is the maximum number of bytes to copy.
+         *
+         * @return
+         *      The number of bytes copied is returned.  This is less
+         *      than requested if the end of the file is reached.
+        */
+        size_t CopyOut(uint64_t offset, void* buffer, size_t numBytes) const {
+            const auto size = Size();
+            if (offset >= size) {
+                return 0;
+            }
+            const auto amountCopied = std::min(numBytes, size - (size_t)offset);
+            if (amountCopied > 0) {
+                (void)memcpy(buffer, Data() + (size_t)offset, amountCopied);
+            }
+            return amountCopied;
+        }
+
+        /**
+         * This method copies bytes into the file,
+         * growing the file if necessary.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the first byte to write.
+         *
+         * @param[in] buffer
+         *      This is where to fetch the bytes to write.
+         *
+         * @param[in] numBytes
+         *      This is the number of bytes to write.
+        */
+        void CopyIn(uint64_t offset, const void* buffer, size_t numBytes) {
+            if (numBytes == 0) {
+                return;
+            }
+            const auto start = (size_t)offset;
+            if (start + numBytes > Size()) {
+                Resize(start + numBytes);
+            }
+            (void)memcpy(Data() + start, buffer, numBytes);
+        }
     };
 
     StringFile::StringFile(std::string initialValue)
         : impl_(new Impl())
     {
-        impl_->value.assign(initialValue.begin(), initialValue.end());
+        impl_->Assign(initialValue.begin(), initialValue.end());
     }
     StringFile::StringFile(std::vector< uint8_t > initialValue)
         : impl_(new Impl())
     {
-        impl_->value.assign(initialValue.begin(), initialValue.end());
+        impl_->value = std::move(initialValue);
     }
     StringFile::~StringFile() noexcept = default;
     StringFile::StringFile(const StringFile& other)
@@ -53,36 +172,55 @@ namespace SystemUtils {
     StringFile& StringFile::operator=(StringFile&&) noexcept = default;
 
     StringFile::operator std::string() const {
-        return std::string(impl_->value.begin(), impl_->value.end());
+        return std::string(
+            impl_->value.begin() + impl_->head,
+            impl_->value.end()
+        );
     }
 
     StringFile::operator std::vector< uint8_t >() const {
-        return std::vector< uint8_t >(impl_->value.begin(), impl_->value.end());
+        return std::vector< uint8_t >(
+            impl_->value.begin() + impl_->head,
+            impl_->value.end()
+        );
     }
 
     StringFile& StringFile::operator=(const std::string &b) {
-        impl_->value.assign(b.begin(), b.end());
+        impl_->Assign(b.begin(), b.end());
         impl_->position = 0;
         return *this;
     }
 
     StringFile& StringFile::operator=(const std::vector< uint8_t > &b) {
-        impl_->value.assign(b.begin(), b.end());
+        impl_->Assign(b.begin(), b.end());
         impl_->position = 0;
         return *this;
     }
 
     void StringFile::Remove(size_t numBytes) {
-        impl_->value.erase(impl_->value.begin(), impl_->value.begin() + std::min(numBytes, impl_->value.size()));
+        impl_->head += std::min(numBytes, impl_->Size());
         impl_->position = std::max(numBytes, impl_->position) - numBytes;
+
+        // Only reclaim the space of removed bytes once they make up
+        // at least half the storage, so that the cost of moving the
+        // remaining bytes down is paid for by the bytes removed.
+        if (impl_->head == impl_->value.size()) {
+            impl_->value.clear();
+            impl_->head = 0;
+        } else if (impl_->head >= impl_->value.size() / 2) {
+            const auto size = impl_->Size();
+            (void)memmove(impl_->value.data(), impl_->Data(), size);
+            impl_->value.resize(size);
+            impl_->head = 0;
+        }
     }
 
     uint64_t StringFile::GetSize() const {
-        return (uint16_t)impl_->value.size();
+        return (uint64_t)impl_->Size();
     }
 
     bool StringFile::SetSize(uint64_t size) {
-        impl_->value.resize((size_t)size);
+        impl_->Resize((size_t)size);
         return true;
     }
 
@@ -105,11 +243,7 @@ namespace SystemUtils {
     }
 
     size_t StringFile::Peek(void* buffer, size_t numBytes) const {
-        const size_t amountCopied = std::min(numBytes, impl_->value.size() - std::min(impl_->value.size(), impl_->position));
-        for (size_t i = 0; i < amountCopied; ++i) {
-            ((uint8_t*)buffer)[i] = impl_->value[impl_->position + i];
-        }
-        return amountCopied;
+        return impl_->CopyOut(impl_->position, buffer, numBytes);
     }
 
     size_t StringFile::Read(Buffer& buffer, size_t numBytes, size_t offset) {
@@ -123,10 +257,7 @@ namespace SystemUtils {
     }
 
     size_t StringFile::Read(void* buffer, size_t numBytes) {
-        const size_t amountCopied = std::min(numBytes, (impl_->value.size() - std::min(impl_->value.size(), impl_->position)));
-        for (size_t i = 0; i < amountCopied; ++i) {
-            ((uint8_t*)buffer)[i] = impl_->value[impl_->position + i];
-        }
+        const auto amountCopied = impl_->CopyOut(impl_->position, buffer, numBytes);
         impl_->position += amountCopied;
         return amountCopied;
     }
@@ -138,28 +269,71 @@ namespace SystemUtils {
         if (numBytes == 0) {
             return 0;
         }
-        if (impl_->position + numBytes > impl_->value.size()) {
-            impl_->value.resize(impl_->position + numBytes);
-        }
-        for (size_t i = 0; i < numBytes; ++i) {
-            impl_->value[impl_->position + i] = buffer[offset + i];
-        }
+        return Write(&buffer[offset], numBytes);
+    }
+
+    size_t StringFile::Write(const void* buffer, size_t numBytes) {
+        impl_->CopyIn(impl_->position, buffer, numBytes);
         impl_->position += numBytes;
         return numBytes;
     }
 
-    size_t StringFile::Write(const void* buffer, size_t numBytes) {
-        if (numBytes == 0) {
+    size_t StringFile::ReadAt(uint64_t offset, void* buffer, size_t numBytes) const {
+        return impl_->CopyOut(offset, buffer, numBytes);
+    }
+
+    size_t StringFile::WriteAt(uint64_t offset, const void* buffer, size_t numBytes) {
+        impl_->CopyIn(offset, buffer, numBytes);
+        return numBytes;
+    }
+
+    size_t StringFile::ReadV(const std::vector< ReadSegment >& segments) {
+        const auto amountRead = ReadVAt(impl_->position, segments);
+        impl_->position += amountRead;
+        return amountRead;
+    }
+
+    size_t StringFile::WriteV(const std::vector< WriteSegment >& segments) {
+        const auto amountWritten = WriteVAt(impl_->position, segments);
+        impl_->position += amountWritten;
+        return amountWritten;
+    }
+
+    size_t StringFile::ReadVAt(uint64_t offset, const std::vector< ReadSegment >& segments) const {
+        size_t total = 0;
+        for (const auto& segment: segments) {
+            const auto amountRead = impl_->CopyOut(offset + total, segment.buffer, segment.numBytes);
+            total += amountRead;
+            if (amountRead < segment.numBytes) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    size_t StringFile::WriteVAt(uint64_t offset, const std::vector< WriteSegment >& segments) {
+        size_t total = 0;
+        for (const auto& segment: segments) {
+            total += segment.numBytes;
+        }
+        if (total == 0) {
             return 0;
         }
-        if (impl_->position + numBytes > impl_->value.size()) {
-            impl_->value.resize(impl_->position + numBytes);
+
+        // Grow the file once for all the segments,
+        // rather than once per segment.
+        const auto start = (size_t)offset;
+        if (start + total > impl_->Size()) {
+            impl_->Resize(start + total);
         }
-        for (size_t i = 0; i < numBytes; ++i) {
-            impl_->value[impl_->position + i] = ((const uint8_t*)buffer)[i];
+        auto destination = impl_->Data() + start;
+        for (const auto& segment: segments) {
+            if (segment.numBytes > 0) {
+                (void)memcpy(destination, segment.buffer, segment.numBytes);
+                destination += segment.numBytes;
+            }
         }
-        impl_->position += numBytes;
-        return numBytes;
+        return total;
     }
 
     std::shared_ptr< IFile > StringFile::Clone() {
@@ -0,0 +1,76 @@
+/**
+ * @file TokenBucket.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::TokenBucket class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "TokenBucket.hpp"
+
+#include <algorithm>
+
+namespace SystemUtils {
+
+    TokenBucket::TokenBucket(double rate, double capacity)
+        : rate_(rate)
+        , capacity_(capacity)
+        , tokens_(capacity)
+    {
+    }
+
+    bool TokenBucket::IsLimited() const {
+        return (rate_ > 0.0);
+    }
+
+    bool TokenBucket::TryTake(double now, double tokens) {
+        if (!IsLimited()) {
+            return true;
+        }
+        Refill(now);
+        if (tokens_ < tokens) {
+            return false;
+        }
+        tokens_ -= tokens;
+        return true;
+    }
+
+    void TokenBucket::Take(double now, double tokens) {
+        if (!IsLimited()) {
+            return;
+        }
+        Refill(now);
+        tokens_ -= tokens;
+    }
+
+    double TokenBucket::GetAvailable(double now) {
+        Refill(now);
+        return tokens_;
+    }
+
+    double TokenBucket::GetWaitTime(double now, double tokens) {
+        if (!IsLimited()) {
+            return 0.0;
+        }
+        Refill(now);
+        const auto shortfall = std::min(tokens, capacity_) - tokens_;
+        if (shortfall <= 0.0) {
+            return 0.0;
+        }
+        return shortfall / rate_;
+    }
+
+    void TokenBucket::Refill(double now) {
+        if (
+            (lastRefill_ >= 0.0)
+            && (now > lastRefill_)
+        ) {
+            tokens_ = std::min(capacity_, tokens_ + (now - lastRefill_) * rate_);
+        }
+        if (now > lastRefill_) {
+            lastRefill_ = now;
+        }
+    }
+
+}
@@ -0,0 +1,149 @@
+#ifndef SYSTEM_UTILS_TOKEN_BUCKET_HPP
+#define SYSTEM_UTILS_TOKEN_BUCKET_HPP
+
+/**
+ * @file TokenBucket.hpp
+ *
+ * This module declares the SystemUtils::TokenBucket class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+namespace SystemUtils {
+
+    /**
+     * This class limits the rate at which something happens, while
+     * allowing short bursts, by handing out tokens which are
+     * replenished at a steady rate up to a fixed capacity.
+     *
+     * Time is given by the caller, in seconds from any fixed origin,
+     * so that the bucket may be driven by whichever clock suits.
+     *
+     * @note
+     *      This class is not thread-safe; callers must
+     *      synchronize access to it.
+     */
+    class TokenBucket {
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.
+         *
+         * @param[in] rate
+         *      This is the number of tokens added to the bucket
+         *      each second. If zero, the rate is not limited.
+         *
+         * @param[in] capacity
+         *      This is the maximum number of tokens the bucket holds,
+         *      which is the largest burst allowed. The bucket
+         *      starts out full.
+         */
+        TokenBucket(double rate = 0.0, double capacity = 1.0);
+
+        /**
+         * This method returns an indication of whether or not
+         * the bucket limits anything at all.
+         *
+         * @return
+         *      An indication of whether or not the bucket
+         *      limits anything at all is returned.
+         */
+        bool IsLimited() const;
+
+        /**
+         * This method takes the given number of tokens from the
+         * bucket, if it holds that many.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @param[in] tokens
+         *      This is the number of tokens to take.
+         *
+         * @return
+         *      An indication of whether or not the tokens
+         *      were taken is returned.
+         */
+        bool TryTake(double now, double tokens = 1.0);
+
+        /**
+         * This method takes the given number of tokens from the bucket
+         * even if it doesn't hold that many, leaving it in debt
+         * until enough tokens are added to repay it.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @param[in] tokens
+         *      This is the number of tokens to take.
+         */
+        void Take(double now, double tokens);
+
+        /**
+         * This method returns the number of tokens the bucket holds.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @return
+         *      The number of tokens the bucket holds is returned.
+         *      This is negative if the bucket is in debt.
+         */
+        double GetAvailable(double now);
+
+        /**
+         * This method returns how long it will be before the bucket
+         * holds the given number of tokens.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         *
+         * @param[in] tokens
+         *      This is the number of tokens wanted.  It's limited
+         *      to the capacity of the bucket.
+         *
+         * @return
+         *      The time, in seconds, until the bucket holds the
+         *      given number of tokens is returned.
+         */
+        double GetWaitTime(double now, double tokens);
+
+        // Private properties
+    private:
+        /**
+         * This is the number of tokens added to the bucket each second.
+         */
+        double rate_ = 0.0;
+
+        /**
+         * This is the maximum number of tokens the bucket holds.
+         */
+        double capacity_ = 1.0;
+
+        /**
+         * This is the number of tokens the bucket held at
+         * the time it was last refilled.
+         */
+        double tokens_ = 1.0;
+
+        /**
+         * This is the time, in seconds, when the bucket was last
+         * refilled, or a negative number if it never was.
+         */
+        double lastRefill_ = -1.0;
+
+        // Private methods
+    private:
+        /**
+         * This method adds the tokens accumulated since
+         * the bucket was last refilled.
+         *
+         * @param[in] now
+         *      This is the current time, in seconds.
+         */
+        void Refill(double now);
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_TOKEN_BUCKET_HPP */
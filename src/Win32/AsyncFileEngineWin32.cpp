@@ -0,0 +1,388 @@
+/**
+ * @file AsyncFileEngineWin32.cpp
+ *
+ * This module contains the Windows implementation of the
+ * SystemUtils::AsyncFileEngine class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+/**
+ * Windows.h should always be included first because other Windows header
+ * files, such as KnownFolders.h, don't always define things properly if
+ * we don't include Windows.h first.
+ */
+#include <Windows.h>
+
+#include "../FileImpl.hpp"
+#include "FileWin32.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <SystemUtils/AsyncFileEngine.hpp>
+#include <thread>
+
+namespace {
+
+    /**
+     * This is the completion key given for requests
+     * which were handed to the operating system.
+     */
+    constexpr ULONG_PTR COMPLETION_KEY_TRANSFER = 0;
+
+    /**
+     * This is the completion key given for requests which
+     * could not be started, and so failed right away.
+     */
+    constexpr ULONG_PTR COMPLETION_KEY_FAILED = 1;
+
+    /**
+     * This is the completion key posted to tell
+     * the worker thread to stop.
+     */
+    constexpr ULONG_PTR COMPLETION_KEY_STOP = 2;
+
+    /**
+     * This is the largest number of completions the worker
+     * thread takes from the completion port at once.
+     */
+    constexpr ULONG MAX_COMPLETIONS_PER_WAKE = 64;
+
+    /**
+     * This is the identifier to give the next engine made.
+     */
+    std::atomic< uint64_t > nextEngineId(1);
+
+}
+
+namespace SystemUtils {
+
+    /**
+     * This structure contains the private methods and properties of
+     * the AsyncFileEngine class.
+     */
+    struct AsyncFileEngine::Impl {
+        // Types
+
+        /**
+         * This holds a request which has been started, along with
+         * the operating system's record of its progress.
+         */
+        struct Transfer {
+            /**
+             * This is handed to the operating system with the
+             * request, and handed back when the request completes.
+             */
+            OVERLAPPED overlapped;
+
+            /**
+             * This is the operating-system handle to the file.
+             */
+            HANDLE handle = INVALID_HANDLE_VALUE;
+
+            /**
+             * This is the request being performed.
+             */
+            Request request;
+        };
+
+        // Properties
+
+        /**
+         * This is the I/O completion port to which the operating system
+         * reports the completion of requests handed to it.
+         */
+        HANDLE completionPort = NULL;
+
+        /**
+         * This identifies the engine among all engines ever made,
+         * so that files can tell which one they're served by.
+         */
+        uint64_t id = 0;
+
+        /**
+         * This is the thread which takes completions from the
+         * completion port and calls the requests' delegates.
+         */
+        std::thread worker;
+
+        /**
+         * This is the largest number of requests to have in flight at once.
+         */
+        size_t queueDepth = DEFAULT_QUEUE_DEPTH;
+
+        /**
+         * This is used to synchronize access to the state of the engine.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wait for all requests to complete.
+         */
+        std::condition_variable idleCondition;
+
+        /**
+         * These are the requests waiting for room in the queue.
+         */
+        std::deque< Request > waiting;
+
+        /**
+         * This is the number of requests handed to the
+         * operating system which haven't yet completed.
+         */
+        size_t inFlight = 0;
+
+        /**
+         * This is the number of requests submitted
+         * which haven't yet completed.
+         */
+        size_t outstanding = 0;
+
+        // Methods
+
+        /**
+         * This method starts the given request.  If the request can't
+         * be started, a completion is posted for it anyway, so that its
+         * delegate is always called from the worker thread.
+         *
+         * @param[in] request
+         *      This is the request to start.
+         *
+         * @note
+         *      The mutex must be held while calling this method.
+         */
+        void Start(Request&& request) {
+            ++inFlight;
+            auto transfer = new Transfer();
+            ZeroMemory(&transfer->overlapped, sizeof(transfer->overlapped));
+            transfer->overlapped.Offset = (DWORD)request.offset;
+            transfer->overlapped.OffsetHigh = (DWORD)(request.offset >> 32);
+            transfer->request = std::move(request);
+            const auto file = transfer->request.file;
+            const auto platform = (
+                (file == nullptr)
+                ? nullptr
+                : file->impl_->platform_.get()
+            );
+            if (
+                (platform == nullptr)
+                || (platform->handle == INVALID_HANDLE_VALUE)
+                || (transfer->request.numBytes > MAXDWORD)
+                || (
+                    (transfer->request.operation == Operation::Write)
+                    && !platform->writeAccess
+                )
+            ) {
+                (void)PostQueuedCompletionStatus(completionPort, 0, COMPLETION_KEY_FAILED, &transfer->overlapped);
+                return;
+            }
+            if (platform->asyncFileEngineId != id) {
+                if (platform->asyncFileEngineId != 0) {
+                    file->impl_->SetLastError(
+                        "file is already served by another asynchronous file engine"
+                    );
+                    (void)PostQueuedCompletionStatus(completionPort, 0, COMPLETION_KEY_FAILED, &transfer->overlapped);
+                    return;
+                }
+                if (CreateIoCompletionPort(platform->handle, completionPort, COMPLETION_KEY_TRANSFER, 0) == NULL) {
+                    file->impl_->SetLastError(
+                        "unable to associate file with completion port ("
+                        + std::to_string(::GetLastError())
+                        + ")"
+                    );
+                    (void)PostQueuedCompletionStatus(completionPort, 0, COMPLETION_KEY_FAILED, &transfer->overlapped);
+                    return;
+                }
+                platform->asyncFileEngineId = id;
+            }
+            transfer->handle = platform->handle;
+            const auto started = (
+                (transfer->request.operation == Operation::Write)
+                ? WriteFile(
+                    transfer->handle,
+                    transfer->request.buffer,
+                    (DWORD)transfer->request.numBytes,
+                    NULL,
+                    &transfer->overlapped
+                )
+                : ReadFile(
+                    transfer->handle,
+                    transfer->request.buffer,
+                    (DWORD)transfer->request.numBytes,
+                    NULL,
+                    &transfer->overlapped
+                )
+            );
+            if (
+                !started
+                && (GetLastError() != ERROR_IO_PENDING)
+            ) {
+                // Nothing is queued to the completion port for a request
+                // which fails right away, so post the completion here.
+                const auto key = (
+                    (GetLastError() == ERROR_HANDLE_EOF)
+                    ? COMPLETION_KEY_TRANSFER
+                    : COMPLETION_KEY_FAILED
+                );
+                transfer->handle = INVALID_HANDLE_VALUE;
+                (void)PostQueuedCompletionStatus(completionPort, 0, key, &transfer->overlapped);
+            }
+        }
+
+        /**
+         * This method starts waiting requests until either there are
+         * none left or the queue depth is reached.
+         *
+         * @note
+         *      The mutex must be held while calling this method.
+         */
+        void StartWaiting() {
+            while (
+                !waiting.empty()
+                && (inFlight < queueDepth)
+            ) {
+                auto request = std::move(waiting.front());
+                waiting.pop_front();
+                Start(std::move(request));
+            }
+        }
+
+        /**
+         * This method finishes a request which the worker
+         * thread took from the completion port.
+         *
+         * @param[in] transfer
+         *      This is the request which completed.
+         *
+         * @param[in] key
+         *      This is the completion key given for the request.
+         */
+        void Finish(Transfer* transfer, ULONG_PTR key) {
+            bool success = false;
+            DWORD amount = 0;
+            if (key == COMPLETION_KEY_TRANSFER) {
+                if (transfer->handle == INVALID_HANDLE_VALUE) {
+                    success = true;
+                } else if (GetOverlappedResult(transfer->handle, &transfer->overlapped, &amount, FALSE) == 0) {
+                    success = (GetLastError() == ERROR_HANDLE_EOF);
+                    amount = 0;
+                } else {
+                    success = true;
+                }
+            }
+            if (transfer->request.completionDelegate != nullptr) {
+                transfer->request.completionDelegate(success, (size_t)amount);
+            }
+            delete transfer;
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            --inFlight;
+            --outstanding;
+            StartWaiting();
+            if (outstanding == 0) {
+                idleCondition.notify_all();
+            }
+        }
+
+        /**
+         * This method is called as the body of the worker thread. It takes
+         * completions from the completion port, in batches, and finishes
+         * the requests which completed, until told to stop.
+         */
+        void Run() {
+            OVERLAPPED_ENTRY entries[MAX_COMPLETIONS_PER_WAKE];
+            for (;;) {
+                ULONG numEntries = 0;
+                if (
+                    GetQueuedCompletionStatusEx(
+                        completionPort,
+                        entries,
+                        MAX_COMPLETIONS_PER_WAKE,
+                        &numEntries,
+                        INFINITE,
+                        FALSE
+                    ) == 0
+                ) {
+                    return;
+                }
+                for (ULONG i = 0; i < numEntries; ++i) {
+                    if (entries[i].lpCompletionKey == COMPLETION_KEY_STOP) {
+                        return;
+                    }
+                    Finish(
+                        CONTAINING_RECORD(entries[i].lpOverlapped, Transfer, overlapped),
+                        entries[i].lpCompletionKey
+                    );
+                }
+            }
+        }
+    };
+
+    constexpr size_t AsyncFileEngine::DEFAULT_QUEUE_DEPTH;
+
+    AsyncFileEngine::~AsyncFileEngine() noexcept {
+        if (impl_ == nullptr) {
+            return;
+        }
+        if (impl_->worker.joinable()) {
+            WaitUntilIdle();
+            (void)PostQueuedCompletionStatus(impl_->completionPort, 0, COMPLETION_KEY_STOP, NULL);
+            impl_->worker.join();
+        }
+        if (impl_->completionPort != NULL) {
+            (void)CloseHandle(impl_->completionPort);
+        }
+    }
+    AsyncFileEngine::AsyncFileEngine(AsyncFileEngine&&) noexcept = default;
+    AsyncFileEngine& AsyncFileEngine::operator=(AsyncFileEngine&&) noexcept = default;
+
+    AsyncFileEngine::AsyncFileEngine(size_t queueDepth)
+        : impl_(new Impl())
+    {
+        impl_->queueDepth = ((queueDepth == 0) ? 1 : queueDepth);
+        impl_->id = nextEngineId++;
+        impl_->completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+        if (impl_->completionPort != NULL) {
+            impl_->worker = std::thread(&Impl::Run, impl_.get());
+        }
+    }
+
+    void AsyncFileEngine::Submit(Request request) {
+        std::vector< Request > requests;
+        requests.push_back(std::move(request));
+        Submit(std::move(requests));
+    }
+
+    void AsyncFileEngine::Submit(std::vector< Request > requests) {
+        if (impl_->completionPort == NULL) {
+            for (auto& request: requests) {
+                if (request.completionDelegate != nullptr) {
+                    request.completionDelegate(false, 0);
+                }
+            }
+            return;
+        }
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->outstanding += requests.size();
+        for (auto& request: requests) {
+            impl_->waiting.push_back(std::move(request));
+        }
+        impl_->StartWaiting();
+    }
+
+    size_t AsyncFileEngine::GetOutstandingCount() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->outstanding;
+    }
+
+    void AsyncFileEngine::WaitUntilIdle() {
+        std::unique_lock< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->idleCondition.wait(
+            lock,
+            [this]{ return (impl_->outstanding == 0); }
+        );
+    }
+
+}
@@ -0,0 +1,229 @@
+/**
+ * @file DirectoryIteratorWin32.cpp
+ *
+ * This module contains the Windows implementation of the
+ * SystemUtils::DirectoryIterator class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+/**
+ * Windows.h should always be included first because other Windows header
+ * files, such as KnownFolders.h, don't always define things properly if
+ * we don't include Windows.h first.
+ */
+#include <Windows.h>
+
+#include <SystemUtils/DirectoryIterator.hpp>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is the number of 100-nanosecond intervals between
+     * the Windows epoch (1601) and the Unix epoch (1970).
+     */
+    constexpr int64_t WINDOWS_TO_UNIX_EPOCH_TICKS = 116444736000000000LL;
+
+    /**
+     * This is the number of 100-nanosecond intervals in a second.
+     */
+    constexpr int64_t TICKS_PER_SECOND = 10000000LL;
+
+}
+
+namespace SystemUtils {
+
+    /**
+     * This structure contains the private methods and properties of
+     * the DirectoryIterator class.
+     */
+    struct DirectoryIterator::Impl {
+        // Properties
+
+        /**
+         * This is the operating-system handle to the directory.
+         */
+        HANDLE handle = INVALID_HANDLE_VALUE;
+
+        /**
+         * This is the path of the directory, ending in a separator,
+         * to which entry names are appended to make their paths.
+         */
+        std::string directoryWithSeparator;
+
+        /**
+         * This holds the current batch of entries fetched from the
+         * operating system.  It's made of 64-bit words so that the
+         * entries in it are suitably aligned.
+         */
+        std::vector< uint64_t > batch;
+
+        /**
+         * This is the offset, in bytes, into the current batch
+         * of the next entry to return.
+         */
+        size_t nextEntryOffset = 0;
+
+        /**
+         * This flag indicates whether or not the current batch
+         * has entries left in it.
+         */
+        bool batchHasEntries = false;
+
+        /**
+         * This flag indicates whether or not the next batch is the
+         * first one fetched since the directory was opened.
+         */
+        bool firstBatch = true;
+
+        // Methods
+
+        /**
+         * This method fetches the next batch of entries
+         * from the operating system.
+         *
+         * @return
+         *      An indication of whether or not any entries
+         *      were fetched is returned.
+         */
+        bool FetchBatch() {
+            if (handle == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            if (
+                GetFileInformationByHandleEx(
+                    handle,
+                    (firstBatch ? FileFullDirectoryRestartInfo : FileFullDirectoryInfo),
+                    batch.data(),
+                    (DWORD)(batch.size() * sizeof(uint64_t))
+                ) == 0
+            ) {
+                return false;
+            }
+            firstBatch = false;
+            nextEntryOffset = 0;
+            batchHasEntries = true;
+            return true;
+        }
+    };
+
+    DirectoryIterator::~DirectoryIterator() noexcept {
+        if (impl_ != nullptr) {
+            Close();
+        }
+    }
+    DirectoryIterator::DirectoryIterator(DirectoryIterator&&) noexcept = default;
+    DirectoryIterator& DirectoryIterator::operator=(DirectoryIterator&&) noexcept = default;
+
+    DirectoryIterator::DirectoryIterator(size_t batchBytes)
+        : impl_(new Impl())
+    {
+        // A batch must at least hold one entry with a long name.
+        const size_t minimumBatchBytes = sizeof(FILE_FULL_DIR_INFO) + MAX_PATH * sizeof(WCHAR);
+        if (batchBytes < minimumBatchBytes) {
+            batchBytes = minimumBatchBytes;
+        }
+        impl_->batch.resize((batchBytes + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    }
+
+    bool DirectoryIterator::Open(const std::string& directory) {
+        Close();
+        impl_->handle = CreateFileA(
+            directory.c_str(),
+            FILE_LIST_DIRECTORY,
+            FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS,
+            NULL
+        );
+        if (impl_->handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        impl_->directoryWithSeparator = directory;
+        if (
+            (directory.length() > 0)
+            && (directory[directory.length() - 1] != '\\')
+            && (directory[directory.length() - 1] != '/')
+        ) {
+            impl_->directoryWithSeparator += '/';
+        }
+        impl_->batchHasEntries = false;
+        impl_->firstBatch = true;
+        return true;
+    }
+
+    bool DirectoryIterator::Next(Entry& entry) {
+        for (;;) {
+            if (
+                !impl_->batchHasEntries
+                && !impl_->FetchBatch()
+            ) {
+                return false;
+            }
+            const auto info = (const FILE_FULL_DIR_INFO*)(
+                (const uint8_t*)impl_->batch.data() + impl_->nextEntryOffset
+            );
+            if (info->NextEntryOffset == 0) {
+                impl_->batchHasEntries = false;
+            } else {
+                impl_->nextEntryOffset += info->NextEntryOffset;
+            }
+            const auto nameLength = (int)(info->FileNameLength / sizeof(WCHAR));
+            if (
+                (
+                    (nameLength == 1)
+                    && (info->FileName[0] == L'.')
+                )
+                || (
+                    (nameLength == 2)
+                    && (info->FileName[0] == L'.')
+                    && (info->FileName[1] == L'.')
+                )
+            ) {
+                continue;
+            }
+
+            // Names are converted to the ANSI code page, to match the
+            // paths used by the rest of the file system functions.
+            const auto nameBytes = WideCharToMultiByte(CP_ACP, 0, info->FileName, nameLength, NULL, 0, NULL, NULL);
+            entry.name.resize((size_t)nameBytes);
+            if (nameBytes > 0) {
+                (void)WideCharToMultiByte(CP_ACP, 0, info->FileName, nameLength, &entry.name[0], nameBytes, NULL, NULL);
+            }
+            entry.path = impl_->directoryWithSeparator + entry.name;
+
+            // For a reparse point, the reparse tag
+            // is given in place of the EA size.
+            if (
+                ((info->FileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0)
+                && (
+                    (info->EaSize == IO_REPARSE_TAG_SYMLINK)
+                    || (info->EaSize == IO_REPARSE_TAG_MOUNT_POINT)
+                )
+            ) {
+                entry.type = EntryType::SymbolicLink;
+            } else if ((info->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+                entry.type = EntryType::Directory;
+            } else {
+                entry.type = EntryType::File;
+            }
+            entry.size = (uint64_t)info->EndOfFile.QuadPart;
+            entry.lastModifiedTime = (time_t)(
+                (info->LastWriteTime.QuadPart - WINDOWS_TO_UNIX_EPOCH_TICKS)
+                / TICKS_PER_SECOND
+            );
+            return true;
+        }
+    }
+
+    void DirectoryIterator::Close() {
+        if (impl_->handle != INVALID_HANDLE_VALUE) {
+            (void)CloseHandle(impl_->handle);
+            impl_->handle = INVALID_HANDLE_VALUE;
+        }
+        impl_->batchHasEntries = false;
+    }
+
+}
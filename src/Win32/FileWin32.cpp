@@ -15,24 +15,34 @@
 */
 #include <Windows.h>
 #undef CreateDirectory
+#include <winternl.h>
 
 
 #include "../FileImpl.hpp"
+#include "FileWin32.hpp"
+#include "../WorkerPool.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <io.h>
 #include <KnownFolders.h>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <ShlObj.h>
 #include <Shlwapi.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include <StringUtils/StringUtils.hpp>
 #include <SystemUtils/File.hpp>
+#include <thread>
+#include <vector>
 
 // ensure we link with Windows shell utility libraries.
 #pragma comment(lib, "Shlwapi")
 #pragma comment(lib, "Shell32")
+#pragma comment(lib, "ntdll")
 
 namespace {
     std::string FixPathDelimiters(const std::string& in) {
@@ -46,29 +56,1139 @@ namespace {
         }
         return out;
     }
+
+    /**
+     * This is the largest number of bytes collected in a staging
+     * buffer so that several small pieces of a scatter/gather
+     * transfer can be made with a single read or write.  Pieces
+     * at least this large are transferred on their own.
+     */
+    constexpr size_t STAGING_SIZE = 65536;
+
+    /**
+     * This function returns the buffer the calling thread uses to
+     * collect small pieces of a scatter/gather transfer, so that
+     * they can be made with a single read or write.
+     *
+     * @return
+     *      The calling thread's staging buffer is returned.
+     */
+    std::vector< uint8_t >& GetStagingBuffer() {
+        thread_local std::vector< uint8_t > staging(STAGING_SIZE);
+        return staging;
+    }
+
+    /**
+     * This function returns the flags and attributes
+     * with which to open files.
+     *
+     * @param[in] directIo
+     *      This indicates whether or not the file is to be
+     *      read and written directly, bypassing the file cache.
+     *
+     * @param[in] accessFlags
+     *      These are the flags telling the file cache how
+     *      the file is expected to be accessed.
+     *
+     * @return
+     *      The flags and attributes with which to
+     *      open the file are returned.
+     */
+    DWORD GetOpenFlags(bool directIo, DWORD accessFlags = 0) {
+        DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | accessFlags;
+        if (directIo) {
+            flags |= FILE_FLAG_NO_BUFFERING;
+        }
+        return flags;
+    }
+
+    /**
+     * This function returns the flags which tell the file cache
+     * to expect the file to be accessed in the given way.
+     *
+     * @param[in] hint
+     *      This is the way in which the file is expected
+     *      to be accessed.
+     *
+     * @return
+     *      The flags which tell the file cache to expect the file
+     *      to be accessed in the given way are returned.
+     */
+    DWORD GetAccessFlags(SystemUtils::File::AccessHint hint) {
+        switch (hint) {
+            case SystemUtils::File::AccessHint::Sequential: {
+                return FILE_FLAG_SEQUENTIAL_SCAN;
+            }
+
+            case SystemUtils::File::AccessHint::Random: {
+                return FILE_FLAG_RANDOM_ACCESS;
+            }
+
+            default: {
+                return 0;
+            }
+        }
+    }
+
+    /**
+     * This function determines the size of the blocks to which
+     * reads and writes of the given file must be aligned when
+     * bypassing the file cache.
+     *
+     * @param[in] handle
+     *      This is the operating-system handle to the file.
+     *
+     * @return
+     *      The size of the blocks to which direct reads and
+     *      writes of the file must be aligned is returned.
+     */
+    size_t QueryBlockSize(HANDLE handle) {
+        FILE_STORAGE_INFO storageInfo;
+        if (
+            GetFileInformationByHandleEx(
+                handle,
+                FileStorageInfo,
+                &storageInfo,
+                sizeof(storageInfo)
+            ) == 0
+        ) {
+            return SystemUtils::AlignedBuffer::DEFAULT_ALIGNMENT;
+        }
+
+        // Devices emulating small sectors on top of larger ones
+        // only perform well with transfers aligned to the larger
+        // ones, so go by whichever is larger.
+        return std::max(
+            (size_t)storageInfo.LogicalBytesPerSector,
+            (size_t)storageInfo.PhysicalBytesPerSectorForPerformance
+        );
+    }
+
+    /**
+     * This is the largest number of bytes transferred by
+     * a single call to ReadFile or WriteFile.
+     */
+    constexpr size_t MAX_TRANSFER_CHUNK = 0x40000000;
+
+    /**
+     * This holds an event owned by one thread, used to wait for
+     * its reads and writes of files to complete.
+     */
+    struct ThreadEvent {
+        HANDLE handle = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+        ~ThreadEvent() noexcept {
+            if (handle != NULL) {
+                (void)CloseHandle(handle);
+            }
+        }
+    };
+
+    /**
+     * This function returns the event the calling thread
+     * uses to wait for its reads and writes of files to complete.
+     *
+     * @return
+     *      The event the calling thread uses to wait for its
+     *      reads and writes of files to complete is returned.
+     */
+    HANDLE GetThreadEvent() {
+        static thread_local ThreadEvent threadEvent;
+        return threadEvent.handle;
+    }
+
+    /**
+     * This function reads or writes a region of a file opened for
+     * overlapped I/O, starting at the given offset, and waits for the
+     * transfer to complete.
+     *
+     * @param[in] handle
+     *      This is the operating-system handle to the file.
+     *
+     * @param[in] write
+     *      This indicates whether to write (true) or read (false).
+     *
+     * @param[in] offset
+     *      This is the offset from the start of the file
+     *      to the first byte to transfer.
+     *
+     * @param[in] buffer
+     *      This is where to put or fetch the bytes transferred.
+     *
+     * @param[in] numBytes
+     *      This is the number of bytes to transfer.
+     *
+     * @return
+     *      The number of bytes actually transferred is returned.
+     */
+    size_t TransferAt(
+        HANDLE handle,
+        bool write,
+        uint64_t offset,
+        void* buffer,
+        size_t numBytes
+    ) {
+        const auto event = GetThreadEvent();
+        if (
+            (handle == INVALID_HANDLE_VALUE)
+            || (event == NULL)
+        ) {
+            return 0;
+        }
+        size_t total = 0;
+        while (total < numBytes) {
+            const auto chunk = (DWORD)std::min(numBytes - total, MAX_TRANSFER_CHUNK);
+            const auto position = offset + total;
+            OVERLAPPED overlapped;
+            ZeroMemory(&overlapped, sizeof(overlapped));
+            overlapped.Offset = (DWORD)position;
+            overlapped.OffsetHigh = (DWORD)(position >> 32);
+            // Setting the low bit of the event handle keeps the
+            // completion from also being queued to any completion
+            // port the file is associated with.
+            overlapped.hEvent = (HANDLE)((ULONG_PTR)event | 1);
+            const auto started = (
+                write
+                ? WriteFile(handle, (const uint8_t*)buffer + total, chunk, NULL, &overlapped)
+                : ReadFile(handle, (uint8_t*)buffer + total, chunk, NULL, &overlapped)
+            );
+            if (
+                !started
+                && (GetLastError() != ERROR_IO_PENDING)
+            ) {
+                break;
+            }
+            DWORD amount = 0;
+            if (GetOverlappedResult(handle, &overlapped, &amount, TRUE) == 0) {
+                break;
+            }
+            total += amount;
+            if (amount < chunk) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    /**
+     * This holds the state shared by all the tasks
+     * carrying out one directory copy.
+     */
+    struct DirectoryCopy {
+        /**
+         * This is the pool of threads doing the copy.
+         */
+        SystemUtils::WorkerPool& pool;
+
+        /**
+         * This indicates whether or not to skip copying files
+         * which already exist at the destination unchanged.
+         */
+        bool skipUnchanged = false;
+
+        /**
+         * This is called after each file is copied or skipped.
+         */
+        SystemUtils::File::CopyProgressDelegate progressDelegate;
+
+        /**
+         * This is used to synchronize access to the progress,
+         * and to calls to the progress delegate.
+         */
+        std::mutex progressMutex;
+
+        /**
+         * This is the progress made so far.
+         */
+        SystemUtils::File::CopyProgress progress;
+
+        /**
+         * This flag is set if anything fails to be copied,
+         * after which the remaining tasks give up.
+         */
+        std::atomic< bool > failed;
+
+        explicit DirectoryCopy(SystemUtils::WorkerPool& pool)
+            : pool(pool)
+            , failed(false)
+        {
+        }
+    };
+
+    /**
+     * This holds what's needed to copy one directory.
+     */
+    struct DirectoryCopyNode {
+        /**
+         * This is the path of the directory to copy,
+         * ending in a separator.
+         */
+        std::string source;
+
+        /**
+         * This is the path of the copy of the directory,
+         * ending in a separator.
+         */
+        std::string destination;
+
+        /**
+         * This is the directory containing this one, if it's
+         * also being copied.
+         */
+        std::shared_ptr< DirectoryCopyNode > parent;
+
+        /**
+         * This is the number of tasks copying this directory or
+         * anything in it which haven't yet finished, counting the
+         * task which lists the directory.
+         */
+        std::atomic< size_t > pending;
+
+        /**
+         * This indicates whether or not the attributes and times of the
+         * directory are known, to be given to the copy when it's done.
+         */
+        bool hasMetadata = false;
+
+        /**
+         * These are the attributes of the directory.
+         */
+        DWORD attributes = 0;
+
+        /**
+         * This is when the directory was created.
+         */
+        FILETIME creationTime;
+
+        /**
+         * This is when the directory was last accessed.
+         */
+        FILETIME lastAccessTime;
+
+        /**
+         * This is when the directory was last modified.
+         */
+        FILETIME lastWriteTime;
+
+        DirectoryCopyNode()
+            : pending(1)
+        {
+        }
+    };
+
+    /**
+     * This function is called when a task copying a directory, or
+     * something in it, finishes.  Once everything in the directory
+     * has been copied, the copy is given the attributes and times of
+     * the directory (since adding files to it changes its times), and
+     * the directory containing it is told in turn.
+     *
+     * @param[in] node
+     *      This represents the directory whose task finished.
+     */
+    void FinishDirectoryNode(std::shared_ptr< DirectoryCopyNode > node) {
+        while (
+            (node != nullptr)
+            && (--node->pending == 0)
+        ) {
+            if (node->hasMetadata) {
+                const auto handle = CreateFileA(
+                    node->destination.c_str(),
+                    FILE_WRITE_ATTRIBUTES,
+                    FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+                    NULL,
+                    OPEN_EXISTING,
+                    FILE_FLAG_BACKUP_SEMANTICS,
+                    NULL
+                );
+                if (handle != INVALID_HANDLE_VALUE) {
+                    (void)SetFileTime(handle, &node->creationTime, &node->lastAccessTime, &node->lastWriteTime);
+                    (void)CloseHandle(handle);
+                }
+                (void)SetFileAttributesA(
+                    node->destination.c_str(),
+                    node->attributes & (
+                        FILE_ATTRIBUTE_ARCHIVE
+                        | FILE_ATTRIBUTE_HIDDEN
+                        | FILE_ATTRIBUTE_NOT_CONTENT_INDEXED
+                        | FILE_ATTRIBUTE_READONLY
+                        | FILE_ATTRIBUTE_SYSTEM
+                    )
+                );
+            }
+            node = node->parent;
+        }
+    }
+
+    /**
+     * This function copies one file, unless it's to be skipped
+     * because it's already at the destination unchanged.
+     *
+     * @param[in] copy
+     *      This is the state of the directory copy.
+     *
+     * @param[in] source
+     *      This is the path of the file to copy.
+     *
+     * @param[in] destination
+     *      This is the path of the copy of the file.
+     *
+     * @param[in] sourceData
+     *      This describes the file to copy, as listed in its directory.
+     */
+    void CopyOneFile(
+        DirectoryCopy& copy,
+        const std::string& source,
+        const std::string& destination,
+        const WIN32_FIND_DATAA& sourceData
+    ) {
+        if (copy.failed) {
+            return;
+        }
+        bool skipped = false;
+        if (copy.skipUnchanged) {
+            WIN32_FILE_ATTRIBUTE_DATA destinationData;
+            skipped = (
+                (GetFileAttributesExA(destination.c_str(), GetFileExInfoStandard, &destinationData) != 0)
+                && (destinationData.nFileSizeHigh == sourceData.nFileSizeHigh)
+                && (destinationData.nFileSizeLow == sourceData.nFileSizeLow)
+                && (CompareFileTime(&destinationData.ftLastWriteTime, &sourceData.ftLastWriteTime) == 0)
+            );
+        }
+        if (!skipped) {
+            // CopyFileEx moves the data within the operating system,
+            // and hands the copy off to the file system or server
+            // (block cloning, or offloaded copies) where it can.
+            if (CopyFileExA(source.c_str(), destination.c_str(), NULL, NULL, NULL, 0) == 0) {
+                copy.failed = true;
+                return;
+            }
+        }
+        std::lock_guard< decltype(copy.progressMutex) > lock(copy.progressMutex);
+        if (skipped) {
+            ++copy.progress.filesSkipped;
+        } else {
+            ++copy.progress.filesCopied;
+            copy.progress.bytesCopied += (
+                ((uint64_t)sourceData.nFileSizeHigh << 32)
+                | sourceData.nFileSizeLow
+            );
+        }
+        if (copy.progressDelegate != nullptr) {
+            copy.progressDelegate(copy.progress);
+        }
+    }
+
+    /**
+     * This function creates the copy of a directory, and posts tasks
+     * to copy each file and subdirectory in it.
+     *
+     * @param[in] copy
+     *      This is the state of the directory copy.
+     *
+     * @param[in] node
+     *      This represents the directory to copy.
+     */
+    void CopyDirectoryNode(
+        DirectoryCopy& copy,
+        std::shared_ptr< DirectoryCopyNode > node
+    ) {
+        if (
+            !copy.failed
+            && (CreateDirectoryA(node->destination.c_str(), NULL) == 0)
+            && (GetLastError() != ERROR_ALREADY_EXISTS)
+        ) {
+            copy.failed = true;
+        }
+        if (copy.failed) {
+            FinishDirectoryNode(node);
+            return;
+        }
+        const auto listGlob = node->source + "*.*";
+        WIN32_FIND_DATAA findFileData;
+        const HANDLE searchHandle = FindFirstFileExA(
+            listGlob.c_str(),
+            FindExInfoBasic,
+            &findFileData,
+            FindExSearchNameMatch,
+            NULL,
+            FIND_FIRST_EX_LARGE_FETCH
+        );
+        if (searchHandle != INVALID_HANDLE_VALUE) {
+            do {
+                const std::string name(findFileData.cFileName);
+                if (
+                    (name == ".")
+                    || (name == "..")
+                ) {
+                    continue;
+                }
+                ++node->pending;
+                if ((findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+                    auto child = std::make_shared< DirectoryCopyNode >();
+                    child->source = node->source + name + '\\';
+                    child->destination = node->destination + name + '\\';
+                    child->parent = node;
+                    child->hasMetadata = true;
+                    child->attributes = findFileData.dwFileAttributes;
+                    child->creationTime = findFileData.ftCreationTime;
+                    child->lastAccessTime = findFileData.ftLastAccessTime;
+                    child->lastWriteTime = findFileData.ftLastWriteTime;
+                    copy.pool.Post(
+                        [&copy, child]{
+                            CopyDirectoryNode(copy, child);
+                        }
+                    );
+                } else {
+                    const auto source = node->source + name;
+                    const auto destination = node->destination + name;
+                    copy.pool.Post(
+                        [&copy, node, source, destination, findFileData]{
+                            CopyOneFile(copy, source, destination, findFileData);
+                            FinishDirectoryNode(node);
+                        }
+                    );
+                }
+            } while (FindNextFileA(searchHandle, &findFileData) == TRUE);
+            FindClose(searchHandle);
+        }
+        FinishDirectoryNode(node);
+    }
+
+    /**
+     * This is the number of bytes of directory entries fetched at a
+     * time when listing a directory to delete its contents.
+     */
+    constexpr size_t DELETE_BATCH_BYTES = 65536;
+
+    /**
+     * This holds the state shared by all the tasks
+     * carrying out one directory deletion.
+     */
+    struct DirectoryDelete {
+        /**
+         * This is the number of threads to use for the deletion.
+         */
+        size_t numThreads;
+
+        /**
+         * This is the pool of threads deleting subdirectories.  It's
+         * only started once the first subdirectory is found, so that
+         * deleting a directory holding only files costs no threads.
+         */
+        std::unique_ptr< SystemUtils::WorkerPool > pool;
+
+        /**
+         * This flag is set if anything fails to be deleted.
+         */
+        std::atomic< bool > failed;
+
+        explicit DirectoryDelete(size_t numThreads)
+            : numThreads(numThreads)
+            , failed(false)
+        {
+        }
+
+        /**
+         * This method has the given task performed by the pool
+         * of threads, starting the pool if necessary.
+         *
+         * @note
+         *      The pool is only ever started by the thread listing the
+         *      directory being deleted, since only the tasks it posts
+         *      can find more subdirectories.
+         *
+         * @param[in] task
+         *      This is the task to perform.
+         */
+        void Post(SystemUtils::WorkerPool::Task task) {
+            if (pool == nullptr) {
+                pool.reset(new SystemUtils::WorkerPool(numThreads));
+            }
+            pool->Post(std::move(task));
+        }
+    };
+
+    /**
+     * This holds what's needed to delete one directory.
+     */
+    struct DirectoryDeleteNode {
+        /**
+         * This is the handle to the directory, open for listing
+         * and deletion.  Everything in the directory is opened
+         * relative to it, rather than by path.
+         */
+        HANDLE handle = INVALID_HANDLE_VALUE;
+
+        /**
+         * This is the path of the directory, if it's to be deleted by
+         * path rather than through its handle, which is only so for
+         * the directory given to be deleted.
+         */
+        std::wstring path;
+
+        /**
+         * This is the directory containing this one, if it's
+         * also being deleted.
+         */
+        std::shared_ptr< DirectoryDeleteNode > parent;
+
+        /**
+         * This is the number of tasks deleting things in this directory
+         * which haven't yet finished, counting the task which lists it.
+         */
+        std::atomic< size_t > pending;
+
+        DirectoryDeleteNode()
+            : pending(1)
+        {
+        }
+    };
+
+    /**
+     * This function opens something in a directory, given the handle
+     * of the directory and the name of the thing.  This is the Windows
+     * counterpart of openat: the name is looked up only in the given
+     * directory, so it works however deep the directory is, and doesn't
+     * pay to look up every directory from the root of the path down.
+     * Links are opened themselves, never what they lead to.
+     *
+     * @param[in] directory
+     *      This is the handle to the directory holding the thing to open.
+     *
+     * @param[in] name
+     *      This is the name of the thing to open.
+     *
+     * @param[in] nameLength
+     *      This is the number of characters in the name.
+     *
+     * @param[in] access
+     *      This is the access to request to the thing.
+     *
+     * @param[in] options
+     *      These are any extra NtCreateFile options to use.
+     *
+     * @return
+     *      The handle to the thing opened is returned.
+     *
+     * @retval INVALID_HANDLE_VALUE
+     *      This is returned if the thing couldn't be opened.
+     */
+    HANDLE OpenRelative(
+        HANDLE directory,
+        const WCHAR* name,
+        size_t nameLength,
+        ACCESS_MASK access,
+        ULONG options
+    ) {
+        UNICODE_STRING objectName;
+        objectName.Buffer = (PWSTR)name;
+        objectName.Length = (USHORT)(nameLength * sizeof(WCHAR));
+        objectName.MaximumLength = objectName.Length;
+        OBJECT_ATTRIBUTES attributes;
+        InitializeObjectAttributes(&attributes, &objectName, OBJ_CASE_INSENSITIVE, directory, NULL);
+        IO_STATUS_BLOCK ioStatus;
+        HANDLE handle = NULL;
+        const auto status = NtCreateFile(
+            &handle,
+            access | SYNCHRONIZE,
+            &attributes,
+            &ioStatus,
+            NULL,
+            0,
+            FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+            FILE_OPEN,
+            (
+                options
+                | FILE_OPEN_REPARSE_POINT
+                | FILE_OPEN_FOR_BACKUP_INTENT
+                | FILE_SYNCHRONOUS_IO_NONALERT
+            ),
+            NULL,
+            0
+        );
+        if (status < 0) {
+            return INVALID_HANDLE_VALUE;
+        }
+        return handle;
+    }
+
+    /**
+     * This function turns the given path into an absolute path with
+     * the "\\?\" prefix, which lifts the MAX_PATH limit on its length.
+     *
+     * @param[in] path
+     *      This is the path to convert.
+     *
+     * @return
+     *      The absolute, prefixed form of the path is returned,
+     *      without any trailing separator.
+     */
+    std::wstring GetExtendedLengthPath(const std::wstring& path) {
+        const auto fullPathLength = GetFullPathNameW(path.c_str(), 0, NULL, NULL);
+        if (fullPathLength == 0) {
+            return path;
+        }
+        std::wstring fullPath((size_t)fullPathLength, L'\0');
+        fullPath.resize(
+            (size_t)GetFullPathNameW(path.c_str(), fullPathLength, &fullPath[0], NULL)
+        );
+        while (
+            (fullPath.length() > 3)
+            && (fullPath.back() == L'\\')
+        ) {
+            fullPath.pop_back();
+        }
+        if (fullPath.compare(0, 4, L"\\\\?\\") == 0) {
+            return fullPath;
+        }
+        if (fullPath.compare(0, 2, L"\\\\") == 0) {
+            return L"\\\\?\\UNC\\" + fullPath.substr(2);
+        }
+        return L"\\\\?\\" + fullPath;
+    }
+
+    /**
+     * This function deletes the file or directory with the given
+     * handle, which must have been opened with delete access.
+     *
+     * @param[in] handle
+     *      This is the handle to the file or directory to delete.
+     *
+     * @return
+     *      An indication of whether or not the file
+     *      or directory was deleted is returned.
+     */
+    bool DeleteByHandle(HANDLE handle) {
+        // POSIX semantics take the name out of the directory right
+        // away, even if others have the file open, so the directory
+        // holding it can be deleted without waiting for them.
+        FILE_DISPOSITION_INFO_EX dispositionEx;
+        dispositionEx.Flags = (
+            FILE_DISPOSITION_FLAG_DELETE
+            | FILE_DISPOSITION_FLAG_POSIX_SEMANTICS
+            | FILE_DISPOSITION_FLAG_IGNORE_READONLY_ATTRIBUTE
+        );
+        if (
+            SetFileInformationByHandle(
+                handle,
+                FileDispositionInfoEx,
+                &dispositionEx,
+                sizeof(dispositionEx)
+            ) != 0
+        ) {
+            return true;
+        }
+
+        // Older systems and some file systems only
+        // support the original form of deletion.
+        FILE_DISPOSITION_INFO disposition;
+        disposition.DeleteFile = TRUE;
+        return (
+            SetFileInformationByHandle(
+                handle,
+                FileDispositionInfo,
+                &disposition,
+                sizeof(disposition)
+            ) != 0
+        );
+    }
+
+    /**
+     * This function deletes the file, directory, or link with the
+     * given path.  Links are deleted themselves, never what
+     * they lead to.  Directories must be empty.
+     *
+     * @param[in] path
+     *      This is the path of the thing to delete.
+     *
+     * @return
+     *      An indication of whether or not the thing
+     *      was deleted is returned.
+     */
+    bool DeletePath(const std::wstring& path) {
+        const auto handle = CreateFileW(
+            path.c_str(),
+            DELETE,
+            FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT,
+            NULL
+        );
+        if (handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        const auto deleted = DeleteByHandle(handle);
+        (void)CloseHandle(handle);
+        return deleted;
+    }
+
+    /**
+     * This function is called when a task deleting something in a
+     * directory finishes.  Once everything in the directory has been
+     * deleted, the directory itself is deleted, and the directory
+     * containing it is told in turn.
+     *
+     * @param[in] deletion
+     *      This is the state of the directory deletion.
+     *
+     * @param[in] node
+     *      This represents the directory whose task finished.
+     */
+    void FinishDeleteNode(
+        DirectoryDelete& deletion,
+        std::shared_ptr< DirectoryDeleteNode > node
+    ) {
+        while (
+            (node != nullptr)
+            && (--node->pending == 0)
+        ) {
+            bool deleted;
+            if (node->path.empty()) {
+                deleted = (
+                    !deletion.failed
+                    && DeleteByHandle(node->handle)
+                );
+                (void)CloseHandle(node->handle);
+            } else {
+                (void)CloseHandle(node->handle);
+                deleted = (
+                    !deletion.failed
+                    && DeletePath(node->path)
+                );
+            }
+            node->handle = INVALID_HANDLE_VALUE;
+            if (!deleted) {
+                deletion.failed = true;
+            }
+            node = node->parent;
+        }
+    }
+
+    /**
+     * This function lists a directory through a handle to it,
+     * deleting each file and link in it right away, and posting
+     * a task to delete each subdirectory, so that different
+     * subtrees are deleted at once.  Everything in the directory
+     * is opened relative to the directory's handle.
+     *
+     * @param[in] deletion
+     *      This is the state of the directory deletion.
+     *
+     * @param[in] node
+     *      This represents the directory to delete.
+     */
+    void DeleteDirectoryNode(
+        DirectoryDelete& deletion,
+        std::shared_ptr< DirectoryDeleteNode > node
+    ) {
+        // The batch is made of 64-bit words so that
+        // the entries in it are suitably aligned.
+        std::vector< uint64_t > batch(DELETE_BATCH_BYTES / sizeof(uint64_t));
+        auto infoClass = FileFullDirectoryRestartInfo;
+        while (!deletion.failed) {
+            if (
+                GetFileInformationByHandleEx(
+                    node->handle,
+                    infoClass,
+                    batch.data(),
+                    (DWORD)(batch.size() * sizeof(uint64_t))
+                ) == 0
+            ) {
+                if (GetLastError() != ERROR_NO_MORE_FILES) {
+                    deletion.failed = true;
+                }
+                break;
+            }
+            infoClass = FileFullDirectoryInfo;
+            size_t offset = 0;
+            for (;;) {
+                const auto info = (const FILE_FULL_DIR_INFO*)((const uint8_t*)batch.data() + offset);
+                const auto name = info->FileName;
+                const auto nameLength = (size_t)(info->FileNameLength / sizeof(WCHAR));
+                const auto isDot = (
+                    (name[0] == L'.')
+                    && (
+                        (nameLength == 1)
+                        || (
+                            (nameLength == 2)
+                            && (name[1] == L'.')
+                        )
+                    )
+                );
+                if (!isDot) {
+                    // Links to directories are deleted themselves,
+                    // rather than having what they lead to emptied.
+                    if (
+                        ((info->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+                        && ((info->FileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0)
+                    ) {
+                        auto child = std::make_shared< DirectoryDeleteNode >();
+                        child->handle = OpenRelative(
+                            node->handle,
+                            name,
+                            nameLength,
+                            FILE_LIST_DIRECTORY | DELETE,
+                            FILE_DIRECTORY_FILE
+                        );
+                        if (child->handle == INVALID_HANDLE_VALUE) {
+                            deletion.failed = true;
+                            break;
+                        }
+                        child->parent = node;
+                        ++node->pending;
+                        deletion.Post(
+                            [&deletion, child]{
+                                DeleteDirectoryNode(deletion, child);
+                            }
+                        );
+                    } else {
+                        const auto handle = OpenRelative(
+                            node->handle,
+                            name,
+                            nameLength,
+                            DELETE,
+                            0
+                        );
+                        if (handle == INVALID_HANDLE_VALUE) {
+                            deletion.failed = true;
+                            break;
+                        }
+                        const auto deleted = DeleteByHandle(handle);
+                        (void)CloseHandle(handle);
+                        if (!deleted) {
+                            deletion.failed = true;
+                            break;
+                        }
+                    }
+                }
+                if (info->NextEntryOffset == 0) {
+                    break;
+                }
+                offset += info->NextEntryOffset;
+            }
+        }
+        FinishDeleteNode(deletion, node);
+    }
+
+    /**
+     * This function returns the pool of threads
+     * on which directories are deleted in the background.
+     *
+     * @return
+     *      The pool of threads on which directories are
+     *      deleted in the background is returned.
+     */
+    SystemUtils::WorkerPool& GetBackgroundDeletePool() {
+        static SystemUtils::WorkerPool pool(1);
+        return pool;
+    }
+
+    /**
+     * This is the number of 100-nanosecond intervals between the
+     * Windows epoch (1601-01-01) and the UNIX epoch (1970-01-01).
+     */
+    constexpr uint64_t WINDOWS_TO_UNIX_EPOCH = 116444736000000000ULL;
+
+    /**
+     * This function converts a Windows file time into the number
+     * of nanoseconds since the UNIX epoch.
+     *
+     * @param[in] fileTime
+     *      This is the number of 100-nanosecond intervals
+     *      since the Windows epoch.
+     *
+     * @return
+     *      The number of nanoseconds since the UNIX epoch is returned,
+     *      or zero if the time is before the UNIX epoch.
+     */
+    uint64_t ToUnixNanoseconds(uint64_t fileTime) {
+        if (fileTime < WINDOWS_TO_UNIX_EPOCH) {
+            return 0;
+        }
+        return (fileTime - WINDOWS_TO_UNIX_EPOCH) * 100;
+    }
+
+    /**
+     * This function gathers the metadata of an open file.
+     *
+     * @param[in] handle
+     *      This is the operating-system handle to the file.
+     *
+     * @param[out] metadata
+     *      This is where to store the metadata of the file.
+     *
+     * @return
+     *      An indication of whether or not the metadata
+     *      could be gathered is returned.
+     */
+    bool QueryMetadata(
+        HANDLE handle,
+        SystemUtils::File::Metadata& metadata
+    ) {
+        // The basic information has the change time, which
+        // the by-handle information lacks; the by-handle information
+        // has the volume and file identifiers, which the basic
+        // information lacks.
+        BY_HANDLE_FILE_INFORMATION handleInfo;
+        FILE_BASIC_INFO basicInfo;
+        if (
+            (GetFileInformationByHandle(handle, &handleInfo) == 0)
+            || (
+                GetFileInformationByHandleEx(
+                    handle,
+                    FileBasicInfo,
+                    &basicInfo,
+                    sizeof(basicInfo)
+                ) == 0
+            )
+        ) {
+            return false;
+        }
+        metadata.exists = true;
+        metadata.isDirectory = ((handleInfo.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
+        metadata.size = (
+            ((uint64_t)handleInfo.nFileSizeHigh << 32)
+            | (uint64_t)handleInfo.nFileSizeLow
+        );
+        metadata.lastModifiedTime = ToUnixNanoseconds((uint64_t)basicInfo.LastWriteTime.QuadPart);
+        metadata.changeTime = ToUnixNanoseconds((uint64_t)basicInfo.ChangeTime.QuadPart);
+        metadata.fileId = (
+            ((uint64_t)handleInfo.nFileIndexHigh << 32)
+            | (uint64_t)handleInfo.nFileIndexLow
+        );
+        metadata.deviceId = (uint64_t)handleInfo.dwVolumeSerialNumber;
+        return true;
+    }
+
+    /**
+     * This function gathers the metadata of a file or directory
+     * given its path.
+     *
+     * @param[in] path
+     *      This is the path to the file or directory.
+     *
+     * @return
+     *      The metadata of the file or directory is returned.
+     */
+    SystemUtils::File::Metadata QueryMetadata(const std::string& path) {
+        SystemUtils::File::Metadata metadata;
+
+        // Opening with no access other than to read attributes
+        // works even for files opened elsewhere without sharing,
+        // and the backup semantics flag allows directories to be opened.
+        const auto handle = CreateFileA(
+            path.c_str(),
+            FILE_READ_ATTRIBUTES,
+            FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS,
+            NULL
+        );
+        if (handle == INVALID_HANDLE_VALUE) {
+            return metadata;
+        }
+        if (!QueryMetadata(handle, metadata)) {
+            metadata = SystemUtils::File::Metadata();
+        }
+        (void)CloseHandle(handle);
+        return metadata;
+    }
+
 }
 
 namespace SystemUtils {
     /**
-     * This is the win32-specific state for the file class
+     * This holds the file mapping object behind a mapped view, the
+     * base address of the view, and where and how long the region
+     * of the file mapped through it is.
     */
-   struct File::Platform
+   struct File::MappedView::Impl
    {
         /**
-         * This is the operating-system handler to the file
-        */
-        HANDLE handle;
+         * This is used to synchronize unmapping the view.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is the operating-system handle to the file mapping
+         * object backing the view.
+         */
+        HANDLE mapping = NULL;
+
+        /**
+         * This is the operating-system handle to the file.
+         * It's only valid while the view is mapped.
+         */
+        HANDLE file = INVALID_HANDLE_VALUE;
+
+        /**
+         * This is the address at which the view was mapped, which is
+         * at the start of the allocation granule holding the region.
+         */
+        void* base = nullptr;
+
+        /**
+         * This is the address of the first byte of the mapped region.
+         */
+        uint8_t* data = nullptr;
 
         /**
-            * This flag indicates whether or not the file was opened
-            * with write access.
-        */
-        bool writeAccess = false;
+         * This is the number of bytes in the mapped region.
+         */
+        size_t size = 0;
+
+        /**
+         * This is the offset in the file of the mapped region.
+         */
+        uint64_t offset = 0;
    };
-   
+
+   bool File::Platform::IsAligned(
+        File::Impl& impl,
+        uint64_t offset,
+        const void* buffer,
+        size_t numBytes
+   ) const {
+        if (!directIo) {
+            return true;
+        }
+        if ((offset % blockSize) != 0) {
+            impl.SetLastError(
+                StringUtils::sprintf(
+                    "direct I/O offset %llu is not a multiple of the %zu-byte block size",
+                    (unsigned long long)offset,
+                    blockSize
+                )
+            );
+            return false;
+        }
+        if ((numBytes % blockSize) != 0) {
+            impl.SetLastError(
+                StringUtils::sprintf(
+                    "direct I/O length %zu is not a multiple of the %zu-byte block size",
+                    numBytes,
+                    blockSize
+                )
+            );
+            return false;
+        }
+        if (((uintptr_t)buffer % blockSize) != 0) {
+            impl.SetLastError(
+                StringUtils::sprintf(
+                    "direct I/O buffer address %p is not a multiple of the %zu-byte block size",
+                    buffer,
+                    blockSize
+                )
+            );
+            return false;
+        }
+        return true;
+   }
+
    File::Impl::~Impl() noexcept = default;
-   File::Impl::Impl(Impl&&) noexcept = default;
-   File::Impl& File::Impl::operator=(Impl&&) = default;
 
    File::Impl::Impl() : platform_(new Platform())
    {
@@ -84,7 +1204,7 @@ namespace SystemUtils {
             return true;
         }
 
-        const DWORD error = GetLastError();
+        const DWORD error = ::GetLastError();
         if (error == ERROR_ALREADY_EXISTS) {
             return true;
         }
@@ -100,6 +1220,102 @@ namespace SystemUtils {
         return true;
    }
 
+   File::MappedView::~MappedView() noexcept {
+        Unmap();
+   }
+
+   File::MappedView::MappedView()
+        : impl_(new Impl())
+   {
+   }
+
+   uint8_t* File::MappedView::GetData() const {
+        return impl_->data;
+   }
+
+   size_t File::MappedView::GetSize() const {
+        return impl_->size;
+   }
+
+   bool File::MappedView::Flush(size_t offset, size_t length) {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        if (
+            (impl_->data == nullptr)
+            || (offset > impl_->size)
+        ) {
+            return false;
+        }
+        if (
+            (length == 0)
+            || (length > impl_->size - offset)
+        ) {
+            length = impl_->size - offset;
+        }
+        if (FlushViewOfFile(impl_->data + offset, length) == 0) {
+            return false;
+        }
+        return (FlushFileBuffers(impl_->file) != 0);
+   }
+
+   bool File::MappedView::Advise(
+        AccessHint hint,
+        size_t offset,
+        size_t length
+   ) {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        if (
+            (impl_->data == nullptr)
+            || (offset > impl_->size)
+        ) {
+            return false;
+        }
+        if (
+            (length == 0)
+            || (length > impl_->size - offset)
+        ) {
+            length = impl_->size - offset;
+        }
+        switch (hint) {
+            case AccessHint::WillNeed: {
+                WIN32_MEMORY_RANGE_ENTRY range;
+                range.VirtualAddress = impl_->data + offset;
+                range.NumberOfBytes = length;
+                return (PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0);
+            }
+
+            case AccessHint::DontNeed: {
+                // Unlocking pages which aren't locked takes them out
+                // of the working set, leaving them at the front of the
+                // line to be reused.  It always "fails" for such pages,
+                // so the result isn't meaningful.
+                (void)VirtualUnlock(impl_->data + offset, length);
+                return true;
+            }
+
+            default: {
+                // There's no way to tell the memory manager how
+                // a mapped view will be accessed, so there's
+                // nothing to do for these hints.
+                return true;
+            }
+        }
+   }
+
+   void File::MappedView::Unmap() {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        if (impl_->base != nullptr) {
+            (void)UnmapViewOfFile(impl_->base);
+            impl_->base = nullptr;
+        }
+        if (impl_->mapping != NULL) {
+            (void)CloseHandle(impl_->mapping);
+            impl_->mapping = NULL;
+        }
+        impl_->file = INVALID_HANDLE_VALUE;
+        impl_->data = nullptr;
+        impl_->size = 0;
+   }
+
    File::~File() noexcept {
         if (impl_ == nullptr) {
             return;
@@ -136,7 +1352,12 @@ namespace SystemUtils {
    }
 
    bool File::OpenReadOnly() {
+        return OpenReadOnly(CacheMode::Cached);
+   }
+
+   bool File::OpenReadOnly(CacheMode cacheMode) {
         Close();
+        const bool directIo = (cacheMode == CacheMode::Direct);
         impl_->platform_->handle = CreateFileA
         (
             impl_->path.c_str(),
@@ -144,20 +1365,34 @@ namespace SystemUtils {
             FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
             NULL,
             OPEN_EXISTING,
-            FILE_ATTRIBUTE_NORMAL,
+            GetOpenFlags(directIo),
             NULL
         );
         impl_->platform_->writeAccess = false;
-        return (impl_->platform_->handle != INVALID_HANDLE_VALUE);
+        impl_->platform_->directIo = directIo;
+        impl_->platform_->accessFlags = 0;
+        impl_->platform_->position = 0;
+        if (impl_->platform_->handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        impl_->platform_->blockSize = QueryBlockSize(impl_->platform_->handle);
+        return true;
    }
 
    void File::Close() {
+        impl_->UnmapViews();
         (void)CloseHandle(impl_->platform_->handle);
         impl_->platform_->handle = INVALID_HANDLE_VALUE;
+        impl_->platform_->asyncFileEngineId = 0;
    }
 
    bool File::OpenReadWrite() {
+        return OpenReadWrite(CacheMode::Cached);
+   }
+
+   bool File::OpenReadWrite(CacheMode cacheMode) {
         Close();
+        const bool directIo = (cacheMode == CacheMode::Direct);
         bool createPathTried = false;
         while (impl_->platform_->handle == INVALID_HANDLE_VALUE) {
             impl_->platform_->handle = CreateFileA(
@@ -166,7 +1401,7 @@ namespace SystemUtils {
                 FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
                 NULL,
                 OPEN_ALWAYS,
-                FILE_ATTRIBUTE_NORMAL,
+                GetOpenFlags(directIo),
                 NULL
             );
             if (impl_->platform_->handle == INVALID_HANDLE_VALUE) {
@@ -180,6 +1415,10 @@ namespace SystemUtils {
             }
             impl_->platform_->writeAccess = true;
         }
+        impl_->platform_->directIo = directIo;
+        impl_->platform_->accessFlags = 0;
+        impl_->platform_->blockSize = QueryBlockSize(impl_->platform_->handle);
+        impl_->platform_->position = 0;
         return true;
    }
 
@@ -303,47 +1542,99 @@ namespace SystemUtils {
     }
 
     bool File::DeleteDirectory(const std::string& directory) {
-        std::string directoryWithSeparator(directory);
-        if (
-            (directoryWithSeparator.length() > 0)
-            && (directoryWithSeparator[directoryWithSeparator.length() - 1] != '\\')
-            && (directoryWithSeparator[directoryWithSeparator.length() - 1] != '/')
+        // Deleting spends most of its time waiting on the disk,
+        // so use more threads than there are processors.
+        return DeleteDirectory(
+            directory,
+            std::max< size_t >(4, 2 * (size_t)std::thread::hardware_concurrency())
+        );
+    }
+
+    bool File::DeleteDirectory(
+        const std::string& directory,
+        size_t numThreads
+    ) {
+        // The directory given is opened by its absolute path with the
+        // "\\?\" prefix, so that its path may be as long as it is.
+        // Everything in it is then opened relative to its parent.
+        const auto directoryLength = MultiByteToWideChar(CP_ACP, 0, directory.data(), (int)directory.length(), NULL, 0);
+        std::wstring directoryWide((size_t)directoryLength, L'\0');
+        if (directoryLength > 0) {
+            (void)MultiByteToWideChar(CP_ACP, 0, directory.data(), (int)directory.length(), &directoryWide[0], directoryLength);
+        }
+        auto root = std::make_shared< DirectoryDeleteNode >();
+        root->path = GetExtendedLengthPath(directoryWide);
+        root->handle = CreateFileW(
+            root->path.c_str(),
+            FILE_LIST_DIRECTORY,
+            FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS,
+            NULL
+        );
+        if (root->handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        // The directory given is listed on this thread, and threads
+        // are only started if it turns out to hold subdirectories.
+        DirectoryDelete deletion(std::max< size_t >(1, numThreads));
+        DeleteDirectoryNode(deletion, root);
+        if (deletion.pool != nullptr) {
+            deletion.pool->Wait();
+        }
+        return !deletion.failed;
+    }
+
+    bool File::DeleteDirectoryInBackground(const std::string& directory) {
+        std::string directoryWithoutSeparator(directory);
+        while (
+            (directoryWithoutSeparator.length() > 0)
+            && (
+                (directoryWithoutSeparator.back() == '\\')
+                || (directoryWithoutSeparator.back() == '/')
+            )
         ) {
-            directoryWithSeparator += '\\';
+            directoryWithoutSeparator.pop_back();
         }
-        std::string listGlob(directoryWithSeparator);
-        listGlob += "*.*";
-        WIN32_FIND_DATAA findFileData;
-        const HANDLE searchHandle = FindFirstFileA(listGlob.c_str(), &findFileData);
-        if (searchHandle != INVALID_HANDLE_VALUE) {
-            do {
-                std::string name(findFileData.cFileName);
-                if (
-                    (name == ".")
-                    || (name == "..")
-                ) {
-                    continue;
-                }
-                std::string filePath(directoryWithSeparator);
-                filePath += name;
-                if (PathIsDirectoryA(filePath.c_str())) {
-                    if (!DeleteDirectory(filePath.c_str())) {
-                        return false;
-                    }
-                } else {
-                    if (DeleteFileA(filePath.c_str()) == 0) {
-                        return false;
-                    }
-                }
-            } while (FindNextFileA(searchHandle, &findFileData) == TRUE);
-            FindClose(searchHandle);
+
+        // Renaming within the same parent directory is atomic,
+        // so the directory vanishes from its old path at once.
+        static std::atomic< unsigned int > nextAsideId(0);
+        const auto aside = StringUtils::sprintf(
+            "%s.deleting-%lu-%u",
+            directoryWithoutSeparator.c_str(),
+            (unsigned long)GetCurrentProcessId(),
+            (unsigned int)++nextAsideId
+        );
+        if (MoveFileExA(directoryWithoutSeparator.c_str(), aside.c_str(), 0) == 0) {
+            return false;
         }
-        return (RemoveDirectoryA(directory.c_str()) != 0);
+        GetBackgroundDeletePool().Post(
+            [aside]{
+                (void)DeleteDirectory(aside);
+            }
+        );
+        return true;
+    }
+
+    void File::WaitForBackgroundDeletions() {
+        GetBackgroundDeletePool().Wait();
     }
 
     bool File::CopyDirectory(
         const std::string& existingDirectory,
         const std::string& newDirectory
+    ) {
+        return CopyDirectory(existingDirectory, newDirectory, nullptr, false);
+    }
+
+    bool File::CopyDirectory(
+        const std::string& existingDirectory,
+        const std::string& newDirectory,
+        CopyProgressDelegate progressDelegate,
+        bool skipUnchanged
     ) {
         std::string existingDirectoryWithSeparator(existingDirectory);
         if (
@@ -364,36 +1655,32 @@ namespace SystemUtils {
         if (!File::Impl::CreatePath(newDirectoryWithSeparator)) {
             return false;
         }
-        std::string listGlob(existingDirectoryWithSeparator);
-        listGlob += "*.*";
-        WIN32_FIND_DATAA findFileData;
-        const HANDLE searchHandle = FindFirstFileA(listGlob.c_str(), &findFileData);
-        if (searchHandle != INVALID_HANDLE_VALUE) {
-            do {
-                std::string name(findFileData.cFileName);
-                if (
-                    (name == ".")
-                    || (name == "..")
-                ) {
-                    continue;
-                }
-                std::string filePath(existingDirectoryWithSeparator);
-                filePath += name;
-                std::string newFilePath(newDirectoryWithSeparator);
-                newFilePath += name;
-                if (PathIsDirectoryA(filePath.c_str())) {
-                    if (!CopyDirectory(filePath, newFilePath)) {
-                        return false;
-                    }
-                } else {
-                    if (!CopyFileA(filePath.c_str(), newFilePath.c_str(), FALSE)) {
-                        return false; 
-                    }
-                }
-            } while (FindNextFileA(searchHandle, &findFileData) == TRUE);
-            FindClose(searchHandle);
+        auto root = std::make_shared< DirectoryCopyNode >();
+        root->source = existingDirectoryWithSeparator;
+        root->destination = newDirectoryWithSeparator;
+        WIN32_FILE_ATTRIBUTE_DATA rootData;
+        if (GetFileAttributesExA(existingDirectory.c_str(), GetFileExInfoStandard, &rootData) != 0) {
+            root->hasMetadata = true;
+            root->attributes = rootData.dwFileAttributes;
+            root->creationTime = rootData.ftCreationTime;
+            root->lastAccessTime = rootData.ftLastAccessTime;
+            root->lastWriteTime = rootData.ftLastWriteTime;
         }
-        return true;
+
+        // Copies spend most of their time waiting on the disk,
+        // so use more threads than there are processors.
+        const auto numThreads = std::max< size_t >(4, 2 * (size_t)std::thread::hardware_concurrency());
+        WorkerPool pool(numThreads);
+        DirectoryCopy copy(pool);
+        copy.progressDelegate = progressDelegate;
+        copy.skipUnchanged = skipUnchanged;
+        pool.Post(
+            [&copy, root]{
+                CopyDirectoryNode(copy, root);
+            }
+        );
+        pool.Wait();
+        return !copy.failed;
     }
 
     std::vector<std::string> File::GetDirectoryRoots() {
@@ -455,65 +1742,170 @@ namespace SystemUtils {
     }
 
     bool File::SetSize(uint64_t size) {
-        const uint64_t position = GetPosition();
-        SetPosition(size);
-        const bool success = (SetEndOfFile(impl_->platform_->handle) != 0);
-        SetPosition(position);
-        return success;
+        FILE_END_OF_FILE_INFO endOfFileInfo;
+        endOfFileInfo.EndOfFile.QuadPart = (LONGLONG)size;
+        return (
+            SetFileInformationByHandle(
+                impl_->platform_->handle,
+                FileEndOfFileInfo,
+                &endOfFileInfo,
+                sizeof(endOfFileInfo)
+            ) != 0
+        );
     }
 
     uint64_t File::GetPosition() const {
-        LARGE_INTEGER distanceToMove;
-        distanceToMove.QuadPart = 0;
-        LARGE_INTEGER newPosition;
-        if (SetFilePointerEx(impl_->platform_->handle, distanceToMove, &newPosition, FILE_CURRENT) == 0) {
-            return 0;
-        }
-        return (uint64_t)newPosition.QuadPart;
+        return impl_->platform_->position;
     }
 
     void File::SetPosition(uint64_t position) {
-        LARGE_INTEGER distanceToMove;
-        distanceToMove.QuadPart = position;
-        LARGE_INTEGER newPosition;
-        (void)SetFilePointerEx(impl_->platform_->handle, distanceToMove, &newPosition, FILE_BEGIN);
+        impl_->platform_->position = position;
     }
 
     size_t File::Peek(void* buffer, size_t numBytes) const {
-        const uint64_t position = GetPosition();
-        DWORD amountRead;
-        if (ReadFile(impl_->platform_->handle, buffer, (DWORD)numBytes, &amountRead, NULL) == 0) {
-            return 0;
-        }
-        LARGE_INTEGER distanceToMove;
-        distanceToMove.QuadPart = position;
-        LARGE_INTEGER newPosition;
-        (void)SetFilePointerEx(impl_->platform_->handle, distanceToMove, &newPosition, FILE_BEGIN);
-        return (size_t)amountRead;
+        return ReadAt(impl_->platform_->position, buffer, numBytes);
     }
 
     size_t File::Read(void* buffer, size_t numBytes) {
-        if (numBytes == 0) {
+        const auto amountRead = ReadAt(impl_->platform_->position, buffer, numBytes);
+        impl_->platform_->position += amountRead;
+        return amountRead;
+    }
+
+    size_t File::Write(const void* buffer, size_t numBytes) {
+        const auto amountWritten = WriteAt(impl_->platform_->position, buffer, numBytes);
+        impl_->platform_->position += amountWritten;
+        return amountWritten;
+    }
+
+    size_t File::ReadAt(uint64_t offset, void* buffer, size_t numBytes) const {
+        if (!impl_->platform_->IsAligned(*impl_, offset, buffer, numBytes)) {
             return 0;
         }
-        DWORD amountRead;
-        if (ReadFile(impl_->platform_->handle, buffer, (DWORD)numBytes, &amountRead, NULL) == 0) {
+        return TransferAt(impl_->platform_->handle, false, offset, buffer, numBytes);
+    }
+
+    size_t File::WriteAt(uint64_t offset, const void* buffer, size_t numBytes) {
+        if (!impl_->platform_->IsAligned(*impl_, offset, buffer, numBytes)) {
             return 0;
         }
-        return (size_t)amountRead;
+        return TransferAt(impl_->platform_->handle, true, offset, (void*)buffer, numBytes);
     }
 
-    size_t File::Write(const void* buffer, size_t numBytes) {
-        DWORD amountWritten;
-        if (WriteFile(impl_->platform_->handle, buffer, (DWORD)numBytes, &amountWritten, NULL) == 0) {
-            return 0;
+    size_t File::ReadV(const std::vector< ReadSegment >& segments) {
+        const auto amountRead = ReadVAt(impl_->platform_->position, segments);
+        impl_->platform_->position += amountRead;
+        return amountRead;
+    }
+
+    size_t File::WriteV(const std::vector< WriteSegment >& segments) {
+        const auto amountWritten = WriteVAt(impl_->platform_->position, segments);
+        impl_->platform_->position += amountWritten;
+        return amountWritten;
+    }
+
+    size_t File::ReadVAt(uint64_t offset, const std::vector< ReadSegment >& segments) const {
+        // ReadFileScatter only works for unbuffered files and whole
+        // pages, so instead runs of small pieces are read together
+        // through a staging buffer and then scattered, and large
+        // pieces are read directly.  With direct I/O every piece must
+        // already be aligned, so each is read directly.
+        auto& staging = GetStagingBuffer();
+        size_t total = 0;
+        size_t next = 0;
+        while (next < segments.size()) {
+            if (
+                impl_->platform_->directIo
+                || (segments[next].numBytes >= STAGING_SIZE)
+            ) {
+                const auto& segment = segments[next++];
+                const auto amountRead = ReadAt(offset + total, segment.buffer, segment.numBytes);
+                total += amountRead;
+                if (amountRead < segment.numBytes) {
+                    break;
+                }
+                continue;
+            }
+            auto end = next;
+            size_t runSize = 0;
+            while (
+                (end < segments.size())
+                && (runSize + segments[end].numBytes <= STAGING_SIZE)
+            ) {
+                runSize += segments[end++].numBytes;
+            }
+            const auto amountRead = ReadAt(offset + total, staging.data(), runSize);
+            size_t scattered = 0;
+            while (
+                (next < end)
+                && (scattered < amountRead)
+            ) {
+                const auto amount = std::min(segments[next].numBytes, amountRead - scattered);
+                (void)memcpy(segments[next].buffer, staging.data() + scattered, amount);
+                scattered += amount;
+                ++next;
+            }
+            total += amountRead;
+            if (amountRead < runSize) {
+                break;
+            }
+            next = end;
+        }
+        return total;
+    }
+
+    size_t File::WriteVAt(uint64_t offset, const std::vector< WriteSegment >& segments) {
+        // WriteFileGather only works for unbuffered files and whole
+        // pages, so instead runs of small pieces are gathered into
+        // a staging buffer and written together, and large pieces
+        // are written directly.  With direct I/O every piece must
+        // already be aligned, so each is written directly.
+        auto& staging = GetStagingBuffer();
+        size_t total = 0;
+        size_t next = 0;
+        while (next < segments.size()) {
+            if (
+                impl_->platform_->directIo
+                || (segments[next].numBytes >= STAGING_SIZE)
+            ) {
+                const auto& segment = segments[next++];
+                const auto amountWritten = WriteAt(offset + total, segment.buffer, segment.numBytes);
+                total += amountWritten;
+                if (amountWritten < segment.numBytes) {
+                    break;
+                }
+                continue;
+            }
+            size_t runSize = 0;
+            while (
+                (next < segments.size())
+                && (runSize + segments[next].numBytes <= STAGING_SIZE)
+            ) {
+                (void)memcpy(staging.data() + runSize, segments[next].buffer, segments[next].numBytes);
+                runSize += segments[next++].numBytes;
+            }
+            const auto amountWritten = WriteAt(offset + total, staging.data(), runSize);
+            total += amountWritten;
+            if (amountWritten < runSize) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    size_t File::GetBlockSize() const {
+        if (impl_->platform_->blockSize == 0) {
+            return AlignedBuffer::DEFAULT_ALIGNMENT;
         }
-        return (size_t)amountWritten;
+        return impl_->platform_->blockSize;
     }
 
     std::shared_ptr< IFile > File::Clone() {
         auto clone = std::make_shared< File >(impl_->path);
         clone->impl_->platform_->writeAccess = impl_->platform_->writeAccess;
+        clone->impl_->platform_->directIo = impl_->platform_->directIo;
+        clone->impl_->platform_->accessFlags = impl_->platform_->accessFlags;
+        clone->impl_->platform_->blockSize = impl_->platform_->blockSize;
         if (impl_->platform_->handle != INVALID_HANDLE_VALUE) {
             if (clone->impl_->platform_->writeAccess) {
                 clone->impl_->platform_->handle = CreateFileA(
@@ -522,7 +1914,10 @@ namespace SystemUtils {
                     FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
                     NULL,
                     OPEN_ALWAYS,
-                    FILE_ATTRIBUTE_NORMAL,
+                    GetOpenFlags(
+                        clone->impl_->platform_->directIo,
+                        clone->impl_->platform_->accessFlags
+                    ),
                     NULL
                 );
             } else {
@@ -532,7 +1927,10 @@ namespace SystemUtils {
                     FILE_SHARE_READ,
                     NULL,
                     OPEN_EXISTING,
-                    FILE_ATTRIBUTE_NORMAL,
+                    GetOpenFlags(
+                        clone->impl_->platform_->directIo,
+                        clone->impl_->platform_->accessFlags
+                    ),
                     NULL
                 );
             }
@@ -543,4 +1941,278 @@ namespace SystemUtils {
         return clone;
     }
 
+    bool File::Sync() {
+        return (FlushFileBuffers(impl_->platform_->handle) != 0);
+    }
+
+    bool File::Preallocate(uint64_t size) {
+        FILE_STANDARD_INFO standardInfo;
+        if (
+            GetFileInformationByHandleEx(
+                impl_->platform_->handle,
+                FileStandardInfo,
+                &standardInfo,
+                sizeof(standardInfo)
+            ) == 0
+        ) {
+            return false;
+        }
+
+        // Setting a smaller allocation than the file's size
+        // would truncate the file, so only ever grow it.
+        if ((uint64_t)standardInfo.AllocationSize.QuadPart >= size) {
+            return true;
+        }
+        FILE_ALLOCATION_INFO allocationInfo;
+        allocationInfo.AllocationSize.QuadPart = (LONGLONG)size;
+        return (
+            SetFileInformationByHandle(
+                impl_->platform_->handle,
+                FileAllocationInfo,
+                &allocationInfo,
+                sizeof(allocationInfo)
+            ) != 0
+        );
+    }
+
+    File::Metadata File::GetMetadata() const {
+        if (impl_->platform_->handle == INVALID_HANDLE_VALUE) {
+            return QueryMetadata(impl_->path);
+        }
+        Metadata metadata;
+        if (!QueryMetadata(impl_->platform_->handle, metadata)) {
+            metadata = Metadata();
+        }
+        return metadata;
+    }
+
+    std::vector< File::Metadata > File::GetMetadata(
+        const std::vector< std::string >& paths,
+        size_t numThreads
+    ) {
+        std::vector< Metadata > metadata(paths.size());
+        if (
+            (numThreads <= 1)
+            || (paths.size() <= 1)
+        ) {
+            for (size_t i = 0; i < paths.size(); ++i) {
+                metadata[i] = QueryMetadata(paths[i]);
+            }
+            return metadata;
+        }
+        WorkerPool workers(std::min(numThreads, paths.size()));
+        for (size_t i = 0; i < paths.size(); ++i) {
+            workers.Post(
+                [&metadata, &paths, i]{
+                    metadata[i] = QueryMetadata(paths[i]);
+                }
+            );
+        }
+        workers.Wait();
+        return metadata;
+    }
+
+    bool File::Advise(
+        AccessHint hint,
+        uint64_t offset,
+        uint64_t length
+    ) {
+        const auto handle = impl_->platform_->handle;
+        if (handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        const auto size = GetSize();
+        if (
+            (length == 0)
+            || (length > size - std::min(offset, size))
+        ) {
+            length = size - std::min(offset, size);
+        }
+        switch (hint) {
+            case AccessHint::Normal:
+            case AccessHint::Sequential:
+            case AccessHint::Random: {
+                // The file cache only learns how a file will be
+                // accessed when a handle is opened, so open a new
+                // handle with the right flags in place of the old one.
+                const auto accessFlags = GetAccessFlags(hint);
+                if (accessFlags == impl_->platform_->accessFlags) {
+                    return true;
+                }
+                const auto newHandle = ReOpenFile(
+                    handle,
+                    (
+                        impl_->platform_->writeAccess
+                        ? (GENERIC_READ | GENERIC_WRITE)
+                        : GENERIC_READ
+                    ),
+                    FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+                    GetOpenFlags(impl_->platform_->directIo, accessFlags) & ~FILE_ATTRIBUTE_NORMAL
+                );
+                if (newHandle == INVALID_HANDLE_VALUE) {
+                    return false;
+                }
+                {
+                    std::lock_guard< decltype(impl_->mappedViewsMutex) > lock(impl_->mappedViewsMutex);
+                    for (const auto& weakView: impl_->mappedViews) {
+                        const auto view = weakView.lock();
+                        if (view != nullptr) {
+                            std::lock_guard< decltype(view->impl_->mutex) > viewLock(view->impl_->mutex);
+                            if (view->impl_->file == handle) {
+                                view->impl_->file = newHandle;
+                            }
+                        }
+                    }
+                }
+                (void)CloseHandle(handle);
+                impl_->platform_->handle = newHandle;
+                impl_->platform_->accessFlags = accessFlags;
+                impl_->platform_->asyncFileEngineId = 0;
+                return true;
+            }
+
+            case AccessHint::WillNeed: {
+                if (
+                    impl_->platform_->directIo
+                    || (length == 0)
+                ) {
+                    return true;
+                }
+
+                // Reading the region through a temporary view brings
+                // it into the file cache without copying it anywhere.
+                const auto view = Map(offset, (size_t)length, MapMode::ReadOnly);
+                if (view == nullptr) {
+                    return false;
+                }
+                const auto result = view->Advise(AccessHint::WillNeed);
+                view->Unmap();
+                return result;
+            }
+
+            case AccessHint::DontNeed: {
+                // Windows has no way to drop a range of a file from
+                // the file cache, so the most that can be done is to
+                // give up the pages held by views of the region.
+                std::vector< std::shared_ptr< MappedView > > views;
+                {
+                    std::lock_guard< decltype(impl_->mappedViewsMutex) > lock(impl_->mappedViewsMutex);
+                    for (const auto& weakView: impl_->mappedViews) {
+                        const auto view = weakView.lock();
+                        if (view != nullptr) {
+                            views.push_back(view);
+                        }
+                    }
+                }
+                const auto end = offset + length;
+                for (const auto& view: views) {
+                    uint64_t viewOffset;
+                    uint64_t viewEnd;
+                    {
+                        std::lock_guard< decltype(view->impl_->mutex) > lock(view->impl_->mutex);
+                        viewOffset = view->impl_->offset;
+                        viewEnd = viewOffset + view->impl_->size;
+                    }
+                    const auto overlapStart = std::max(offset, viewOffset);
+                    const auto overlapEnd = std::min(end, viewEnd);
+                    if (overlapStart < overlapEnd) {
+                        (void)view->Advise(
+                            AccessHint::DontNeed,
+                            (size_t)(overlapStart - viewOffset),
+                            (size_t)(overlapEnd - overlapStart)
+                        );
+                    }
+                }
+                return true;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+    std::shared_ptr< File::MappedView > File::Map(
+        uint64_t offset,
+        size_t length,
+        MapMode mode,
+        bool hugePages
+    ) {
+        const auto handle = impl_->platform_->handle;
+        const bool writable = (mode == MapMode::SharedWritable);
+        if (
+            (handle == INVALID_HANDLE_VALUE)
+            || (
+                writable
+                && !impl_->platform_->writeAccess
+            )
+        ) {
+            return nullptr;
+        }
+        if (length == 0) {
+            const auto size = GetSize();
+            if (offset >= size) {
+                return nullptr;
+            }
+            length = (size_t)(size - offset);
+        }
+
+        // Views must start on an allocation granularity boundary,
+        // so map from the boundary before the region.
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        const auto granularity = (uint64_t)systemInfo.dwAllocationGranularity;
+        const auto mapOffset = offset - (offset % granularity);
+        const auto delta = (size_t)(offset - mapOffset);
+        const auto end = offset + length;
+        auto view = std::make_shared< MappedView >();
+        view->impl_->mapping = CreateFileMappingA(
+            handle,
+            NULL,
+            (writable ? PAGE_READWRITE : PAGE_READONLY),
+            (DWORD)(end >> 32),
+            (DWORD)end,
+            NULL
+        );
+        if (view->impl_->mapping == NULL) {
+            return nullptr;
+        }
+        view->impl_->base = MapViewOfFile(
+            view->impl_->mapping,
+            (writable ? FILE_MAP_WRITE : FILE_MAP_READ),
+            (DWORD)(mapOffset >> 32),
+            (DWORD)mapOffset,
+            delta + length
+        );
+        if (view->impl_->base == NULL) {
+            view->impl_->base = nullptr;
+            return nullptr;
+        }
+        view->impl_->file = handle;
+        view->impl_->data = (uint8_t*)view->impl_->base + delta;
+        view->impl_->size = length;
+        view->impl_->offset = offset;
+
+        // Large pages can only back pagefile sections, not views of
+        // files, so for a file the best that can be done is to fault
+        // the whole region in at once rather than page by page.
+        if (hugePages) {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = view->impl_->data;
+            range.NumberOfBytes = length;
+            (void)PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+        std::lock_guard< decltype(impl_->mappedViewsMutex) > lock(impl_->mappedViewsMutex);
+        impl_->mappedViews.erase(
+            std::remove_if(
+                impl_->mappedViews.begin(),
+                impl_->mappedViews.end(),
+                [](const std::weak_ptr< MappedView >& mappedView){ return mappedView.expired(); }
+            ),
+            impl_->mappedViews.end()
+        );
+        impl_->mappedViews.push_back(view);
+        return view;
+    }
+
 }
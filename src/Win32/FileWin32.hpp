@@ -0,0 +1,107 @@
+#ifndef SYSTEM_UTILS_FILE_WIN32_HPP
+#define SYSTEM_UTILS_FILE_WIN32_HPP
+
+/**
+ * @file FileWin32.hpp
+ *
+ * This module declares the Windows implementation of the
+ * SystemUtils::File platform structure.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <SystemUtils/File.hpp>
+
+namespace SystemUtils {
+
+    /**
+     * This is the win32-specific state for the file class
+     */
+    struct File::Platform
+    {
+        /**
+         * This is the operating-system handler to the file
+         */
+        HANDLE handle;
+
+        /**
+         * This flag indicates whether or not the file was opened
+         * with write access.
+         */
+        bool writeAccess = false;
+
+        /**
+         * This is the current position in the file.  It's kept here
+         * rather than by the operating system, because the file is
+         * opened for overlapped I/O, where every transfer gives its
+         * own offset, so that positional reads and writes from many
+         * threads can proceed at once.
+         */
+        uint64_t position = 0;
+
+        /**
+         * This flag indicates whether or not the file is read and
+         * written directly, bypassing the file cache.
+         */
+        bool directIo = false;
+
+        /**
+         * This is the size of the blocks to which reads and writes
+         * must be aligned when bypassing the file cache.
+         */
+        size_t blockSize = 0;
+
+        /**
+         * These are the flags with which the file was opened to tell
+         * the file cache how the file is expected to be accessed.
+         */
+        DWORD accessFlags = 0;
+
+        /**
+         * This identifies the asynchronous file engine with whose
+         * completion port the file handle has been associated, or is
+         * zero if none.  A handle may only ever be associated with one
+         * completion port, and it keeps that port alive even after the
+         * engine is gone.  The engine is identified by a number never
+         * reused, rather than by the handle of its port, because a new
+         * port may be given the handle value of one already closed.
+         */
+        uint64_t asyncFileEngineId = 0;
+
+        // Methods
+
+        /**
+         * This method checks that a read or write of the file
+         * meets the alignment rules of direct I/O, if the file
+         * was opened for direct I/O.
+         *
+         * @param[in] impl
+         *      These are the private properties of the file,
+         *      used to record an error if the check fails.
+         *
+         * @param[in] offset
+         *      This is the offset in the file of the transfer.
+         *
+         * @param[in] buffer
+         *      This is the memory involved in the transfer.
+         *
+         * @param[in] numBytes
+         *      This is the number of bytes to transfer.
+         *
+         * @return
+         *      An indication of whether or not the transfer
+         *      may proceed is returned.
+         */
+        bool IsAligned(
+            File::Impl& impl,
+            uint64_t offset,
+            const void* buffer,
+            size_t numBytes
+        ) const;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_FILE_WIN32_HPP */
@@ -8,7 +8,9 @@
 #include <WinSock2.h>
 #include <Windows.h>
 #include <WS2tcpip.h>
+#include <qos2.h>
 #pragma comment(lib, "ws2_32")
+#pragma comment(lib, "qwave")
 #undef ERROR
 #undef SendMessage
 #undef min
@@ -19,6 +21,7 @@
 #include <thread>
 #include <mutex>
 #include <inttypes.h>
+#include <math.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -52,6 +55,9 @@ namespace SystemUtils
         if (platform->processorStateChangeevent != NULL) {
             (void)CloseHandle(platform->processorStateChangeevent);
         }
+        if (platform->qosHandle != NULL) {
+            (void)QOSCloseHandle(platform->qosHandle);
+        }
     }
 
     NetworkConnection::Impl::Impl() 
@@ -163,6 +169,7 @@ namespace SystemUtils
             );
             return false;
         }
+        ApplyPacing();
         const auto self = shared_from_this();
         platform->processor = std::thread([self]{ self->Processor(); });
         return true;
@@ -176,6 +183,7 @@ namespace SystemUtils
         std::vector< uint8_t > buffer;
         std::unique_lock< std::recursive_mutex > processingLock(platform->processingMutex);
         bool wait = true;
+        DWORD waitTimeout = INFINITE;
         while (
             !platform->processorStop
             && (platform->socket != INVALID_SOCKET)
@@ -183,7 +191,7 @@ namespace SystemUtils
             if (wait) {
                 diagnosticsSender.SendDiagnosticInformationString(0, "processor going to sleep");
                 processingLock.unlock();
-                (void)WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+                (void)WaitForMultipleObjects(2, handles, FALSE, waitTimeout);
                 processingLock.lock();
             }
             diagnosticsSender.SendDiagnosticInformationString(0, "processor woke up");
@@ -227,45 +235,69 @@ namespace SystemUtils
             if (platform->socket == INVALID_SOCKET) {
                 break;
             }
+            waitTimeout = INFINITE;
             const auto outputQueueLength = platform->outputQueue.GetBytesQueued();
             if (outputQueueLength > 0) {
                 diagnosticsSender.SendDiagnosticInformationString(0, "processor trying to write");
-                const auto writeSize = (int)std::min(outputQueueLength, MAXIMUM_WRITE_SIZE);
-                buffer = platform->outputQueue.Peek(writeSize);
-                const int dataSent = send(platform->socket, (const char*)&buffer[0], writeSize, 0);
-                if (dataSent == SOCKET_ERROR) {
-                    const auto wsaLastError = WSAGetLastError();
-                    if (wsaLastError == WSAEWOULDBLOCK) {
-                        diagnosticsSender.SendDiagnosticInformationString(
-                            1,
-                            "connection closed abruptly by peer"
-                        );
+                const auto now = clock.GetTime();
+                double paceWait = 0.0;
+                const auto writeSize = (int)pacer.Allow(
+                    now,
+                    std::min(outputQueueLength, MAXIMUM_WRITE_SIZE),
+                    false,
+                    paceWait
+                );
+                if (writeSize == 0) {
+                    diagnosticsSender.SendDiagnosticInformationString(0, "processor holding back to keep pace");
+                    waitTimeout = (DWORD)ceil(paceWait * 1000.0);
+                } else {
+                    buffer = platform->outputQueue.Peek(writeSize);
+                    const int dataSent = send(platform->socket, (const char*)&buffer[0], writeSize, 0);
+                    if (dataSent == SOCKET_ERROR) {
+                        const auto wsaLastError = WSAGetLastError();
+                        if (wsaLastError == WSAEWOULDBLOCK) {
+                            // The send buffer is full, which happens routinely
+                            // when the operating system paces the connection.
+                            // Keep the data queued until FD_WRITE says there's
+                            // room for more.
+                            diagnosticsSender.SendDiagnosticInformationString(0, "processor waiting for room to write");
+                            wait = true;
+                        } else {
+                            diagnosticsSender.SendDiagnosticInformationFormatted(
+                                1,
+                                "connection closed abruptly by peer (%d)",
+                                wsaLastError
+                            );
+                            if (Close(CloseProcedure::ImmediateDoNotStopProcessor)) {
+                                processingLock.unlock();
+                                brokenDelegate(false);
+                                processingLock.lock();
+                            }
+                            diagnosticsSender.SendDiagnosticInformationString(0, "processor breaking due to send error");
+                            break;
+                        }
+                    } else if (dataSent > 0) {
+                        diagnosticsSender.SendDiagnosticInformationString(0, "processor wrote something ");
+                        (void)platform->outputQueue.Drop(dataSent);
+                        if (pacingPolicy.bytesPerSecond > 0.0) {
+                            pacer.Consume(now, (size_t)dataSent);
+                        }
+                        if (
+                            (dataSent == writeSize)
+                            && (platform->outputQueue.GetBytesQueued() > 0)
+                        ) {
+                            diagnosticsSender.SendDiagnosticInformationString(0, "processor has more to write");
+                            wait = false;
+                        } 
+                    } else {
                         if (Close(CloseProcedure::ImmediateDoNotStopProcessor)) {
                             processingLock.unlock();
                             brokenDelegate(false);
                             processingLock.lock();
                         }
-                        diagnosticsSender.SendDiagnosticInformationString(0, "processor breaking due to send error");
+                        diagnosticsSender.SendDiagnosticInformationString(0, "processor breaking du to send returning 0");
                         break;
                     }
-                } else if (dataSent > 0) {
-                    diagnosticsSender.SendDiagnosticInformationString(0, "processor wrote something ");
-                    (void)platform->outputQueue.Drop(dataSent);
-                    if (
-                        (dataSent == writeSize)
-                        && (platform->outputQueue.GetBytesQueued() > 0)
-                    ) {
-                        diagnosticsSender.SendDiagnosticInformationString(0, "processor has more to write");
-                        wait = false;
-                    } 
-                } else {
-                    if (Close(CloseProcedure::ImmediateDoNotStopProcessor)) {
-                        processingLock.unlock();
-                        brokenDelegate(false);
-                        processingLock.lock();
-                    }
-                    diagnosticsSender.SendDiagnosticInformationString(0, "processor breaking du to send returning 0");
-                    break;
                 }
             }
             if (
@@ -324,8 +356,70 @@ namespace SystemUtils
         return false;
     }
 
+    void NetworkConnection::Impl::SetPacing(const PacingPolicy& policy) {
+        std::lock_guard< decltype(platform->processingMutex) > processingLock(platform->processingMutex);
+        pacingPolicy = policy;
+        if (platform->socket != INVALID_SOCKET) {
+            ApplyPacing();
+        } else {
+            pacer.SetRate(pacingPolicy.bytesPerSecond, pacingPolicy.burstBytes);
+        }
+        if (platform->processorStateChangeevent != NULL) {
+            (void)SetEvent(platform->processorStateChangeevent);
+        }
+    }
+
+    void NetworkConnection::Impl::ApplyPacing() {
+        platform->RemoveFromQosFlow();
+        pacingOffloaded = false;
+        if (pacingPolicy.bytesPerSecond > 0.0) {
+            if (platform->qosHandle == NULL) {
+                QOS_VERSION version;
+                version.MajorVersion = 1;
+                version.MinorVersion = 0;
+                if (!QOSCreateHandle(&version, &platform->qosHandle)) {
+                    platform->qosHandle = NULL;
+                }
+            }
+            QOS_FLOWID flowId = 0;
+            if (
+                (platform->qosHandle != NULL)
+                && QOSAddSocketToFlow(
+                    platform->qosHandle,
+                    platform->socket,
+                    NULL,
+                    QOSTrafficTypeBestEffort,
+                    QOS_NON_ADAPTIVE_FLOW,
+                    &flowId
+                )
+            ) {
+                platform->qosFlowId = flowId;
+                QOS_FLOWRATE_OUTGOING rate;
+                rate.Bandwidth = (UINT64)(pacingPolicy.bytesPerSecond * 8.0);
+                rate.ShapingBehavior = QOSShapeOnly;
+                rate.Reason = QOSFlowRateNotApplicable;
+                if (QOSSetFlow(platform->qosHandle, flowId, QOSSetOutgoingRate, sizeof(rate), &rate, 0, NULL)) {
+                    pacingOffloaded = true;
+                }
+            }
+            if (!pacingOffloaded) {
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    1,
+                    "operating system unable to pace connection (%d); pacing in processor",
+                    (int)GetLastError()
+                );
+                platform->RemoveFromQosFlow();
+            }
+        }
+        pacer.SetRate(
+            (pacingOffloaded ? 0.0 : pacingPolicy.bytesPerSecond),
+            pacingPolicy.burstBytes
+        );
+    }
+
     void NetworkConnection::Impl::CloseImmediately() {
         platform->CloseImmediately();
+        admissionTicket = nullptr;
         diagnosticsSender.SendDiagnosticInformationString(1, "closed connection");
     }
 
@@ -368,9 +462,11 @@ namespace SystemUtils
         uint32_t boundAddress,
         uint16_t boundPort,
         uint32_t peerAddress,
-        uint16_t peerPort
+        uint16_t peerPort,
+        std::shared_ptr< void > admissionTicket
     ) {
         const auto connection = std::make_shared< NetworkConnection >();
+        connection->impl_->admissionTicket = admissionTicket;
         connection->impl_->platform->socket = sock;
         connection->impl_->boundAddress = boundAddress;
         connection->impl_->boundPort = boundPort;
@@ -380,8 +476,15 @@ namespace SystemUtils
     }
 
     void NetworkConnection::Platform::CloseImmediately() {
+        RemoveFromQosFlow();
         (void)closesocket(socket);
         socket = INVALID_SOCKET;
     }
-} // namespace SystemUtils
 
+    void NetworkConnection::Platform::RemoveFromQosFlow() {
+        if (qosFlowId != 0) {
+            (void)QOSRemoveSocketFromFlow(qosHandle, NULL, qosFlowId, 0);
+            qosFlowId = 0;
+        }
+    }
+} // namespace SystemUtils
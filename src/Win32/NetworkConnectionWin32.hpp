@@ -93,6 +93,18 @@ namespace SystemUtils {
          */
         DataQueue outputQueue;
 
+        /**
+         * This is the handle to the quality of service subsystem,
+         * used to have the operating system pace sent data.
+         */
+        HANDLE qosHandle = NULL;
+
+        /**
+         * This identifies the quality of service flow to which the
+         * socket was added for pacing, or is zero if it wasn't.
+         */
+        ULONG qosFlowId = 0;
+
         // Methods
         /**
          * This is a factory method for creating a new NetworkConnection
@@ -113,13 +125,19 @@ namespace SystemUtils {
          * 
          * @param[in] peerPort
          *      This is the port number remote peer of the connection.
+         *
+         * @param[in] admissionTicket
+         *      This is the ticket issued when the network endpoint
+         *      admitted the connection, to be held for as long as
+         *      the connection is open.
         */
         static std::shared_ptr< NetworkConnection > MakeConnectionFromExistingSocket(
             SOCKET sock,
             uint32_t boundAddress,
             uint16_t boundPort,
             uint32_t peerAddress,
-            uint16_t peerPort
+            uint16_t peerPort,
+            std::shared_ptr< void > admissionTicket
         );
 
         /**
@@ -128,6 +146,12 @@ namespace SystemUtils {
          * the connection.
         */
         void CloseImmediately();
+
+        /**
+         * This method removes the socket from the quality of service
+         * flow used to pace sent data, if it was added to one.
+         */
+        void RemoveFromQosFlow();
     };
    
 }
@@ -0,0 +1,162 @@
+/**
+ * @file NetworkEndPointGroupWin32.cpp
+ *
+ * This module contains the Windows implementation of the
+ * SystemUtils::NetworkEndPointGroup class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+/**
+ * WinSock2.h should be included first because if Windows.h is
+ * included before it, WinSock.h gets included which conflicts
+ * with WinSock2.h.
+ *
+ * Windows.h should always be included next because other Windows header
+ * files, such as KnownFolders.h, don't always define things properly if
+ * you don't include Windows.h beforhand.
+ */
+#include <WinSock2.h>
+#include <Windows.h>
+#include <WS2tcpip.h>
+#include <MSWSock.h>
+#undef ERROR
+#undef SendMessage
+#undef min
+#undef max
+
+#include <algorithm>
+
+#include "../NetworkEndPointImpl.hpp"
+#include "NetworkEndPointWin32.hpp"
+#include "NetworkEndPointGroupWin32.hpp"
+
+namespace SystemUtils {
+
+    NetworkEndPointGroup::Impl::~Impl() noexcept {
+        Stop();
+        if (wakeEvent != NULL) {
+            (void)CloseHandle(wakeEvent);
+        }
+    }
+
+    NetworkEndPointGroup::Impl::Impl() {
+        wakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (wakeEvent != NULL) {
+            processor = std::thread(&NetworkEndPointGroup::Impl::Processor, this);
+        }
+    }
+
+    bool NetworkEndPointGroup::Impl::Add(NetworkEndPoint::Impl* member) {
+        std::lock_guard< decltype(membersMutex) > lock(membersMutex);
+        if (
+            !processor.joinable()
+            || processorStop
+            || (members.size() + 1 >= MAXIMUM_WAIT_OBJECTS)
+        ) {
+            return false;
+        }
+        members.push_back(member);
+        (void)SetEvent(wakeEvent);
+        return true;
+    }
+
+    void NetworkEndPointGroup::Impl::Remove(NetworkEndPoint::Impl* member) {
+        std::lock_guard< decltype(membersMutex) > lock(membersMutex);
+        const auto entry = std::find(members.begin(), members.end(), member);
+        if (entry != members.end()) {
+            (void)members.erase(entry);
+            (void)SetEvent(wakeEvent);
+        }
+    }
+
+    void NetworkEndPointGroup::Impl::Stop() {
+        if (!processor.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard< decltype(membersMutex) > lock(membersMutex);
+            processorStop = true;
+            (void)SetEvent(wakeEvent);
+        }
+        if (std::this_thread::get_id() == processor.get_id()) {
+            processor.detach();
+        } else {
+            processor.join();
+        }
+    }
+
+    void NetworkEndPointGroup::Impl::Processor() {
+        std::vector< HANDLE > handles;
+        std::vector< NetworkEndPoint::Impl* > membersToProcess;
+        double waitTime = 0.0;
+        std::unique_lock< decltype(membersMutex) > lock(membersMutex);
+        while (!processorStop) {
+            handles.assign(1, wakeEvent);
+            for (auto member: members) {
+                handles.push_back(member->platform->socketEvent);
+            }
+            lock.unlock();
+            (void)WaitForMultipleObjects(
+                (DWORD)handles.size(),
+                handles.data(),
+                FALSE,
+                NetworkEndPoint::Platform::GetWaitTimeout(waitTime)
+            );
+            lock.lock();
+
+            // Keep going around the members until none of them
+            // has more work to do right away.  Note the soonest
+            // any member has something to do regardless.
+            bool moreWork = true;
+            while (moreWork && !processorStop) {
+                moreWork = false;
+                waitTime = 0.0;
+                membersToProcess = members;
+                for (auto member: membersToProcess) {
+                    // A delegate called for an earlier member
+                    // may have closed this one.
+                    if (std::find(members.begin(), members.end(), member) == members.end()) {
+                        continue;
+                    }
+                    std::lock_guard< decltype(member->platform->processingMutex) > processingLock(member->platform->processingMutex);
+                    bool memberMoreWork = false;
+                    bool workDone = false;
+                    if (member->ProcessNetworkTraffic(memberMoreWork, workDone)) {
+                        moreWork = moreWork || memberMoreWork;
+                        const auto memberWaitTime = member->GetWaitTime();
+                        if (
+                            (memberWaitTime > 0.0)
+                            && (
+                                (waitTime <= 0.0)
+                                || (memberWaitTime < waitTime)
+                            )
+                        ) {
+                            waitTime = memberWaitTime;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    NetworkEndPointGroup::~NetworkEndPointGroup() noexcept {
+        if (impl_ != nullptr) {
+            impl_->Stop();
+        }
+    }
+
+    NetworkEndPointGroup::NetworkEndPointGroup(NetworkEndPointGroup&&) noexcept = default;
+    NetworkEndPointGroup& NetworkEndPointGroup::operator=(NetworkEndPointGroup&&) noexcept = default;
+
+    NetworkEndPointGroup::NetworkEndPointGroup()
+        : impl_(std::make_shared< Impl >())
+    {
+    }
+
+    size_t NetworkEndPointGroup::GetMemberCount() const {
+        std::lock_guard< decltype(impl_->membersMutex) > lock(impl_->membersMutex);
+        return impl_->members.size();
+    }
+
+}
@@ -0,0 +1,109 @@
+#ifndef SYSTEM_UTILS_NETWORK_END_POINT_GROUP_WIN32_HPP
+#define SYSTEM_UTILS_NETWORK_END_POINT_GROUP_WIN32_HPP
+
+/**
+ * @file NetworkEndPointGroupWin32.hpp
+ *
+ * This module declares the Windows implementation of the
+ * SystemUtils::NetworkEndPointGroup::Impl structure.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SystemUtils/NetworkEndPoint.hpp>
+#include <SystemUtils/NetworkEndPointGroup.hpp>
+
+namespace SystemUtils {
+
+    struct NetworkEndPointGroup::Impl {
+        // Properties
+
+        /**
+         * This is the thread which performs the network
+         * processing for all members of the group.
+         */
+        std::thread processor;
+
+        /**
+         * This is an event used to wake up the worker thread if
+         * a member has new work for it, if the membership changes,
+         * or if we want the worker thread to stop.
+         */
+        HANDLE wakeEvent = NULL;
+
+        /**
+         * This flag indicates whether or not the worker thread
+         * should stop.
+         */
+        bool processorStop = false;
+
+        /**
+         * This is used to synchronize access to the members. It's held
+         * by the worker thread while it processes traffic, so that
+         * removing a member waits for any processing in progress.
+         */
+        std::recursive_mutex membersMutex;
+
+        /**
+         * These are the open endpoints whose network
+         * processing is done by the group.
+         */
+        std::vector< NetworkEndPoint::Impl* > members;
+
+        // Lifecycle management
+
+        ~Impl() noexcept;
+        Impl(const Impl&) = delete;
+        Impl(Impl&&) noexcept = delete;
+        Impl& operator=(const Impl&) = delete;
+        Impl& operator=(Impl&&) noexcept = delete;
+
+        // Methods
+
+        /**
+         * This is the instance constructor.
+         */
+        Impl();
+
+        /**
+         * This method has the group start doing the network
+         * processing for the given endpoint.
+         *
+         * @param[in] member
+         *      This is the endpoint to add to the group.
+         *
+         * @return
+         *      An indication of whether or not the endpoint
+         *      was added to the group is returned.
+         */
+        bool Add(NetworkEndPoint::Impl* member);
+
+        /**
+         * This method has the group stop doing the network processing
+         * for the given endpoint. Once it returns, the worker thread
+         * is no longer processing traffic for the endpoint.
+         *
+         * @param[in] member
+         *      This is the endpoint to remove from the group.
+         */
+        void Remove(NetworkEndPoint::Impl* member);
+
+        /**
+         * This method stops the worker thread.
+         */
+        void Stop();
+
+        /**
+         * This is the main function called for the worker thread
+         * of the group. It waits for traffic on the sockets of all
+         * members, and has each member process its own traffic.
+         */
+        void Processor();
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_NETWORK_END_POINT_GROUP_WIN32_HPP */
@@ -19,6 +19,8 @@
 #include <WinSock2.h>
 #include <Windows.h>
 #include <WS2tcpip.h>
+#include <MSWSock.h>
+#include <mstcpip.h>
 #include <iphlpapi.h>
 #pragma comment(lib, "ws2_32")
 #pragma comment(lib, "iphlpapi")
@@ -28,18 +30,21 @@
 #undef max
 
 #include <inttypes.h>
+#include <math.h>
 #include <memory>
 #include <stdint.h>
 #include <thread>
 #include <mutex>
 #include <string>
 #include <assert.h>
+#include <algorithm>
 
 #include <SystemUtils/NetworkConnection.hpp>
 #include "../NetworkConnectionImpl.hpp"
 #include "../NetworkEndPointImpl.hpp"
 #include "NetworkEndPointWin32.hpp"
 #include "NetworkConnectionWin32.hpp"
+#include "NetworkEndPointGroupWin32.hpp"
 
 namespace {
 
@@ -49,11 +54,356 @@ namespace {
     */
    constexpr size_t MAXIMUM_READ_SIZE = 65536;
 
+    /**
+     * This is the number of datagrams the send queue
+     * holds unless configured otherwise.
+     */
+   constexpr size_t DEFAULT_SEND_QUEUE_CAPACITY = 1024;
+
+    /**
+     * This is the MTU assumed for the local host if none of its
+     * network interfaces report one (standard Ethernet).
+     */
+   constexpr size_t DEFAULT_MTU = 1500;
+
+    /**
+     * This is the number of released receive buffers kept
+     * for reuse by each endpoint.
+     */
+   constexpr size_t RECEIVE_BUFFERS_POOLED = 64;
+
+    /**
+     * This function returns the largest MTU of the active
+     * network interfaces on the local host, not counting loopback
+     * interfaces, whose MTU is not limited by any real link.
+     *
+     * @return
+     *      The largest MTU of the active network interfaces
+     *      on the local host is returned.
+     */
+    size_t GetMaximumInterfaceMtu() {
+        std::vector< uint8_t > buffer(15 * 1024);
+        ULONG bufferSize = (ULONG)buffer.size();
+        const ULONG flags = (
+            GAA_FLAG_SKIP_UNICAST
+            | GAA_FLAG_SKIP_ANYCAST
+            | GAA_FLAG_SKIP_MULTICAST
+            | GAA_FLAG_SKIP_DNS_SERVER
+        );
+        ULONG result = GetAdaptersAddresses(AF_INET, flags, NULL, (PIP_ADAPTER_ADDRESSES)&buffer[0], &bufferSize);
+        if (result == ERROR_BUFFER_OVERFLOW) {
+            buffer.resize(bufferSize);
+            result = GetAdaptersAddresses(AF_INET, flags, NULL, (PIP_ADAPTER_ADDRESSES)&buffer[0], &bufferSize);
+        }
+        size_t mtu = 0;
+        if (result == ERROR_SUCCESS) {
+            for (
+                PIP_ADAPTER_ADDRESSES adapter = (PIP_ADAPTER_ADDRESSES)&buffer[0];
+                adapter != NULL;
+                adapter = adapter->Next
+            ) {
+                if (
+                    (adapter->OperStatus != IfOperStatusUp)
+                    || (adapter->IfType == IF_TYPE_SOFTWARE_LOOPBACK)
+                ) {
+                    continue;
+                }
+                mtu = std::max(mtu, (size_t)adapter->Mtu);
+            }
+        }
+        if (mtu == 0) {
+            mtu = DEFAULT_MTU;
+        }
+        return std::min(mtu, MAXIMUM_READ_SIZE);
+    }
+
+
+    /**
+     * This function queries the operating system for the IPv4
+     * addresses of all active network interfaces on the local host.
+     *
+     * @return
+     *      The IPv4 addresses of all active network interfaces on
+     *      the local host are returned.
+     */
+    std::vector< uint32_t > QueryInterfaceAddresses() {
+        //Start up winSock library.
+        bool wsaStarted = false;
+        WSADATA wsaData;
+        if (!WSAStartup(MAKEWORD(2, 0), &wsaData)) {
+            wsaStarted = true;
+        }
+
+        // Get address of all networ adapters.
+        //
+        // Recommendation of 15KB pre-allocated buffer from:
+        // https://msdn.microsoft.com/en-us/library/aa365915%28v=vs.85%29.aspx
+        std::vector <uint8_t > buffer(15 * 1024);
+        ULONG bufferSize = (ULONG)buffer.size();
+        ULONG result = GetAdaptersAddresses(AF_INET, 0, NULL, (PIP_ADAPTER_ADDRESSES)&buffer[0], &bufferSize);
+        if (result == ERROR_BUFFER_OVERFLOW) {
+            buffer.resize(bufferSize);
+            result = GetAdaptersAddresses(AF_INET, 0, NULL, (PIP_ADAPTER_ADDRESSES)&buffer[0], &bufferSize);
+        }
+        std::vector< uint32_t > addresses;
+        if (result == ERROR_SUCCESS) {
+            for (
+                PIP_ADAPTER_ADDRESSES adapter = (PIP_ADAPTER_ADDRESSES)&buffer[0];
+                adapter != NULL;
+                adapter = adapter->Next
+            ) {
+                if (adapter->OperStatus != IfOperStatusUp) {
+                    continue;
+                }
+                for (
+                    PIP_ADAPTER_UNICAST_ADDRESS unicastAddress = adapter->FirstUnicastAddress;
+                    unicastAddress != NULL;
+                    unicastAddress= unicastAddress->Next
+                ) {
+                    struct  sockaddr_in* ipAddress = (struct sockaddr_in*)unicastAddress->Address.lpSockaddr;
+                    addresses.push_back(ntohl(ipAddress->sin_addr.S_un.S_addr));
+                }
+            }
+        }
+
+        if (wsaStarted) {
+            (void)WSACleanup();
+        }
+
+        return addresses;
+    }
+
+    /**
+     * This holds the process-wide cache of local network interface
+     * addresses, along with the operating system notification
+     * registration which tells the cache when they change.
+     */
+    struct InterfaceAddressMonitor {
+        /**
+         * This remembers the local network interface addresses.
+         */
+        SystemUtils::InterfaceAddressCache cache;
+
+        /**
+         * This is the operating system handle to the registration
+         * for notifications of changes to unicast IP addresses.
+         * If NULL, registration failed, and the cache can't be trusted.
+         */
+        HANDLE notificationHandle = NULL;
+
+        InterfaceAddressMonitor()
+            : cache(QueryInterfaceAddresses)
+        {
+            if (
+                NotifyUnicastIpAddressChange(
+                    AF_INET,
+                    AddressChanged,
+                    &cache,
+                    FALSE,
+                    &notificationHandle
+                ) != NO_ERROR
+            ) {
+                notificationHandle = NULL;
+            }
+        }
+
+        ~InterfaceAddressMonitor() noexcept {
+            if (notificationHandle != NULL) {
+                (void)CancelMibChangeNotify2(notificationHandle);
+            }
+        }
+
+        /**
+         * This is called by the operating system whenever a unicast
+         * IP address is added to, removed from, or changed on any
+         * network interface of the local host.
+         */
+        static VOID NETIOAPI_API_ AddressChanged(
+            PVOID context,
+            PMIB_UNICASTIPADDRESS_ROW,
+            MIB_NOTIFICATION_TYPE
+        ) {
+            ((SystemUtils::InterfaceAddressCache*)context)->Invalidate();
+        }
+    };
+
+    /**
+     * This function returns the process-wide cache of local
+     * network interface addresses, setting it up on first use.
+     *
+     * @return
+     *      The process-wide cache of local network interface
+     *      addresses is returned.
+     */
+    InterfaceAddressMonitor& GetInterfaceAddressMonitor() {
+        static InterfaceAddressMonitor monitor;
+        return monitor;
+    }
+
+
+    /**
+     * This holds what the accept condition function needs to decide
+     * whether or not to admit an incoming connection, and what it
+     * decided.
+     */
+    struct AdmissionContext {
+        /**
+         * This decides which incoming connections are admitted.
+         */
+        SystemUtils::AdmissionController* admissionController = nullptr;
+
+        /**
+         * This is the current time, in seconds.
+         */
+        double now = 0.0;
+
+        /**
+         * This is the decision made about the incoming connection.
+         */
+        SystemUtils::AdmissionController::Verdict verdict = SystemUtils::AdmissionController::Verdict::Admitted;
+
+        /**
+         * This is the ticket to be held by the connection
+         * for as long as it's open, if it's admitted.
+         */
+        SystemUtils::AdmissionController::Ticket ticket;
+    };
+
+    /**
+     * This is called by WSAAccept to decide whether or not to accept
+     * an incoming connection, before the connection is established
+     * if the socket has the SO_CONDITIONAL_ACCEPT option set.
+     */
+    int CALLBACK AdmitConnection(
+        LPWSABUF callerId,
+        LPWSABUF,
+        LPQOS,
+        LPQOS,
+        LPWSABUF,
+        LPWSABUF,
+        GROUP FAR*,
+        DWORD_PTR callbackData
+    ) {
+        const auto context = (AdmissionContext*)callbackData;
+        const auto peerAddress = (const struct sockaddr_in*)callerId->buf;
+        context->verdict = context->admissionController->Admit(
+            ntohl(peerAddress->sin_addr.S_un.S_addr),
+            context->now,
+            context->ticket
+        );
+        return (
+            (context->verdict == SystemUtils::AdmissionController::Verdict::Admitted)
+            ? CF_ACCEPT
+            : CF_REJECT
+        );
+    }
+
+    /**
+     * This is what's sent over the hand-off pipe to give an open
+     * endpoint socket to another process.
+     */
+    struct HandOffRecord {
+        /**
+         * This describes the duplicate of the socket
+         * made for the receiving process.
+         */
+        WSAPROTOCOL_INFOW protocolInfo;
+
+        /**
+         * This is the mode of the endpoint.
+         */
+        uint32_t mode;
+
+        /**
+         * This is the IPv4 address bound by the endpoint.
+         */
+        uint32_t localAddress;
+
+        /**
+         * This is the multicast group address of the endpoint.
+         */
+        uint32_t groupAddress;
+
+        /**
+         * This is the port number bound by the endpoint.
+         */
+        uint16_t port;
+    };
+
+    /**
+     * This function returns the name of the pipe over which
+     * endpoint sockets are handed off to the given process.
+     *
+     * @param[in] processId
+     *      This is the identifier of the process receiving sockets.
+     *
+     * @return
+     *      The name of the pipe over which endpoint sockets are
+     *      handed off to the given process is returned.
+     */
+    std::string GetHandOffPipeName(unsigned int processId) {
+        return "\\\\.\\pipe\\SystemUtils-handoff-" + std::to_string(processId);
+    }
+
+    /**
+     * This function waits for an overlapped operation on the given
+     * handle to complete, cancelling it if it takes too long.
+     *
+     * @param[in] handle
+     *      This is the handle on which the operation was started.
+     *
+     * @param[in] started
+     *      This is what the function starting the operation returned.
+     *
+     * @param[in] overlapped
+     *      This is the structure used to start the operation.
+     *
+     * @param[in] timeout
+     *      This is the longest time, in milliseconds, to wait.
+     *
+     * @param[out] amount
+     *      This is where to store the number of bytes transferred.
+     *
+     * @return
+     *      An indication of whether or not the operation
+     *      completed successfully is returned.
+     */
+    bool AwaitOverlapped(
+        HANDLE handle,
+        BOOL started,
+        OVERLAPPED& overlapped,
+        DWORD timeout,
+        DWORD& amount
+    ) {
+        amount = 0;
+        if (!started) {
+            const auto error = GetLastError();
+            if (error == ERROR_PIPE_CONNECTED) {
+                return true;
+            }
+            if (error != ERROR_IO_PENDING) {
+                return false;
+            }
+        }
+        if (WaitForSingleObject(overlapped.hEvent, timeout) != WAIT_OBJECT_0) {
+            (void)CancelIoEx(handle, &overlapped);
+            (void)GetOverlappedResult(handle, &overlapped, &amount, TRUE);
+            return false;
+        }
+        return (GetOverlappedResult(handle, &overlapped, &amount, FALSE) != FALSE);
+    }
 }
 
 namespace SystemUtils {
 
-    NetworkEndPoint::Impl::Impl() : platform( new Platform()), diagnosticsSender("NetworkEndPoint")
+    NetworkEndPoint::Impl::Impl()
+        : platform( new Platform())
+        , diagnosticsSender("NetworkEndPoint")
+        , outputQueue(new MpscQueue< Packet >(DEFAULT_SEND_QUEUE_CAPACITY))
+        , packetsDropped(0)
+        , sendQueueCapacity(DEFAULT_SEND_QUEUE_CAPACITY)
+        , packetsTruncated(0)
+        , interfacesChanged(false)
     {
         WSADATA wsaData;
         if (!WSAStartup(MAKEWORD(2, 0), &wsaData)) {
@@ -102,9 +452,9 @@ namespace SystemUtils {
                     "error setting socket option IP_MULTICAST_IF (%d)",
                     WSAGetLastError()
                 );
-            }
                 Close(false);
                 return false;
+            }
         } else {
             struct sockaddr_in socketAddress;
             (void)memset(&socketAddress, 0, sizeof(socketAddress));
@@ -136,23 +486,10 @@ namespace SystemUtils {
                 return false;
             }
             if (mode == NetworkEndPoint::Mode::MulticastReceive) {
-                for (auto localAddress: NetworkEndPoint::GetInterfaceAddresses()) {
-                    struct  ip_mreq multicastGroup;
-                    multicastGroup.imr_multiaddr.S_un.S_addr = htonl(groupAddress);
-                    multicastGroup.imr_interface.S_un.S_addr = htonl(localAddress);
-                    if (setsockopt(platform->socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&multicastGroup, sizeof(multicastGroup)) == SOCKET_ERROR) {
-                        diagnosticsSender.SendDiagnosticInformationFormatted(
-                            SystemUtils::DiagnosticsSender::Levels::ERROR,
-                            "error setting socket option IP_ADD_MEMBERSHIP (%d) for local interface %" PRIu8 ".%" PRIu8 ".%" PRIu8 ".%" PRIu8,
-                            WSAGetLastError(),
-                            (uint8_t)((localAddress >> 24) & 0xFF),
-                            (uint8_t)((localAddress >> 16) & 0xFF),
-                            (uint8_t)((localAddress >> 8) & 0xFF),
-                            (uint8_t)(localAddress & 0xFF)
-                        );
-                        Close(false);
-                        return false;
-                    }                      
+                platform->joinedInterfaces.clear();
+                if (!JoinMulticastGroup()) {
+                    Close(false);
+                    return false;
                 }
             } else {
                 int socketAddressLength = sizeof(socketAddress);
@@ -171,6 +508,31 @@ namespace SystemUtils {
             }
         }
 
+        if (mode == NetworkEndPoint::Mode::Connection) {
+            if (admissionController.IsLimited()) {
+                BOOL option = TRUE;
+                if (setsockopt(platform->socket, SOL_SOCKET, SO_CONDITIONAL_ACCEPT, (const char*)&option, sizeof(option)) == SOCKET_ERROR) {
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::WARNING,
+                        "error setting socket option SO_CONDITIONAL_ACCEPT (%d)",
+                        WSAGetLastError()
+                    );
+                }
+            }
+            if (listen(platform->socket, SOMAXCONN) != 0) {
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    SystemUtils::DiagnosticsSender::Levels::ERROR,
+                    "error in listen (%d)",
+                    WSAGetLastError()
+                );
+                Close(false);
+                return false;
+            }
+        }
+        return StartProcessing();
+    }
+
+    bool NetworkEndPoint::Impl::StartProcessing() {
         // Prepare events used in processing.
         if (platform->processorStateChangeevent == NULL) {
             platform->processorStateChangeevent = CreateEvent(NULL, FALSE, FALSE, NULL);
@@ -187,6 +549,21 @@ namespace SystemUtils {
             (void)ResetEvent(platform->processorStateChangeevent);
         }
         platform->processorStop = false;
+        platform->wakeEvent = (
+            (group == nullptr)
+            ? platform->processorStateChangeevent
+            : group->wakeEvent
+        );
+        if (mode == NetworkEndPoint::Mode::MulticastReceive) {
+            interfacesChanged = false;
+            const auto wakeEvent = platform->wakeEvent;
+            unsubscribeFromInterfaceChanges = GetInterfaceAddressMonitor().cache.Subscribe(
+                [this, wakeEvent]{
+                    interfacesChanged = true;
+                    (void)SetEvent(wakeEvent);
+                }
+            );
+        }
         if (platform->socketEvent == NULL) {
             platform->socketEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
             if (platform->socketEvent == NULL) {
@@ -215,6 +592,58 @@ namespace SystemUtils {
         ) {
             socketEvents |= FD_WRITE;
         }
+        platform->recvMsg = NULL;
+        platform->timestampScale = 0.0;
+        if (
+            (timestampedPacketReceivedDelegate != nullptr)
+            && (
+                (mode == NetworkEndPoint::Mode::Datagram)
+                || (mode == NetworkEndPoint::Mode::MulticastReceive)
+            )
+        ) {
+            GUID recvMsgId = WSAID_WSARECVMSG;
+            DWORD bytesReturned = 0;
+            TIMESTAMPING_CONFIG timestampingConfig;
+            (void)memset(&timestampingConfig, 0, sizeof(timestampingConfig));
+            timestampingConfig.Flags = TIMESTAMPING_FLAG_RX;
+            if (
+                WSAIoctl(
+                    platform->socket,
+                    SIO_GET_EXTENSION_FUNCTION_POINTER,
+                    &recvMsgId, sizeof(recvMsgId),
+                    &platform->recvMsg, sizeof(platform->recvMsg),
+                    &bytesReturned,
+                    NULL, NULL
+                ) == SOCKET_ERROR
+            ) {
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    SystemUtils::DiagnosticsSender::Levels::WARNING,
+                    "error getting WSARecvMsg (%d); datagrams will be timestamped when read",
+                    WSAGetLastError()
+                );
+                platform->recvMsg = NULL;
+            } else if (
+                WSAIoctl(
+                    platform->socket,
+                    SIO_TIMESTAMPING,
+                    &timestampingConfig, sizeof(timestampingConfig),
+                    NULL, 0,
+                    &bytesReturned,
+                    NULL, NULL
+                ) == SOCKET_ERROR
+            ) {
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    SystemUtils::DiagnosticsSender::Levels::WARNING,
+                    "error in SIO_TIMESTAMPING (%d); datagrams will be timestamped when read",
+                    WSAGetLastError()
+                );
+                platform->recvMsg = NULL;
+            } else {
+                LARGE_INTEGER frequency;
+                (void)QueryPerformanceFrequency(&frequency);
+                platform->timestampScale = 1.0 / (double)frequency.QuadPart;
+            }
+        }
         if (WSAEventSelect(platform->socket, platform->socketEvent, socketEvents) != 0) {
             diagnosticsSender.SendDiagnosticInformationFormatted(
                 SystemUtils::DiagnosticsSender::Levels::ERROR,
@@ -225,164 +654,370 @@ namespace SystemUtils {
             return false;
         }
 
-        if (mode == NetworkEndPoint::Mode::Connection) {
-            if (listen(platform->socket, SOMAXCONN) != 0) {
-                diagnosticsSender.SendDiagnosticInformationFormatted(
-                    SystemUtils::DiagnosticsSender::Levels::ERROR,
-                    "error in listen (%d)",
-                    WSAGetLastError()
-                );
-                Close(false);
-                return false;
-            }
+        if (
+            (mode == NetworkEndPoint::Mode::Datagram)
+            || (mode == NetworkEndPoint::Mode::MulticastReceive)
+        ) {
+            receiveBufferPool.reset(
+                new BufferPool(
+                    largeDatagrams ? MAXIMUM_READ_SIZE : GetMaximumInterfaceMtu(),
+                    RECEIVE_BUFFERS_POOLED
+                )
+            );
+            workerReceiveBuffer.resize(receiveBufferPool->GetBufferSize());
         }
+        workerPacket.body.reset();
+        workerPacketPending = false;
         diagnosticsSender.SendDiagnosticInformationFormatted(
             0,
             "endpoint opened for port %" PRIu16,
             port
         );
-        platform->processor = std::move(std::thread(&NetworkEndPoint::Impl::Processor, this));
+        if (group == nullptr) {
+            platform->processor = std::move(std::thread(&NetworkEndPoint::Impl::Processor, this));
+        } else {
+            if (!group->Add(this)) {
+                diagnosticsSender.SendDiagnosticInformationString(
+                    SystemUtils::DiagnosticsSender::Levels::ERROR,
+                    "endpoint group is full or no longer running"
+                );
+                Close(false);
+                return false;
+            }
+            platform->activeGroup = group;
+        }
         return true;
     }
 
     void NetworkEndPoint::Impl::Processor() {
         const HANDLE handles[2] = { platform->processorStateChangeevent, platform->socketEvent };
-        std::vector< uint8_t > buffer;
+        if (processorCore >= 0) {
+            // Cores are numbered across all processor groups, so find
+            // the group holding the core, and pin the thread within it.
+            const auto numGroups = GetActiveProcessorGroupCount();
+            auto core = (DWORD)processorCore;
+            WORD group = 0;
+            while (
+                (group < numGroups)
+                && (core >= GetActiveProcessorCount(group))
+            ) {
+                core -= GetActiveProcessorCount(group);
+                ++group;
+            }
+            if (group == numGroups) {
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    SystemUtils::DiagnosticsSender::Levels::WARNING,
+                    "no processor core %d to pin processor to",
+                    processorCore
+                );
+            } else {
+                GROUP_AFFINITY affinity;
+                ZeroMemory(&affinity, sizeof(affinity));
+                affinity.Group = group;
+                affinity.Mask = (KAFFINITY)1 << core;
+                if (SetThreadGroupAffinity(GetCurrentThread(), &affinity, NULL) == 0) {
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::WARNING,
+                        "error pinning processor to core %d (%d)",
+                        processorCore,
+                        (int)GetLastError()
+                    );
+                }
+            }
+        }
         std::unique_lock< std::recursive_mutex > processingLock(platform->processingMutex);
         bool wait = true;
+        bool moreWork = false;
+        bool active = false;
+        bool spinning = false;
+        double spinStart = 0.0;
         while (!platform->processorStop) {
+            if (active) {
+                if (spinning) {
+                    const auto spinTime = clock.GetTime() - spinStart;
+                    std::lock_guard< decltype(busyPollStatisticsMutex) > lock(busyPollStatisticsMutex);
+                    ++busyPollStatistics.spinWakeups;
+                    busyPollStatistics.spinTime += spinTime;
+                    spinning = false;
+                }
+                active = false;
+            }
             if (wait) {
+                bool block = true;
+                if (busyPollBudget > 0.0) {
+                    // Poll the socket again rather than block, unless
+                    // it has stayed idle for the whole spin budget.
+                    const auto now = clock.GetTime();
+                    if (!spinning) {
+                        spinning = true;
+                        spinStart = now;
+                    }
+                    if (now - spinStart < busyPollBudget) {
+                        block = false;
+                    } else {
+                        std::lock_guard< decltype(busyPollStatisticsMutex) > lock(busyPollStatisticsMutex);
+                        busyPollStatistics.spinTime += now - spinStart;
+                        spinning = false;
+                    }
+                }
                 processingLock.unlock();
-                (void)WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+                if (block) {
+                    const auto sleepStart = clock.GetTime();
+                    (void)WaitForMultipleObjects(2, handles, FALSE, NetworkEndPoint::Platform::GetWaitTimeout(GetWaitTime()));
+                    const auto sleepTime = clock.GetTime() - sleepStart;
+                    std::lock_guard< decltype(busyPollStatisticsMutex) > lock(busyPollStatisticsMutex);
+                    ++busyPollStatistics.sleeps;
+                    busyPollStatistics.sleepTime += sleepTime;
+                } else {
+                    YieldProcessor();
+                }
                 processingLock.lock();
             }
-            wait = true;
-            buffer.resize(MAXIMUM_READ_SIZE);
-            struct sockaddr_in peerAddress;
-            int peerAddressSize = sizeof(peerAddress);
-            if (mode == NetworkEndPoint::Mode::Connection) {
-                const SOCKET client = accept(platform->socket, (struct sockaddr*)&peerAddress, &peerAddressSize);
-                if (client == INVALID_SOCKET) {
-                    const auto wsaLastError = WSAGetLastError();
-                    if (wsaLastError != WSAEWOULDBLOCK) {
-                        diagnosticsSender.SendDiagnosticInformationFormatted(
-                            SystemUtils::DiagnosticsSender::Levels::WARNING,
-                            "error in accept (%d)",
-                            WSAGetLastError()
-                        );
+            if (!ProcessNetworkTraffic(moreWork, active)) {
+                break;
+            }
+            wait = !moreWork;
+        }
+    }
+
+    bool NetworkEndPoint::Impl::ProcessNetworkTraffic(
+        bool& moreWork,
+        bool& workDone
+    ) {
+        moreWork = false;
+        workDone = false;
+        paceWait = 0.0;
+        if (interfacesChanged.exchange(false)) {
+            (void)JoinMulticastGroup();
+        }
+        if (
+            (newSessionDelegate != nullptr)
+            && (sessionIdleTimeout > 0.0)
+        ) {
+            EndIdleSessions(clock.GetTime());
+        }
+        struct sockaddr_in peerAddress;
+        int peerAddressSize = sizeof(peerAddress);
+        if (mode == NetworkEndPoint::Mode::Connection) {
+            AdmissionContext admissionContext;
+            admissionContext.admissionController = &admissionController;
+            admissionContext.now = clock.GetTime();
+            const SOCKET client = WSAAccept(
+                platform->socket,
+                (struct sockaddr*)&peerAddress,
+                &peerAddressSize,
+                AdmitConnection,
+                (DWORD_PTR)&admissionContext
+            );
+            if (client == INVALID_SOCKET) {
+                const auto wsaLastError = WSAGetLastError();
+                if (wsaLastError == WSAECONNREFUSED) {
+                    // The connection was refused by admission control;
+                    // look for more waiting to be accepted.
+                    moreWork = true;
+                    workDone = true;
+                } else if (wsaLastError != WSAEWOULDBLOCK) {
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::WARNING,
+                        "error in accept (%d)",
+                        WSAGetLastError()
+                    );
+                }
+            } else {
+                LINGER linger;
+                linger.l_onoff = 1;
+                linger.l_linger = 0;
+                (void)setsockopt(client, SOL_SOCKET, SO_LINGER, (const char*)&linger, sizeof(linger));
+                uint32_t boundIPv4Address = 0;
+                uint16_t boundPort = 0;
+                struct  sockaddr_in boundAddress;
+                int boundAddressSize = sizeof(boundAddress);
+                if (getsockname(client, (struct sockaddr*)&boundAddress, &boundAddressSize) == 0) {
+                    boundIPv4Address = ntohl(boundAddress.sin_addr.S_un.S_addr);
+                    boundPort = ntohs(boundAddress.sin_port);
+                }
+                auto connection = NetworkConnection::Platform::MakeConnectionFromExistingSocket(
+                    client,
+                    boundIPv4Address,
+                    boundPort,
+                    ntohl(peerAddress.sin_addr.S_un.S_addr),
+                    ntohs(peerAddress.sin_port),
+                    std::move(admissionContext.ticket)
+                );
+                newConnectionDelegate(connection);
+                moreWork = true;
+                workDone = true;
+            } 
+        } else if (
+            (mode == NetworkEndPoint::Mode::Datagram)
+            || (mode == NetworkEndPoint::Mode::MulticastReceive)
+        ) {
+            int dataReceived = SOCKET_ERROR;
+            double receiveTime = 0.0;
+            if (platform->recvMsg != NULL) {
+                char control[WSA_CMSG_SPACE(sizeof(UINT64))];
+                WSABUF dataBuffer;
+                dataBuffer.buf = (CHAR*)workerReceiveBuffer.data();
+                dataBuffer.len = (ULONG)workerReceiveBuffer.size();
+                WSAMSG message;
+                (void)memset(&message, 0, sizeof(message));
+                message.name = (LPSOCKADDR)&peerAddress;
+                message.namelen = peerAddressSize;
+                message.lpBuffers = &dataBuffer;
+                message.dwBufferCount = 1;
+                message.Control.buf = control;
+                message.Control.len = sizeof(control);
+                DWORD bytesReceived = 0;
+                if (platform->recvMsg(platform->socket, &message, &bytesReceived, NULL, NULL) == 0) {
+                    if ((message.dwFlags & MSG_TRUNC) != 0) {
+                        WSASetLastError(WSAEMSGSIZE);
+                    } else {
+                        dataReceived = (int)bytesReceived;
                     }
-                } else {
-                    LINGER linger;
-                    linger.l_onoff = 1;
-                    linger.l_linger = 0;
-                    (void)setsockopt(client, SOL_SOCKET, SO_LINGER, (const char*)&linger, sizeof(linger));
-                    uint32_t boundIPv4Address = 0;
-                    uint16_t boundPort = 0;
-                    struct  sockaddr_in boundAddress;
-                    int boundAddressSize = sizeof(boundAddress);
-                    if (getsockname(client, (struct sockaddr*)&boundAddress, &boundAddressSize) == 0) {
-                        boundIPv4Address = ntohl(boundAddress.sin_addr.S_un.S_addr);
-                        boundPort = ntohs(boundAddress.sin_port);
+                    receiveTime = clock.GetTime();
+                    for (
+                        LPWSACMSGHDR header = WSA_CMSG_FIRSTHDR(&message);
+                        header != NULL;
+                        header = WSA_CMSG_NXTHDR(&message, header)
+                    ) {
+                        if (
+                            (header->cmsg_level == SOL_SOCKET)
+                            && (header->cmsg_type == SO_TIMESTAMP)
+                        ) {
+                            receiveTime = (double)*(PUINT64)WSA_CMSG_DATA(header) * platform->timestampScale;
+                        }
                     }
-                    auto connection = NetworkConnection::Platform::MakeConnectionFromExistingSocket(
-                        client,
-                        boundIPv4Address,
-                        boundPort,
-                        ntohl(peerAddress.sin_addr.S_un.S_addr),
-                        ntohs(peerAddress.sin_port)
-                    );
-                    newConnectionDelegate(connection);
-                } 
-            } else if (
-                (mode == NetworkEndPoint::Mode::Datagram)
-                || (mode == NetworkEndPoint::Mode::MulticastReceive)
-            ) {
-                const int dataReceived = recvfrom(
+                }
+            } else {
+                dataReceived = recvfrom(
                     platform->socket,
-                    (char*)&buffer[0],
-                    (int)buffer.size(),
+                    (char*)workerReceiveBuffer.data(),
+                    (int)workerReceiveBuffer.size(),
                     0,
                     (struct sockaddr*)&peerAddress,
                     &peerAddressSize
                 );
-                if (dataReceived == SOCKET_ERROR) {
-                    const auto errorCode = WSAGetLastError();
-                    if (errorCode != WSAEWOULDBLOCK) {
-                        diagnosticsSender.SendDiagnosticInformationFormatted(
-                            SystemUtils::DiagnosticsSender::Levels::ERROR,
-                            "error in recvfrom (%d)",
-                            WSAGetLastError()
-                        );
-                        Close(false);
-                        break;
-                    }
-                } else if (dataReceived > 0) {
-                    buffer.resize(dataReceived);
-                    packetReceivedDelegate(
-                        ntohl(peerAddress.sin_addr.S_un.S_addr),
-                        ntohs(peerAddress.sin_port),
-                        buffer
-                    );
+                if (timestampedPacketReceivedDelegate != nullptr) {
+                    receiveTime = clock.GetTime();
                 }
             }
-            if (!platform->outputQueue.empty()) {
-                NetworkEndPoint::Platform::Packet& packet = platform->outputQueue.front();
-                (void)memset(&peerAddress, 0, sizeof(peerAddress));
-                peerAddress.sin_family = AF_INET;
-                peerAddress.sin_addr.S_un.S_addr = htonl(packet.address);
-                peerAddress.sin_port = htons(packet.port);
-                const int amountSent = sendto(
-                    platform->socket,
-                    (const char*)&packet.body[0],
-                    (int)packet.body.size(),
-                    0,
-                    (const sockaddr*)&peerAddress,
-                    sizeof(peerAddress)
+            if (dataReceived == SOCKET_ERROR) {
+                const auto errorCode = WSAGetLastError();
+                if (errorCode == WSAEMSGSIZE) {
+                    (void)packetsTruncated.fetch_add(1, std::memory_order_relaxed);
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::WARNING,
+                        "datagram discarded for being larger than %zu bytes",
+                        workerReceiveBuffer.size()
+                    );
+                    moreWork = true;
+                } else if (errorCode != WSAEWOULDBLOCK) {
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::ERROR,
+                        "error receiving datagram (%d)",
+                        WSAGetLastError()
+                    );
+                    Close(false);
+                    return false;
+                }
+            } else if (dataReceived > 0) {
+                DeliverPacket(
+                    ntohl(peerAddress.sin_addr.S_un.S_addr),
+                    ntohs(peerAddress.sin_port),
+                    receiveBufferPool->Acquire(workerReceiveBuffer.data(), (size_t)dataReceived),
+                    receiveTime
                 );
-                if (amountSent == SOCKET_ERROR) {
-                    const auto errorCode = WSAGetLastError();
-                    if (errorCode != WSAEWOULDBLOCK ) {
-                        diagnosticsSender.SendDiagnosticInformationFormatted(
-                            SystemUtils::DiagnosticsSender::Levels::ERROR,
-                            "error in sendto (%d)",
-                            WSAGetLastError()
-                        );
-                        Close(false);
-                        break;
-                    }
-                } else {
-                    if (amountSent != (int)packet.body.size()) {
-                        diagnosticsSender.SendDiagnosticInformationFormatted(
-                            SystemUtils::DiagnosticsSender::Levels::ERROR,
-                            "send truncatted (%d < %d)",
-                            amountSent,
-                            (int)packet.body.size()
-                        );   
-                    }
-                    platform->outputQueue.pop_front();
-                    if (!platform->outputQueue.empty()) {
-                        wait = false;
-                    }
+                workDone = true;
+            }
+        }
+        if (!workerPacketPending) {
+            workerPacketPending = TakeNextPacket();
+        }
+        const bool pacing = pacingEnabled;
+        double now = 0.0;
+        if (
+            workerPacketPending
+            && pacing
+        ) {
+            now = clock.GetTime();
+            if (pacer.Allow(now, workerPacket.body->size(), true, paceWait) == 0) {
+                return true;
+            }
+        }
+        if (workerPacketPending) {
+            (void)memset(&peerAddress, 0, sizeof(peerAddress));
+            peerAddress.sin_family = AF_INET;
+            peerAddress.sin_addr.S_un.S_addr = htonl(workerPacket.address);
+            peerAddress.sin_port = htons(workerPacket.port);
+            const auto& body = *workerPacket.body;
+            const int amountSent = sendto(
+                platform->socket,
+                (const char*)body.data(),
+                (int)body.size(),
+                0,
+                (const sockaddr*)&peerAddress,
+                sizeof(peerAddress)
+            );
+            if (amountSent == SOCKET_ERROR) {
+                const auto errorCode = WSAGetLastError();
+                if (errorCode != WSAEWOULDBLOCK ) {
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::ERROR,
+                        "error in sendto (%d)",
+                        WSAGetLastError()
+                    );
+                    Close(false);
+                    return false;
+                }
+            } else {
+                if (amountSent != (int)body.size()) {
+                    diagnosticsSender.SendDiagnosticInformationFormatted(
+                        SystemUtils::DiagnosticsSender::Levels::ERROR,
+                        "send truncatted (%d < %d)",
+                        amountSent,
+                        (int)body.size()
+                    );   
+                }
+                if (pacing) {
+                    pacer.Consume(now, (size_t)amountSent);
+                }
+                workerPacket.body.reset();
+                workerPacketPending = false;
+                workDone = true;
+                if (HasMoreOutput()) {
+                    moreWork = true;
                 }
             }
         }
+        return true;
     }
 
     void NetworkEndPoint::Impl::SendPacket(
         uint32_t address,
         uint16_t port,
-        const std::vector< uint8_t >& body
+        SharedBuffer body
     ) {
-        std::unique_lock< std::recursive_mutex > processingLock(platform->processingMutex);
-        NetworkEndPoint::Platform::Packet packet;
+        Packet packet;
         packet.address = address;
         packet.port = port;
-        packet.body = body;
-        platform->outputQueue.push_back(std::move(packet));
-        (void)SetEvent(platform->processorStateChangeevent);
+        packet.body = std::move(body);
+        if (EnqueuePacket(std::move(packet))) {
+            (void)SetEvent(platform->wakeEvent);
+        }
     }
 
     void NetworkEndPoint::Impl::Close(bool stopProcessing) {
+        if (unsubscribeFromInterfaceChanges != nullptr) {
+            unsubscribeFromInterfaceChanges();
+            unsubscribeFromInterfaceChanges = nullptr;
+        }
+        if (platform->activeGroup != nullptr) {
+            platform->activeGroup->Remove(this);
+            platform->activeGroup = nullptr;
+            if (stopProcessing) {
+                ClearOutputQueue();
+            }
+        }
         if (
             stopProcessing
             && platform->processor.joinable()
@@ -390,7 +1025,7 @@ namespace SystemUtils {
             platform->processorStop = true;
             (void)SetEvent(platform->processorStateChangeevent);
             platform->processor.join();
-            platform->outputQueue.clear();
+            ClearOutputQueue();
         }
         if (platform->socket != INVALID_SOCKET) {
             diagnosticsSender.SendDiagnosticInformationFormatted(
@@ -404,49 +1039,245 @@ namespace SystemUtils {
     }
 
     std::vector< uint32_t > NetworkEndPoint::Impl::GetInterfaceAddresses() {
-        //Start up winSock library.
-        bool wsaStarted = false;
-        WSADATA wsaData;
-        if (!WSAStartup(MAKEWORD(2, 0), &wsaData)) {
-            wsaStarted = true;
+        auto& monitor = GetInterfaceAddressMonitor();
+        if (monitor.notificationHandle == NULL) {
+            return QueryInterfaceAddresses();
         }
+        return monitor.cache.GetAddresses();
+    }
 
-        // Get address of all networ adapters.
-        //
-        // Recommendation of 15KB pre-allocated buffer from:
-        // https://msdn.microsoft.com/en-us/library/aa365915%28v=vs.85%29.aspx
-        std::vector <uint8_t > buffer(15 * 1024);
-        ULONG bufferSize = (ULONG)buffer.size();
-        ULONG result = GetAdaptersAddresses(AF_INET, 0, NULL, (PIP_ADAPTER_ADDRESSES)&buffer[0], &bufferSize);
-        if (result == ERROR_BUFFER_OVERFLOW) {
-            buffer.resize(bufferSize);
-            result = GetAdaptersAddresses(AF_INET, 0, NULL, (PIP_ADAPTER_ADDRESSES)&buffer[0], &bufferSize);
+    bool NetworkEndPoint::Impl::JoinMulticastGroup() {
+        const auto interfaceAddresses = GetInterfaceAddresses();
+        const std::set< uint32_t > presentInterfaces(
+            interfaceAddresses.begin(),
+            interfaceAddresses.end()
+        );
+        for (
+            auto joinedInterface = platform->joinedInterfaces.begin();
+            joinedInterface != platform->joinedInterfaces.end();
+        ) {
+            if (presentInterfaces.find(*joinedInterface) == presentInterfaces.end()) {
+                joinedInterface = platform->joinedInterfaces.erase(joinedInterface);
+            } else {
+                ++joinedInterface;
+            }
         }
-        std::vector< uint32_t > addresses;
-        if (result == ERROR_SUCCESS) {
-            for (
-                PIP_ADAPTER_ADDRESSES adapter = (PIP_ADAPTER_ADDRESSES)&buffer[0];
-                adapter != NULL;
-                adapter = adapter->Next
+        bool success = true;
+        for (auto localAddress: presentInterfaces) {
+            if (platform->joinedInterfaces.find(localAddress) != platform->joinedInterfaces.end()) {
+                continue;
+            }
+            struct  ip_mreq multicastGroup;
+            multicastGroup.imr_multiaddr.S_un.S_addr = htonl(groupAddress);
+            multicastGroup.imr_interface.S_un.S_addr = htonl(localAddress);
+            if (setsockopt(platform->socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&multicastGroup, sizeof(multicastGroup)) == SOCKET_ERROR) {
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    SystemUtils::DiagnosticsSender::Levels::ERROR,
+                    "error setting socket option IP_ADD_MEMBERSHIP (%d) for local interface %" PRIu8 ".%" PRIu8 ".%" PRIu8 ".%" PRIu8,
+                    WSAGetLastError(),
+                    (uint8_t)((localAddress >> 24) & 0xFF),
+                    (uint8_t)((localAddress >> 16) & 0xFF),
+                    (uint8_t)((localAddress >> 8) & 0xFF),
+                    (uint8_t)(localAddress & 0xFF)
+                );
+                success = false;
+            } else {
+                (void)platform->joinedInterfaces.insert(localAddress);
+            }
+        }
+        return success;
+    }
+
+    bool NetworkEndPoint::Impl::HandOff(
+        unsigned int processId,
+        double timeout
+    ) {
+        if (platform->socket == INVALID_SOCKET) {
+            diagnosticsSender.SendDiagnosticInformationString(
+                SystemUtils::DiagnosticsSender::Levels::ERROR,
+                "cannot hand off endpoint which is not open"
+            );
+            return false;
+        }
+        HandOffRecord record;
+        (void)memset(&record, 0, sizeof(record));
+        if (WSADuplicateSocketW(platform->socket, (DWORD)processId, &record.protocolInfo) != 0) {
+            diagnosticsSender.SendDiagnosticInformationFormatted(
+                SystemUtils::DiagnosticsSender::Levels::ERROR,
+                "error in WSADuplicateSocket (%d)",
+                WSAGetLastError()
+            );
+            return false;
+        }
+        record.mode = (uint32_t)mode;
+        record.localAddress = localAddress;
+        record.groupAddress = groupAddress;
+        record.port = port;
+        const auto pipeName = GetHandOffPipeName(processId);
+        const HANDLE pipe = CreateNamedPipeA(
+            pipeName.c_str(),
+            PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+            PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+            1,
+            sizeof(record),
+            1,
+            0,
+            NULL
+        );
+        if (pipe == INVALID_HANDLE_VALUE) {
+            diagnosticsSender.SendDiagnosticInformationFormatted(
+                SystemUtils::DiagnosticsSender::Levels::ERROR,
+                "error creating hand-off pipe (%d)",
+                (int)GetLastError()
+            );
+            return false;
+        }
+        OVERLAPPED overlapped;
+        (void)memset(&overlapped, 0, sizeof(overlapped));
+        overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        const auto deadline = clock.GetTime() + timeout;
+        const auto remaining = [this, deadline]{
+            return (DWORD)(std::max(0.0, deadline - clock.GetTime()) * 1000.0);
+        };
+        DWORD amount = 0;
+        uint8_t ready = 0;
+        bool success = (
+            (overlapped.hEvent != NULL)
+            && AwaitOverlapped(pipe, ConnectNamedPipe(pipe, &overlapped), overlapped, remaining(), amount)
+            && AwaitOverlapped(pipe, WriteFile(pipe, &record, sizeof(record), NULL, &overlapped), overlapped, remaining(), amount)
+            && (amount == sizeof(record))
+            && AwaitOverlapped(pipe, ReadFile(pipe, &ready, 1, NULL, &overlapped), overlapped, remaining(), amount)
+            && (amount == 1)
+        );
+        if (overlapped.hEvent != NULL) {
+            (void)CloseHandle(overlapped.hEvent);
+        }
+        (void)CloseHandle(pipe);
+        if (!success) {
+            diagnosticsSender.SendDiagnosticInformationFormatted(
+                SystemUtils::DiagnosticsSender::Levels::ERROR,
+                "endpoint for port %" PRIu16 " not taken over by process %u",
+                port,
+                processId
+            );
+            return false;
+        }
+        diagnosticsSender.SendDiagnosticInformationFormatted(
+            1,
+            "endpoint for port %" PRIu16 " handed off to process %u",
+            port,
+            processId
+        );
+        Close(true);
+        return true;
+    }
+
+    bool NetworkEndPoint::Impl::OpenFromExisting(double timeout) {
+        // Close endpoint if it was previously open.
+        Close(true);
+
+        // Connect to the process handing off the socket.
+        const auto pipeName = GetHandOffPipeName(::GetCurrentProcessId());
+        const auto deadline = clock.GetTime() + timeout;
+        HANDLE pipe = INVALID_HANDLE_VALUE;
+        for (;;) {
+            pipe = CreateFileA(
+                pipeName.c_str(),
+                GENERIC_READ | GENERIC_WRITE,
+                0,
+                NULL,
+                OPEN_EXISTING,
+                0,
+                NULL
+            );
+            if (pipe != INVALID_HANDLE_VALUE) {
+                break;
+            }
+            const auto error = GetLastError();
+            const auto now = clock.GetTime();
+            if (
+                (now >= deadline)
+                || (
+                    (error != ERROR_FILE_NOT_FOUND)
+                    && (error != ERROR_PIPE_BUSY)
+                )
             ) {
-                if (adapter->OperStatus != IfOperStatusUp) {
-                    continue;
-                }
-                for (
-                    PIP_ADAPTER_UNICAST_ADDRESS unicastAddress = adapter->FirstUnicastAddress;
-                    unicastAddress != NULL;
-                    unicastAddress= unicastAddress->Next
-                ) {
-                    struct  sockaddr_in* ipAddress = (struct sockaddr_in*)unicastAddress->Address.lpSockaddr;
-                    addresses.push_back(ntohl(ipAddress->sin_addr.S_un.S_addr));
-                }
+                diagnosticsSender.SendDiagnosticInformationFormatted(
+                    SystemUtils::DiagnosticsSender::Levels::ERROR,
+                    "error connecting to hand-off pipe (%d)",
+                    (int)error
+                );
+                return false;
+            }
+            if (error == ERROR_PIPE_BUSY) {
+                (void)WaitNamedPipeA(pipeName.c_str(), (DWORD)((deadline - now) * 1000.0));
+            } else {
+                Sleep(10);
             }
         }
+        DWORD pipeMode = PIPE_READMODE_MESSAGE;
+        (void)SetNamedPipeHandleState(pipe, &pipeMode, NULL, NULL);
 
-        if (wsaStarted) {
-            (void)WSACleanup();
+        // Adopt the socket.
+        HandOffRecord record;
+        DWORD amount = 0;
+        if (
+            (ReadFile(pipe, &record, sizeof(record), &amount, NULL) == FALSE)
+            || (amount != sizeof(record))
+        ) {
+            diagnosticsSender.SendDiagnosticInformationFormatted(
+                SystemUtils::DiagnosticsSender::Levels::ERROR,
+                "error reading from hand-off pipe (%d)",
+                (int)GetLastError()
+            );
+            (void)CloseHandle(pipe);
+            return false;
+        }
+        platform->socket = WSASocketW(
+            FROM_PROTOCOL_INFO,
+            FROM_PROTOCOL_INFO,
+            FROM_PROTOCOL_INFO,
+            &record.protocolInfo,
+            0,
+            0
+        );
+        if (platform->socket == INVALID_SOCKET) {
+            diagnosticsSender.SendDiagnosticInformationFormatted(
+                SystemUtils::DiagnosticsSender::Levels::ERROR,
+                "error adopting handed-off socket (%d)",
+                WSAGetLastError()
+            );
+            (void)CloseHandle(pipe);
+            return false;
+        }
+        mode = (NetworkEndPoint::Mode)record.mode;
+        localAddress = record.localAddress;
+        groupAddress = record.groupAddress;
+        port = record.port;
+        platform->joinedInterfaces.clear();
+        if (mode == NetworkEndPoint::Mode::MulticastReceive) {
+            // The socket is already a member of its multicast
+            // group on every interface the other process joined.
+            for (auto localAddress: GetInterfaceAddresses()) {
+                (void)platform->joinedInterfaces.insert(localAddress);
+            }
+        }
+        if (!StartProcessing()) {
+            (void)CloseHandle(pipe);
+            return false;
         }
 
-        return addresses;
+        // Let the other process know it may stop using the socket.
+        const uint8_t ready = 1;
+        (void)WriteFile(pipe, &ready, 1, &amount, NULL);
+        (void)CloseHandle(pipe);
+        return true;
+    }
+
+    DWORD NetworkEndPoint::Platform::GetWaitTimeout(double waitTime) {
+        if (waitTime <= 0.0) {
+            return INFINITE;
+        }
+        return (DWORD)ceil(waitTime * 1000.0);
     }
-}
\ No newline at end of file
+}
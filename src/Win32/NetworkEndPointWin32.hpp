@@ -13,35 +13,16 @@
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <list>
+#include <set>
 #include <stdint.h>
 #include <SystemUtils/NetworkEndPoint.hpp>
+#include <SystemUtils/NetworkEndPointGroup.hpp>
 
 namespace SystemUtils {
 
     struct NetworkEndPoint::Platform 
     {
-        /**
-         * This is used to hold all information about
-         * a datagram to be sent.
-        */
-        struct Packet {
-            /**
-             * This is the IPv4 address of the datagram recipient.
-            */
-            uint32_t address;
-
-            /**
-             * This is the port number of the datagram recipient
-            */
-            uint16_t port;
-
-            /**
-            * This is the message to sent in the datagram.
-            */
-            std::vector< uint8_t > body;
-        };
-            /**
+    /**
      * This propertie keeps track of whether or not WSAStartup succeeded,
      * because if so we need to call WSACleanup upon teardown.
     */
@@ -73,6 +54,20 @@ namespace SystemUtils {
     */
     HANDLE processorStateChangeevent = NULL;
 
+    /**
+     * This is the event to set to wake up whichever worker thread
+     * does the network processing for the endpoint. It's either the
+     * processor state change event or the wake event of the group
+     * the endpoint is in.
+     */
+    HANDLE wakeEvent = NULL;
+
+    /**
+     * This is the group doing the network processing for
+     * the endpoint while it's open, if any.
+     */
+    std::shared_ptr< NetworkEndPointGroup::Impl > activeGroup;
+
     /**
      * This flag indicates whether or not the worker thread
      * should stop.
@@ -85,10 +80,41 @@ namespace SystemUtils {
     std::recursive_mutex processingMutex;
 
     /**
-     * This temporarily holds messages to be sent across the network
-     * by the worker thread. It is filled by the SentPacket method.
+     * These are the IPv4 addresses of the local network interfaces
+     * on which the endpoint is a member of its multicast group.
+     */
+    std::set< uint32_t > joinedInterfaces;
+
+    /**
+     * This is the WSARecvMsg extension function, used to receive
+     * datagrams along with the time the operating system received
+     * them, if the operating system can report this.
+     */
+    LPFN_WSARECVMSG recvMsg = NULL;
+
+    /**
+     * This is the number of seconds in each tick of the receive
+     * timestamps reported by the operating system, or zero if
+     * it isn't reporting them.
+     */
+    double timestampScale = 0.0;
+
+    // Methods
+
+    /**
+     * This function converts the longest time the worker thread may
+     * wait for network traffic into a timeout for waiting on the
+     * endpoint's events.
+     *
+     * @param[in] waitTime
+     *      This is the longest time, in seconds, the worker thread
+     *      may wait, or zero if it may wait indefinitely.
+     *
+     * @return
+     *      The timeout, in milliseconds, for waiting
+     *      on the endpoint's events is returned.
      */
-    std::list< Packet > outputQueue;
+    static DWORD GetWaitTimeout(double waitTime);
     };
    
 }
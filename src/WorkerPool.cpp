@@ -0,0 +1,72 @@
+/**
+ * @file WorkerPool.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::WorkerPool class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "WorkerPool.hpp"
+
+namespace SystemUtils {
+
+    WorkerPool::~WorkerPool() noexcept {
+        Wait();
+        {
+            std::lock_guard< decltype(mutex_) > lock(mutex_);
+            stop_ = true;
+            wakeCondition_.notify_all();
+        }
+        for (auto& thread: threads_) {
+            thread.join();
+        }
+    }
+
+    WorkerPool::WorkerPool(size_t numThreads) {
+        if (numThreads == 0) {
+            numThreads = 1;
+        }
+        for (size_t i = 0; i < numThreads; ++i) {
+            threads_.emplace_back(&WorkerPool::Run, this);
+        }
+    }
+
+    void WorkerPool::Post(Task task) {
+        std::lock_guard< decltype(mutex_) > lock(mutex_);
+        tasks_.push_back(std::move(task));
+        ++pending_;
+        wakeCondition_.notify_one();
+    }
+
+    void WorkerPool::Wait() {
+        std::unique_lock< decltype(mutex_) > lock(mutex_);
+        idleCondition_.wait(
+            lock,
+            [this]{ return (pending_ == 0); }
+        );
+    }
+
+    void WorkerPool::Run() {
+        std::unique_lock< decltype(mutex_) > lock(mutex_);
+        for (;;) {
+            wakeCondition_.wait(
+                lock,
+                [this]{ return (stop_ || !tasks_.empty()); }
+            );
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            task = nullptr;
+            lock.lock();
+            if (--pending_ == 0) {
+                idleCondition_.notify_all();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,122 @@
+#ifndef SYSTEM_UTILS_WORKER_POOL_HPP
+#define SYSTEM_UTILS_WORKER_POOL_HPP
+
+/**
+ * @file WorkerPool.hpp
+ *
+ * This module declares the SystemUtils::WorkerPool class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+namespace SystemUtils {
+
+    /**
+     * This class runs tasks on a fixed set of worker threads.
+     * Tasks may be posted from any thread, including from
+     * within other tasks run by the pool.
+     */
+    class WorkerPool {
+        // Types
+    public:
+        /**
+         * This is the type of function run by the pool.
+         */
+        typedef std::function< void() > Task;
+
+        // Lifecycle management
+    public:
+        ~WorkerPool() noexcept;
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Methods
+    public:
+        /**
+         * This is the instance constructor.  It starts
+         * the worker threads of the pool.
+         *
+         * @param[in] numThreads
+         *      This is the number of worker threads to start.
+         *      At least one is always started.
+         */
+        explicit WorkerPool(size_t numThreads);
+
+        /**
+         * This method queues the given task to be run
+         * by the next available worker thread.
+         *
+         * @param[in] task
+         *      This is the task to run.
+         */
+        void Post(Task task);
+
+        /**
+         * This method waits until no tasks are either queued or running.
+         * Tasks posted by other tasks are waited for as well.
+         *
+         * @note
+         *      This must not be called from a task run by the pool.
+         */
+        void Wait();
+
+        // Private methods
+    private:
+        /**
+         * This method is called as the body of each worker thread.
+         * It runs queued tasks until the pool is destroyed.
+         */
+        void Run();
+
+        // Private properties
+    private:
+        /**
+         * This is used to synchronize access to the pool.
+         */
+        std::mutex mutex_;
+
+        /**
+         * This is used to wake up worker threads when there are
+         * tasks to run or when the pool is being destroyed.
+         */
+        std::condition_variable wakeCondition_;
+
+        /**
+         * This is used to wake up threads waiting for
+         * the pool to run out of work.
+         */
+        std::condition_variable idleCondition_;
+
+        /**
+         * These are the tasks waiting to be run.
+         */
+        std::deque< Task > tasks_;
+
+        /**
+         * This is the number of tasks either queued or running.
+         */
+        size_t pending_ = 0;
+
+        /**
+         * This flag indicates whether or not the
+         * worker threads should stop.
+         */
+        bool stop_ = false;
+
+        /**
+         * These are the worker threads of the pool.
+         */
+        std::vector< std::thread > threads_;
+    };
+
+}
+
+#endif /* SYSTEM_UTILS_WORKER_POOL_HPP */
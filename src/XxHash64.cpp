@@ -0,0 +1,383 @@
+/**
+ * @file XxHash64.cpp
+ *
+ * This module contains the implementation of the
+ * SystemUtils::XxHash64 class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+#include <SystemUtils/XxHash64.hpp>
+
+namespace {
+
+    /**
+     * These are the prime numbers used by the xxHash64 algorithm.
+     */
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    /**
+     * This is the number of bytes consumed by each round of the
+     * algorithm, spread across four independent lanes.
+     */
+    constexpr size_t STRIPE_SIZE = 32;
+
+    /**
+     * This is the number of bytes read from a file at a time.
+     */
+    constexpr size_t READ_SIZE = 65536;
+
+    /**
+     * This function rotates the bits of the given value to the left.
+     *
+     * @param[in] value
+     *      This is the value whose bits to rotate.
+     *
+     * @param[in] amount
+     *      This is the number of bits by which to rotate.
+     *
+     * @return
+     *      The rotated value is returned.
+     */
+    inline uint64_t RotateLeft(uint64_t value, int amount) {
+        return (value << amount) | (value >> (64 - amount));
+    }
+
+    /**
+     * This function reads a 64-bit little-endian value.
+     *
+     * @param[in] data
+     *      This is where to fetch the value.
+     *
+     * @return
+     *      The value read is returned.
+     */
+    inline uint64_t Read64(const uint8_t* data) {
+        uint64_t value;
+        (void)memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    /**
+     * This function reads a 32-bit little-endian value.
+     *
+     * @param[in] data
+     *      This is where to fetch the value.
+     *
+     * @return
+     *      The value read is returned.
+     */
+    inline uint32_t Read32(const uint8_t* data) {
+        uint32_t value;
+        (void)memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    /**
+     * This function mixes eight bytes of input into one lane.
+     *
+     * @param[in] accumulator
+     *      This is the lane's value so far.
+     *
+     * @param[in] input
+     *      This is the input to mix in.
+     *
+     * @return
+     *      The lane's new value is returned.
+     */
+    inline uint64_t Round(uint64_t accumulator, uint64_t input) {
+        accumulator += input * PRIME2;
+        accumulator = RotateLeft(accumulator, 31);
+        return accumulator * PRIME1;
+    }
+
+    /**
+     * This function folds one lane into the hash when
+     * the lanes are combined at the end.
+     *
+     * @param[in] hash
+     *      This is the hash so far.
+     *
+     * @param[in] lane
+     *      This is the lane's value.
+     *
+     * @return
+     *      The new hash is returned.
+     */
+    inline uint64_t MergeRound(uint64_t hash, uint64_t lane) {
+        hash ^= Round(0, lane);
+        return hash * PRIME1 + PRIME4;
+    }
+
+    /**
+     * This function works out how much of a file to read,
+     * given an offset and length which may be zero,
+     * meaning "to the end of the file".
+     *
+     * @param[in] file
+     *      This is the file to read.
+     *
+     * @param[in] offset
+     *      This is the offset in the file of the first byte to read.
+     *
+     * @param[in] length
+     *      This is the number of bytes requested, or zero
+     *      to read everything from the offset to the end.
+     *
+     * @return
+     *      The number of bytes to read is returned.
+     */
+    uint64_t GetRegionLength(
+        const SystemUtils::IFile& file,
+        uint64_t offset,
+        uint64_t length
+    ) {
+        if (length != 0) {
+            return length;
+        }
+        const auto size = file.GetSize();
+        return ((offset < size) ? (size - offset) : 0);
+    }
+
+}
+
+namespace SystemUtils {
+
+    /**
+     * This contains the private properties of a XxHash64 instance.
+     */
+    struct XxHash64::Impl {
+        // Properties
+
+        /**
+         * This is the value with which the hash was started.
+         */
+        uint64_t seed = 0;
+
+        /**
+         * These are the four lanes into which whole
+         * stripes of input are mixed.
+         */
+        uint64_t lanes[4];
+
+        /**
+         * This holds input not yet making up a whole stripe.
+         */
+        uint8_t stripe[STRIPE_SIZE];
+
+        /**
+         * This is the number of bytes held in the partial stripe.
+         */
+        size_t stripeSize = 0;
+
+        /**
+         * This is the total number of bytes given so far.
+         */
+        uint64_t totalSize = 0;
+
+        // Methods
+
+        /**
+         * This method mixes whole stripes of input into the lanes.
+         *
+         * @param[in] data
+         *      This is where to fetch the stripes.
+         *
+         * @param[in] numStripes
+         *      This is the number of stripes to mix in.
+         */
+        void MixStripes(const uint8_t* data, size_t numStripes) {
+            auto lane0 = lanes[0];
+            auto lane1 = lanes[1];
+            auto lane2 = lanes[2];
+            auto lane3 = lanes[3];
+            while (numStripes-- > 0) {
+                lane0 = Round(lane0, Read64(data));
+                lane1 = Round(lane1, Read64(data + 8));
+                lane2 = Round(lane2, Read64(data + 16));
+                lane3 = Round(lane3, Read64(data + 24));
+                data += STRIPE_SIZE;
+            }
+            lanes[0] = lane0;
+            lanes[1] = lane1;
+            lanes[2] = lane2;
+            lanes[3] = lane3;
+        }
+    };
+
+    constexpr uint64_t XxHash64::DEFAULT_CHUNK_SIZE;
+
+    XxHash64::~XxHash64() noexcept = default;
+    XxHash64::XxHash64(XxHash64&&) noexcept = default;
+    XxHash64& XxHash64::operator=(XxHash64&&) noexcept = default;
+
+    XxHash64::XxHash64(uint64_t seed)
+        : impl_(new Impl())
+    {
+        Reset(seed);
+    }
+
+    void XxHash64::Reset(uint64_t seed) {
+        impl_->seed = seed;
+        impl_->lanes[0] = seed + PRIME1 + PRIME2;
+        impl_->lanes[1] = seed + PRIME2;
+        impl_->lanes[2] = seed;
+        impl_->lanes[3] = seed - PRIME1;
+        impl_->stripeSize = 0;
+        impl_->totalSize = 0;
+    }
+
+    void XxHash64::Update(const void* data, size_t size) {
+        auto input = (const uint8_t*)data;
+        impl_->totalSize += size;
+        if (impl_->stripeSize > 0) {
+            const auto amount = std::min(size, STRIPE_SIZE - impl_->stripeSize);
+            (void)memcpy(impl_->stripe + impl_->stripeSize, input, amount);
+            impl_->stripeSize += amount;
+            input += amount;
+            size -= amount;
+            if (impl_->stripeSize < STRIPE_SIZE) {
+                return;
+            }
+            impl_->MixStripes(impl_->stripe, 1);
+            impl_->stripeSize = 0;
+        }
+        const auto numStripes = size / STRIPE_SIZE;
+        impl_->MixStripes(input, numStripes);
+        input += numStripes * STRIPE_SIZE;
+        size -= numStripes * STRIPE_SIZE;
+        (void)memcpy(impl_->stripe, input, size);
+        impl_->stripeSize = size;
+    }
+
+    bool XxHash64::Update(
+        const IFile& file,
+        uint64_t offset,
+        uint64_t length
+    ) {
+        length = GetRegionLength(file, offset, length);
+        std::vector< uint8_t > buffer((size_t)std::min((uint64_t)READ_SIZE, length));
+        while (length > 0) {
+            const auto amount = (size_t)std::min((uint64_t)buffer.size(), length);
+            const auto amountRead = file.ReadAt(offset, buffer.data(), amount);
+            Update(buffer.data(), amountRead);
+            if (amountRead < amount) {
+                return false;
+            }
+            offset += amount;
+            length -= amount;
+        }
+        return true;
+    }
+
+    uint64_t XxHash64::GetValue() const {
+        uint64_t hash;
+        if (impl_->totalSize >= STRIPE_SIZE) {
+            hash = (
+                RotateLeft(impl_->lanes[0], 1)
+                + RotateLeft(impl_->lanes[1], 7)
+                + RotateLeft(impl_->lanes[2], 12)
+                + RotateLeft(impl_->lanes[3], 18)
+            );
+            for (size_t i = 0; i < 4; ++i) {
+                hash = MergeRound(hash, impl_->lanes[i]);
+            }
+        } else {
+            hash = impl_->seed + PRIME5;
+        }
+        hash += impl_->totalSize;
+        auto data = (const uint8_t*)impl_->stripe;
+        auto size = impl_->stripeSize;
+        while (size >= 8) {
+            hash ^= Round(0, Read64(data));
+            hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+            data += 8;
+            size -= 8;
+        }
+        if (size >= 4) {
+            hash ^= (uint64_t)Read32(data) * PRIME1;
+            hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+            data += 4;
+            size -= 4;
+        }
+        while (size > 0) {
+            hash ^= (*data++) * PRIME5;
+            hash = RotateLeft(hash, 11) * PRIME1;
+            --size;
+        }
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    uint64_t XxHash64::Compute(
+        const void* data,
+        size_t size,
+        uint64_t seed
+    ) {
+        XxHash64 hash(seed);
+        hash.Update(data, size);
+        return hash.GetValue();
+    }
+
+    bool XxHash64::ComputeChunks(
+        const IFile& file,
+        std::vector< uint64_t >& hashes,
+        uint64_t offset,
+        uint64_t length,
+        size_t numThreads,
+        uint64_t chunkSize,
+        uint64_t seed
+    ) {
+        length = GetRegionLength(file, offset, length);
+        if (chunkSize == 0) {
+            chunkSize = DEFAULT_CHUNK_SIZE;
+        }
+        const auto numChunks = (size_t)((length + chunkSize - 1) / chunkSize);
+        hashes.assign(numChunks, 0);
+        std::mutex mutex;
+        bool success = true;
+        const auto hashChunk = [&](size_t i){
+            const auto chunkOffset = i * chunkSize;
+            XxHash64 hash(seed);
+            const auto chunkSuccess = hash.Update(
+                file,
+                offset + chunkOffset,
+                std::min(chunkSize, length - chunkOffset)
+            );
+            hashes[i] = hash.GetValue();
+            if (!chunkSuccess) {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                success = false;
+            }
+        };
+        if (
+            (numThreads <= 1)
+            || (numChunks <= 1)
+        ) {
+            for (size_t i = 0; i < numChunks; ++i) {
+                hashChunk(i);
+            }
+            return success;
+        }
+        WorkerPool workers(std::min(numThreads, numChunks));
+        for (size_t i = 0; i < numChunks; ++i) {
+            workers.Post([&hashChunk, i]{ hashChunk(i); });
+        }
+        workers.Wait();
+        return success;
+    }
+
+}
@@ -0,0 +1,118 @@
+/**
+ * @file AdmissionControllerTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::AdmissionController class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <AdmissionController.hpp>
+#include <vector>
+
+TEST(AdmissionControllerTests, AdmissionControllerTests_UnlimitedByDefault_Test) {
+    SystemUtils::AdmissionController controller;
+    ASSERT_FALSE(controller.IsLimited());
+    std::vector< SystemUtils::AdmissionController::Ticket > tickets(100);
+    for (auto& ticket: tickets) {
+        ASSERT_EQ(
+            SystemUtils::AdmissionController::Verdict::Admitted,
+            controller.Admit(0x7F000001, 0.0, ticket)
+        );
+    }
+    ASSERT_EQ(100, controller.GetStatistics().admitted);
+    ASSERT_EQ(100, controller.GetStatistics().connectionsOpen);
+}
+
+TEST(AdmissionControllerTests, AdmissionControllerTests_MaxConnections_Test) {
+    SystemUtils::AdmissionController controller;
+    SystemUtils::NetworkEndPoint::AdmissionPolicy policy;
+    policy.maxConnections = 2;
+    controller.SetPolicy(policy);
+    ASSERT_TRUE(controller.IsLimited());
+    SystemUtils::AdmissionController::Ticket ticket1, ticket2, ticket3;
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000001, 0.0, ticket1)
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000002, 0.0, ticket2)
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::TooManyConnections,
+        controller.Admit(0x7F000003, 0.0, ticket3)
+    );
+    ticket1 = nullptr;
+    ASSERT_EQ(1, controller.GetStatistics().connectionsOpen);
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000003, 0.0, ticket3)
+    );
+    const auto statistics = controller.GetStatistics();
+    ASSERT_EQ(3, statistics.admitted);
+    ASSERT_EQ(1, statistics.rejectedTooManyConnections);
+    ASSERT_EQ(2, statistics.connectionsOpen);
+}
+
+TEST(AdmissionControllerTests, AdmissionControllerTests_MaxConnectionsPerAddress_Test) {
+    SystemUtils::AdmissionController controller;
+    SystemUtils::NetworkEndPoint::AdmissionPolicy policy;
+    policy.maxConnectionsPerAddress = 1;
+    controller.SetPolicy(policy);
+    SystemUtils::AdmissionController::Ticket ticket1, ticket2, ticket3;
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000001, 0.0, ticket1)
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::TooManyFromAddress,
+        controller.Admit(0x7F000001, 0.0, ticket2)
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000002, 0.0, ticket3)
+    );
+    ticket1 = nullptr;
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000001, 0.0, ticket2)
+    );
+    ASSERT_EQ(1, controller.GetStatistics().rejectedTooManyFromAddress);
+}
+
+TEST(AdmissionControllerTests, AdmissionControllerTests_AcceptRate_Test) {
+    SystemUtils::AdmissionController controller;
+    SystemUtils::NetworkEndPoint::AdmissionPolicy policy;
+    policy.acceptRate = 10.0;
+    policy.acceptBurst = 2;
+    controller.SetPolicy(policy);
+    std::vector< SystemUtils::AdmissionController::Ticket > tickets(4);
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000001, 1.0, tickets[0])
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000001, 1.0, tickets[1])
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::RateLimited,
+        controller.Admit(0x7F000001, 1.0, tickets[2])
+    );
+    ASSERT_EQ(
+        SystemUtils::AdmissionController::Verdict::Admitted,
+        controller.Admit(0x7F000001, 1.2, tickets[3])
+    );
+    ASSERT_EQ(1, controller.GetStatistics().rejectedRateLimited);
+}
+
+TEST(AdmissionControllerTests, AdmissionControllerTests_TicketMayOutliveController_Test) {
+    SystemUtils::AdmissionController::Ticket ticket;
+    {
+        SystemUtils::AdmissionController controller;
+        (void)controller.Admit(0x7F000001, 0.0, ticket);
+    }
+    ticket = nullptr;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file AlignedBufferTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::AlignedBuffer class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <SystemUtils/AlignedBuffer.hpp>
+#include <utility>
+
+TEST(AlignedBufferTests, AlignedBufferTests_IsAlignedAndZeroed_Test) {
+    for (size_t alignment: {(size_t)1, (size_t)16, (size_t)512, (size_t)4096}) {
+        SystemUtils::AlignedBuffer buffer(10000, alignment);
+        ASSERT_FALSE(buffer.GetData() == nullptr);
+        EXPECT_EQ(10000, buffer.GetSize());
+        EXPECT_EQ(alignment, buffer.GetAlignment());
+        EXPECT_EQ(0, (uintptr_t)buffer.GetData() % alignment);
+        for (size_t i = 0; i < buffer.GetSize(); ++i) {
+            ASSERT_EQ(0, buffer.GetData()[i]);
+        }
+        buffer.GetData()[buffer.GetSize() - 1] = 42;
+    }
+}
+
+TEST(AlignedBufferTests, AlignedBufferTests_AlignmentRoundedUpToPowerOfTwo_Test) {
+    SystemUtils::AlignedBuffer buffer(100, 3000);
+    EXPECT_EQ(4096, buffer.GetAlignment());
+    EXPECT_EQ(0, (uintptr_t)buffer.GetData() % 4096);
+}
+
+TEST(AlignedBufferTests, AlignedBufferTests_EmptyAndMoved_Test) {
+    SystemUtils::AlignedBuffer empty;
+    EXPECT_TRUE(empty.GetData() == nullptr);
+    EXPECT_EQ(0, empty.GetSize());
+    SystemUtils::AlignedBuffer buffer(64);
+    const auto data = buffer.GetData();
+    SystemUtils::AlignedBuffer moved(std::move(buffer));
+    EXPECT_EQ(data, moved.GetData());
+    EXPECT_EQ(64, moved.GetSize());
+}
@@ -0,0 +1,97 @@
+/**
+ * @file AppendLogTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::AppendLog class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <SystemUtils/AppendLog.hpp>
+#include <SystemUtils/File.hpp>
+#include <thread>
+#include <vector>
+
+struct AppendLogTests: public ::testing::Test
+{
+    std::string testDirectoryPath;
+
+    virtual void SetUp() {
+        testDirectoryPath = SystemUtils::File::GetExeParentDirectory() + "/testAppendLogDirectory";
+        ASSERT_TRUE(SystemUtils::File::CreateDirectory(testDirectoryPath));
+    }
+
+    virtual void TearDown() {
+        ASSERT_TRUE(SystemUtils::File::DeleteDirectory(testDirectoryPath));
+    }
+};
+
+TEST_F(AppendLogTests, AppendLogTests_AppendDurable_Test) {
+    const auto path = testDirectoryPath + "/log.bin";
+    SystemUtils::AppendLog log;
+    EXPECT_EQ(0, log.Append("x", 1));
+    ASSERT_TRUE(log.Open(path, 4096));
+    ASSERT_TRUE(log.AppendDurable("Hello, ", 7));
+    EXPECT_EQ(7, log.GetDurableOffset());
+    const auto offset = log.Append("World!", 6);
+    EXPECT_EQ(13, offset);
+    ASSERT_TRUE(log.WaitDurable(offset));
+    log.Close();
+    EXPECT_FALSE(log.AppendDurable("x", 1));
+
+    // Reopening appends after what's already there.
+    ASSERT_TRUE(log.Open(path, 4096));
+    EXPECT_EQ(13, log.GetDurableOffset());
+    ASSERT_TRUE(log.AppendDurable("!!", 2));
+    log.Close();
+    SystemUtils::File file(path);
+    ASSERT_TRUE(file.OpenReadOnly());
+    ASSERT_EQ(15, file.GetSize());
+    SystemUtils::IFile::Buffer buffer(15);
+    ASSERT_EQ(15, file.Read(buffer));
+    EXPECT_EQ("Hello, World!!!", std::string(buffer.begin(), buffer.end()));
+}
+
+TEST_F(AppendLogTests, AppendLogTests_ConcurrentWriters_Test) {
+    const auto path = testDirectoryPath + "/log.bin";
+    SystemUtils::AppendLog log;
+    ASSERT_TRUE(log.Open(path));
+    const size_t numThreads = 8;
+    const size_t recordsPerThread = 50;
+    std::vector< std::thread > threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(
+            [&log, i, recordsPerThread]{
+                const uint8_t record[4] = {(uint8_t)i, (uint8_t)i, (uint8_t)i, (uint8_t)i};
+                for (size_t j = 0; j < recordsPerThread; ++j) {
+                    EXPECT_TRUE(log.AppendDurable(record, sizeof(record)));
+                }
+            }
+        );
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    EXPECT_EQ(numThreads * recordsPerThread * 4, log.GetDurableOffset());
+    log.Close();
+
+    // Every record must be whole, and each writer's records all there.
+    SystemUtils::File file(path);
+    ASSERT_TRUE(file.OpenReadOnly());
+    SystemUtils::IFile::Buffer buffer((size_t)file.GetSize());
+    ASSERT_EQ(numThreads * recordsPerThread * 4, buffer.size());
+    ASSERT_EQ(buffer.size(), file.Read(buffer));
+    std::vector< size_t > counts(numThreads);
+    for (size_t i = 0; i < buffer.size(); i += 4) {
+        ASSERT_LT(buffer[i], numThreads);
+        EXPECT_EQ(buffer[i], buffer[i + 1]);
+        EXPECT_EQ(buffer[i], buffer[i + 2]);
+        EXPECT_EQ(buffer[i], buffer[i + 3]);
+        ++counts[buffer[i]];
+    }
+    for (size_t i = 0; i < numThreads; ++i) {
+        EXPECT_EQ(recordsPerThread, counts[i]);
+    }
+}
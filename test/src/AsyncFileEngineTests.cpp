@@ -0,0 +1,178 @@
+/**
+ * @file AsyncFileEngineTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::AsyncFileEngine class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <SystemUtils/AsyncFileEngine.hpp>
+#include <SystemUtils/File.hpp>
+#include <vector>
+
+struct AsyncFileEngineTests: public ::testing::Test
+{
+    std::string testDirectoryPath;
+
+    virtual void SetUp() {
+        testDirectoryPath = SystemUtils::File::GetExeParentDirectory() + "/testAsyncFileEngineDirectory";
+        ASSERT_TRUE(SystemUtils::File::CreateDirectory(testDirectoryPath));
+    }
+
+    virtual void TearDown() {
+        ASSERT_TRUE(SystemUtils::File::DeleteDirectory(testDirectoryPath));
+    }
+};
+
+TEST_F(AsyncFileEngineTests, AsyncFileEngineTests_BatchedReads_Test) {
+    SystemUtils::File file(testDirectoryPath + "/data.bin");
+    ASSERT_TRUE(file.OpenReadWrite());
+    std::vector< uint8_t > contents(256 * 4096);
+    for (size_t i = 0; i < contents.size(); ++i) {
+        contents[i] = (uint8_t)(i / 4096 + i);
+    }
+    ASSERT_EQ(contents.size(), file.Write(contents.data(), contents.size()));
+    SystemUtils::AsyncFileEngine engine(8);
+    const size_t numBlocks = contents.size() / 4096;
+    std::vector< std::vector< uint8_t > > blocks(numBlocks, std::vector< uint8_t >(4096));
+    std::atomic< size_t > numSucceeded(0);
+    std::vector< SystemUtils::AsyncFileEngine::Request > requests;
+    for (size_t i = 0; i < numBlocks; ++i) {
+        SystemUtils::AsyncFileEngine::Request request;
+        request.file = &file;
+        request.offset = ((i * 37) % numBlocks) * 4096;
+        request.buffer = blocks[i].data();
+        request.numBytes = 4096;
+        request.completionDelegate = [&numSucceeded](bool success, size_t bytesTransferred){
+            if (
+                success
+                && (bytesTransferred == 4096)
+            ) {
+                ++numSucceeded;
+            }
+        };
+        requests.push_back(std::move(request));
+    }
+    engine.Submit(std::move(requests));
+    engine.WaitUntilIdle();
+    EXPECT_EQ(0, engine.GetOutstandingCount());
+    ASSERT_EQ(numBlocks, numSucceeded);
+    for (size_t i = 0; i < numBlocks; ++i) {
+        const auto offset = ((i * 37) % numBlocks) * 4096;
+        EXPECT_TRUE(
+            std::equal(
+                blocks[i].begin(),
+                blocks[i].end(),
+                contents.begin() + offset
+            )
+        ) << "block " << i;
+    }
+}
+
+TEST_F(AsyncFileEngineTests, AsyncFileEngineTests_WriteThenReadPastEnd_Test) {
+    SystemUtils::File file(testDirectoryPath + "/data.bin");
+    ASSERT_TRUE(file.OpenReadWrite());
+    SystemUtils::AsyncFileEngine engine;
+    const std::string testString = "Hello, World!";
+    bool writeSucceeded = false;
+    size_t amountWritten = 0;
+    SystemUtils::AsyncFileEngine::Request write;
+    write.operation = SystemUtils::AsyncFileEngine::Operation::Write;
+    write.file = &file;
+    write.offset = 3;
+    write.buffer = (void*)testString.data();
+    write.numBytes = testString.length();
+    write.completionDelegate = [&](bool success, size_t bytesTransferred){
+        writeSucceeded = success;
+        amountWritten = bytesTransferred;
+    };
+    engine.Submit(std::move(write));
+    engine.WaitUntilIdle();
+    EXPECT_TRUE(writeSucceeded);
+    EXPECT_EQ(testString.length(), amountWritten);
+    EXPECT_EQ(3 + testString.length(), file.GetSize());
+    EXPECT_EQ(0, file.GetPosition());
+
+    // Reading past the end transfers nothing, but isn't a failure.
+    char buffer[8];
+    bool readSucceeded = false;
+    size_t amountRead = 1;
+    SystemUtils::AsyncFileEngine::Request read;
+    read.file = &file;
+    read.offset = 100;
+    read.buffer = buffer;
+    read.numBytes = sizeof(buffer);
+    read.completionDelegate = [&](bool success, size_t bytesTransferred){
+        readSucceeded = success;
+        amountRead = bytesTransferred;
+    };
+    engine.Submit(std::move(read));
+    engine.WaitUntilIdle();
+    EXPECT_TRUE(readSucceeded);
+    EXPECT_EQ(0, amountRead);
+
+    // Verify the file still works synchronously after having
+    // been used by the engine.
+    ASSERT_EQ(5, file.ReadAt(10, buffer, 5));
+    EXPECT_EQ("World", std::string(buffer, 5));
+}
+
+TEST_F(AsyncFileEngineTests, AsyncFileEngineTests_RequestOnClosedFileFails_Test) {
+    SystemUtils::File file(testDirectoryPath + "/data.bin");
+    SystemUtils::AsyncFileEngine engine;
+    char buffer[8];
+    bool completed = false;
+    bool succeeded = true;
+    SystemUtils::AsyncFileEngine::Request request;
+    request.file = &file;
+    request.buffer = buffer;
+    request.numBytes = sizeof(buffer);
+    size_t transferred = 1;
+    request.completionDelegate = [&](bool success, size_t bytesTransferred){
+        completed = true;
+        succeeded = success;
+        transferred = bytesTransferred;
+    };
+    engine.Submit(std::move(request));
+    engine.WaitUntilIdle();
+    EXPECT_TRUE(completed);
+    EXPECT_FALSE(succeeded);
+    EXPECT_EQ(0, transferred);
+}
+
+TEST_F(AsyncFileEngineTests, AsyncFileEngineTests_FileServedByOnlyOneEngine_Test) {
+    SystemUtils::File file(testDirectoryPath + "/data.bin");
+    ASSERT_TRUE(file.OpenReadWrite());
+    ASSERT_EQ(8, file.Write("abcdefgh", 8));
+    char buffer[8];
+    const auto readWithNewEngine = [&file, &buffer]{
+        SystemUtils::AsyncFileEngine engine;
+        bool succeeded = false;
+        SystemUtils::AsyncFileEngine::Request request;
+        request.file = &file;
+        request.buffer = buffer;
+        request.numBytes = sizeof(buffer);
+        request.completionDelegate = [&succeeded](bool success, size_t){
+            succeeded = success;
+        };
+        engine.Submit(std::move(request));
+        engine.WaitUntilIdle();
+        return succeeded;
+    };
+
+    // The first engine to serve the file keeps it, even once it's gone.
+    EXPECT_TRUE(readWithNewEngine());
+    EXPECT_FALSE(readWithNewEngine());
+    EXPECT_FALSE(file.GetLastError().empty());
+
+    // Opening the file again frees it to be served by another engine.
+    file.Close();
+    ASSERT_TRUE(file.OpenReadOnly());
+    EXPECT_TRUE(readWithNewEngine());
+    EXPECT_EQ("abcdefgh", std::string(buffer, sizeof(buffer)));
+}
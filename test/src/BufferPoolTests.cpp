@@ -0,0 +1,67 @@
+/**
+ * @file BufferPoolTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::BufferPool class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <BufferPool.hpp>
+
+TEST(BufferPoolTests, BufferPoolTests_AcquireGivesBufferOfPoolSize_Test) {
+    SystemUtils::BufferPool pool(1500, 4);
+    ASSERT_EQ(1500, pool.GetBufferSize());
+    const auto buffer = pool.Acquire();
+    ASSERT_EQ(1500, buffer->size());
+    ASSERT_EQ(0, pool.GetBuffersPooled());
+}
+
+TEST(BufferPoolTests, BufferPoolTests_ReleasedBufferIsReused_Test) {
+    SystemUtils::BufferPool pool(1500, 4);
+    auto buffer = pool.Acquire();
+    const auto firstAddress = buffer->data();
+    buffer->resize(12);
+    buffer = nullptr;
+    ASSERT_EQ(1, pool.GetBuffersPooled());
+    buffer = pool.Acquire();
+    ASSERT_EQ(0, pool.GetBuffersPooled());
+    ASSERT_EQ(firstAddress, buffer->data());
+    ASSERT_EQ(1500, buffer->size());
+}
+
+TEST(BufferPoolTests, BufferPoolTests_PoolKeepsLimitedNumberOfBuffers_Test) {
+    SystemUtils::BufferPool pool(16, 2);
+    {
+        const auto buffer1 = pool.Acquire();
+        const auto buffer2 = pool.Acquire();
+        const auto buffer3 = pool.Acquire();
+    }
+    ASSERT_EQ(2, pool.GetBuffersPooled());
+}
+
+TEST(BufferPoolTests, BufferPoolTests_BufferMayOutlivePool_Test) {
+    std::shared_ptr< std::vector< uint8_t > > buffer;
+    {
+        SystemUtils::BufferPool pool(16, 2);
+        buffer = pool.Acquire();
+    }
+    (*buffer)[0] = 42;
+    ASSERT_EQ(42, (*buffer)[0]);
+    buffer = nullptr;
+}
+
+TEST(BufferPoolTests, BufferPoolTests_AcquireCopyOfData_Test) {
+    SystemUtils::BufferPool pool(1500, 4);
+    auto buffer = pool.Acquire();
+    const auto firstAddress = buffer->data();
+    buffer->resize(12);
+    buffer = nullptr;
+    const std::vector< uint8_t > data{1, 2, 3, 4, 5};
+    buffer = pool.Acquire(data.data(), data.size());
+    ASSERT_EQ(0, pool.GetBuffersPooled());
+    ASSERT_EQ(firstAddress, buffer->data());
+    ASSERT_EQ(data, *buffer);
+    ASSERT_GE(buffer->capacity(), 1500);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file BufferedReaderTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::BufferedReader class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <SystemUtils/BufferedReader.hpp>
+#include <SystemUtils/StringFile.hpp>
+
+namespace {
+
+    /**
+     * This is a file held in memory which counts
+     * how many times it's read.
+     */
+    struct CountingFile: public SystemUtils::StringFile {
+        size_t reads = 0;
+
+        CountingFile(const std::string& contents)
+            : SystemUtils::StringFile(contents)
+        {
+        }
+
+        virtual size_t Read(void* buffer, size_t numBytes) override {
+            ++reads;
+            return SystemUtils::StringFile::Read(buffer, numBytes);
+        }
+    };
+
+}
+
+TEST(BufferedReaderTests, BufferedReaderTests_SmallReadsAreBuffered_Test) {
+    CountingFile file("Hello, World!");
+    SystemUtils::BufferedReader reader(file, 8);
+    char buffer[13];
+    for (size_t i = 0; i < 13; ++i) {
+        ASSERT_EQ(1, reader.Read(buffer + i, 1));
+        EXPECT_EQ(i + 1, reader.GetPosition());
+    }
+    EXPECT_EQ("Hello, World!", std::string(buffer, 13));
+    EXPECT_EQ(2, file.reads);
+    EXPECT_EQ(0, reader.Read(buffer, 1));
+}
+
+TEST(BufferedReaderTests, BufferedReaderTests_LargeReadBypassesBuffer_Test) {
+    CountingFile file("Hello, World!");
+    SystemUtils::BufferedReader reader(file, 4);
+    char buffer[13];
+    ASSERT_EQ(2, reader.Read(buffer, 2));
+    ASSERT_EQ(11, reader.Read(buffer + 2, 11));
+    EXPECT_EQ("Hello, World!", std::string(buffer, 13));
+    EXPECT_EQ(2, file.reads);
+}
+
+TEST(BufferedReaderTests, BufferedReaderTests_ReadExactly_Test) {
+    SystemUtils::StringFile file("Hello, World!");
+    SystemUtils::BufferedReader reader(file, 4);
+    char buffer[10];
+    ASSERT_TRUE(reader.ReadExactly(buffer, 7));
+    EXPECT_EQ("Hello, ", std::string(buffer, 7));
+    EXPECT_FALSE(reader.ReadExactly(buffer, 10));
+    EXPECT_EQ("World!", std::string(buffer, 6));
+}
+
+TEST(BufferedReaderTests, BufferedReaderTests_Peek_Test) {
+    CountingFile file("Hello, World!");
+    SystemUtils::BufferedReader reader(file, 8);
+    char buffer[8];
+    ASSERT_EQ(5, reader.Peek(buffer, 5));
+    EXPECT_EQ("Hello", std::string(buffer, 5));
+    ASSERT_EQ(3, reader.Read(buffer, 3));
+    EXPECT_EQ("Hel", std::string(buffer, 3));
+    ASSERT_EQ(2, reader.Peek(buffer, 2));
+    EXPECT_EQ("lo", std::string(buffer, 2));
+    EXPECT_EQ(1, file.reads);
+
+    // Peeking beyond what's buffered reads more, keeping what's there.
+    ASSERT_EQ(8, reader.Peek(buffer, 8));
+    EXPECT_EQ("lo, Worl", std::string(buffer, 8));
+    EXPECT_EQ(3, reader.GetPosition());
+}
+
+TEST(BufferedReaderTests, BufferedReaderTests_ReadLine_Test) {
+    SystemUtils::StringFile file("first\r\nsecond line is long\n\nlast");
+    for (size_t bufferSize: {(size_t)0, (size_t)3, (size_t)8, (size_t)1024}) {
+        file.SetPosition(0);
+        SystemUtils::BufferedReader reader(file, bufferSize);
+        std::string line;
+        ASSERT_TRUE(reader.ReadLine(line)) << bufferSize;
+        EXPECT_EQ("first", line);
+        ASSERT_TRUE(reader.ReadLine(line)) << bufferSize;
+        EXPECT_EQ("second line is long", line);
+        ASSERT_TRUE(reader.ReadLine(line)) << bufferSize;
+        EXPECT_EQ("", line);
+        ASSERT_TRUE(reader.ReadLine(line)) << bufferSize;
+        EXPECT_EQ("last", line);
+        EXPECT_FALSE(reader.ReadLine(line)) << bufferSize;
+    }
+}
+
+TEST(BufferedReaderTests, BufferedReaderTests_Unbuffered_Test) {
+    CountingFile file("Hello, World!");
+    SystemUtils::BufferedReader reader(file, 0);
+    char buffer[5];
+    ASSERT_EQ(5, reader.Peek(buffer, 5));
+    EXPECT_EQ(0, file.reads);
+    ASSERT_EQ(5, reader.Read(buffer, 5));
+    EXPECT_EQ("Hello", std::string(buffer, 5));
+    EXPECT_EQ(1, file.reads);
+    EXPECT_EQ(5, file.GetPosition());
+    EXPECT_EQ(5, reader.GetPosition());
+}
@@ -0,0 +1,76 @@
+/**
+ * @file BufferedWriterTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::BufferedWriter class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <SystemUtils/BufferedWriter.hpp>
+#include <SystemUtils/StringFile.hpp>
+
+namespace {
+
+    /**
+     * This is a file held in memory which counts
+     * how many times it's written.
+     */
+    struct CountingFile: public SystemUtils::StringFile {
+        size_t writes = 0;
+
+        virtual size_t Write(const void* buffer, size_t numBytes) override {
+            ++writes;
+            return SystemUtils::StringFile::Write(buffer, numBytes);
+        }
+    };
+
+}
+
+TEST(BufferedWriterTests, BufferedWriterTests_WritesAreBuffered_Test) {
+    CountingFile file;
+    SystemUtils::BufferedWriter writer(file, 8);
+    EXPECT_EQ(5, writer.Write("Hello"));
+    EXPECT_EQ(0, file.writes);
+    EXPECT_EQ(5, writer.GetPosition());
+    EXPECT_EQ(2, writer.Write(", "));
+    EXPECT_EQ(0, file.writes);
+    EXPECT_EQ(6, writer.Write("World!"));
+    EXPECT_EQ(1, file.writes);
+    EXPECT_EQ("Hello, ", (std::string)file);
+    EXPECT_EQ(13, writer.GetPosition());
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(2, file.writes);
+    EXPECT_EQ("Hello, World!", (std::string)file);
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(2, file.writes);
+}
+
+TEST(BufferedWriterTests, BufferedWriterTests_LargeWriteBypassesBuffer_Test) {
+    CountingFile file;
+    SystemUtils::BufferedWriter writer(file, 4);
+    EXPECT_EQ(2, writer.Write("He"));
+    EXPECT_EQ(11, writer.Write("llo, World!"));
+    EXPECT_EQ(2, file.writes);
+    EXPECT_EQ("Hello, World!", (std::string)file);
+}
+
+TEST(BufferedWriterTests, BufferedWriterTests_DestructorFlushes_Test) {
+    CountingFile file;
+    {
+        SystemUtils::BufferedWriter writer(file);
+        EXPECT_EQ(13, writer.Write("Hello, World!"));
+        EXPECT_EQ("", (std::string)file);
+    }
+    EXPECT_EQ("Hello, World!", (std::string)file);
+}
+
+TEST(BufferedWriterTests, BufferedWriterTests_Unbuffered_Test) {
+    CountingFile file;
+    SystemUtils::BufferedWriter writer(file, 0);
+    EXPECT_EQ(5, writer.Write("Hello"));
+    EXPECT_EQ(1, file.writes);
+    EXPECT_EQ("Hello", (std::string)file);
+}
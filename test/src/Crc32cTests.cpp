@@ -0,0 +1,86 @@
+/**
+ * @file Crc32cTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::Crc32c class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+#include <SystemUtils/Crc32c.hpp>
+#include <SystemUtils/StringFile.hpp>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function returns the test pattern used to check
+     * checksums of larger amounts of data.
+     *
+     * @return
+     *      The test pattern is returned.
+     */
+    std::vector< uint8_t > MakePattern() {
+        std::vector< uint8_t > pattern(10240);
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            pattern[i] = (uint8_t)i;
+        }
+        return pattern;
+    }
+
+}
+
+TEST(Crc32cTests, Crc32cTests_KnownValues_Test) {
+    const std::string check = "123456789";
+    EXPECT_EQ(0xE3069283, SystemUtils::Crc32c::Compute(check.data(), check.length()));
+    EXPECT_EQ(0, SystemUtils::Crc32c::Compute(nullptr, 0));
+    const auto pattern = MakePattern();
+    EXPECT_EQ(0xBD846CD7, SystemUtils::Crc32c::Compute(pattern.data(), pattern.size()));
+}
+
+TEST(Crc32cTests, Crc32cTests_StreamedInPieces_Test) {
+    const auto pattern = MakePattern();
+    SystemUtils::Crc32c crc;
+    size_t offset = 0;
+    for (size_t pieceSize = 1; offset < pattern.size(); ++pieceSize) {
+        const auto amount = std::min(pieceSize, pattern.size() - offset);
+        crc.Update(pattern.data() + offset, amount);
+        offset += amount;
+    }
+    EXPECT_EQ(0xBD846CD7, crc.GetValue());
+    crc.Reset();
+    EXPECT_EQ(0, crc.GetValue());
+}
+
+TEST(Crc32cTests, Crc32cTests_Combine_Test) {
+    const auto pattern = MakePattern();
+    const auto first = SystemUtils::Crc32c::Compute(pattern.data(), 1000);
+    const auto second = SystemUtils::Crc32c::Compute(pattern.data() + 1000, pattern.size() - 1000);
+    EXPECT_EQ(0xBD846CD7, SystemUtils::Crc32c::Combine(first, second, pattern.size() - 1000));
+}
+
+TEST(Crc32cTests, Crc32cTests_FromFile_Test) {
+    SystemUtils::StringFile file(MakePattern());
+    SystemUtils::Crc32c crc;
+    ASSERT_TRUE(crc.Update(file));
+    EXPECT_EQ(0xBD846CD7, crc.GetValue());
+    crc.Reset();
+    ASSERT_TRUE(crc.Update(file, 2, 9));
+    const std::string check = "\x02\x03\x04\x05\x06\x07\x08\x09\x0A";
+    EXPECT_EQ(SystemUtils::Crc32c::Compute(check.data(), check.length()), crc.GetValue());
+    EXPECT_FALSE(crc.Update(file, 10000, 1000));
+}
+
+TEST(Crc32cTests, Crc32cTests_FromFileInParallel_Test) {
+    SystemUtils::StringFile file(MakePattern());
+    uint32_t value = 0;
+    ASSERT_TRUE(SystemUtils::Crc32c::Compute(file, value, 0, 0, 4, 1000));
+    EXPECT_EQ(0xBD846CD7, value);
+    ASSERT_TRUE(SystemUtils::Crc32c::Compute(file, value, 1000, 0, 3, 777));
+    const auto pattern = MakePattern();
+    EXPECT_EQ(SystemUtils::Crc32c::Compute(pattern.data() + 1000, pattern.size() - 1000), value);
+    EXPECT_FALSE(SystemUtils::Crc32c::Compute(file, value, 0, 20000, 4, 1000));
+}
@@ -0,0 +1,108 @@
+/**
+ * @file DirectoryIteratorTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::DirectoryIterator class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <SystemUtils/DirectoryIterator.hpp>
+#include <SystemUtils/File.hpp>
+
+struct DirectoryIteratorTests: public ::testing::Test
+{
+    std::string testDirectoryPath;
+
+    virtual void SetUp() {
+        testDirectoryPath = SystemUtils::File::GetExeParentDirectory() + "/testDirectoryIteratorDirectory";
+        ASSERT_TRUE(SystemUtils::File::CreateDirectory(testDirectoryPath));
+    }
+
+    virtual void TearDown() {
+        ASSERT_TRUE(SystemUtils::File::DeleteDirectory(testDirectoryPath));
+    }
+
+    void MakeFile(const std::string& path, const std::string& contents) {
+        SystemUtils::File file(path);
+        ASSERT_TRUE(file.OpenReadWrite());
+        ASSERT_EQ(contents.length(), file.Write(contents.data(), contents.length()));
+    }
+};
+
+TEST_F(DirectoryIteratorTests, DirectoryIteratorTests_ListsEntriesWithMetadata_Test) {
+    MakeFile(testDirectoryPath + "/a.txt", "Hello");
+    MakeFile(testDirectoryPath + "/b.txt", "Hello, World!");
+    ASSERT_TRUE(SystemUtils::File::CreateDirectory(testDirectoryPath + "/sub"));
+    SystemUtils::DirectoryIterator iterator;
+    ASSERT_TRUE(iterator.Open(testDirectoryPath));
+    std::map< std::string, SystemUtils::DirectoryIterator::Entry > entries;
+    SystemUtils::DirectoryIterator::Entry entry;
+    while (iterator.Next(entry)) {
+        entries[entry.name] = entry;
+    }
+    ASSERT_EQ(3, entries.size());
+    EXPECT_EQ(SystemUtils::DirectoryIterator::EntryType::File, entries["a.txt"].type);
+    EXPECT_EQ(5, entries["a.txt"].size);
+    EXPECT_EQ(testDirectoryPath + "/a.txt", entries["a.txt"].path);
+    EXPECT_EQ(13, entries["b.txt"].size);
+    EXPECT_EQ(SystemUtils::File(testDirectoryPath + "/b.txt").GetLastModifiedTime(), entries["b.txt"].lastModifiedTime);
+    EXPECT_EQ(SystemUtils::DirectoryIterator::EntryType::Directory, entries["sub"].type);
+    EXPECT_FALSE(iterator.Next(entry));
+}
+
+TEST_F(DirectoryIteratorTests, DirectoryIteratorTests_SmallBatches_Test) {
+    for (int i = 0; i < 200; ++i) {
+        MakeFile(testDirectoryPath + "/file" + std::to_string(i) + ".txt", "x");
+    }
+    SystemUtils::DirectoryIterator iterator(1);
+    ASSERT_TRUE(iterator.Open(testDirectoryPath));
+    std::set< std::string > names;
+    SystemUtils::DirectoryIterator::Entry entry;
+    while (iterator.Next(entry)) {
+        EXPECT_TRUE(names.insert(entry.name).second) << entry.name;
+    }
+    EXPECT_EQ(200, names.size());
+}
+
+TEST_F(DirectoryIteratorTests, DirectoryIteratorTests_OpenMissingDirectory_Test) {
+    SystemUtils::DirectoryIterator iterator;
+    EXPECT_FALSE(iterator.Open(testDirectoryPath + "/missing"));
+    SystemUtils::DirectoryIterator::Entry entry;
+    EXPECT_FALSE(iterator.Next(entry));
+}
+
+TEST_F(DirectoryIteratorTests, DirectoryIteratorTests_Walk_Test) {
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            MakeFile(
+                testDirectoryPath + "/dir" + std::to_string(i)
+                + "/inner" + std::to_string(j) + "/file.txt",
+                "x"
+            );
+        }
+    }
+    MakeFile(testDirectoryPath + "/skip/hidden.txt", "x");
+    std::mutex mutex;
+    std::set< std::string > paths;
+    ASSERT_TRUE(
+        SystemUtils::DirectoryIterator::Walk(
+            testDirectoryPath,
+            [&](const SystemUtils::DirectoryIterator::Entry& entry){
+                std::lock_guard< std::mutex > lock(mutex);
+                (void)paths.insert(entry.path.substr(testDirectoryPath.length()));
+                return (entry.name != "skip");
+            },
+            4
+        )
+    );
+    EXPECT_EQ(1 + 5 + 25 + 25, paths.size());
+    EXPECT_EQ(1, paths.count("/dir3/inner2/file.txt"));
+    EXPECT_EQ(1, paths.count("/skip"));
+    EXPECT_EQ(0, paths.count("/skip/hidden.txt"));
+}
@@ -0,0 +1,103 @@
+/**
+ * @file InterfaceAddressCacheTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::InterfaceAddressCache class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <InterfaceAddressCache.hpp>
+
+namespace {
+
+    /**
+     * This stands in for the operating system, counting
+     * how many times it's asked for interface addresses.
+     */
+    struct FakeOperatingSystem {
+        /**
+         * These are the addresses reported for the network interfaces.
+         */
+        std::vector< uint32_t > addresses{ 0x7F000001 };
+
+        /**
+         * This is the number of times the addresses were queried.
+         */
+        size_t queries = 0;
+
+        /**
+         * This returns a function which queries the addresses.
+         */
+        SystemUtils::InterfaceAddressCache::QueryDelegate MakeQueryDelegate() {
+            return [this]{
+                ++queries;
+                return addresses;
+            };
+        }
+    };
+
+}
+
+TEST(InterfaceAddressCacheTests, InterfaceAddressCacheTests_QueriesOnlyOnce_Test) {
+    FakeOperatingSystem os;
+    SystemUtils::InterfaceAddressCache cache(os.MakeQueryDelegate());
+    ASSERT_EQ(0, os.queries);
+    ASSERT_EQ(os.addresses, cache.GetAddresses());
+    ASSERT_EQ(os.addresses, cache.GetAddresses());
+    ASSERT_EQ(1, os.queries);
+}
+
+TEST(InterfaceAddressCacheTests, InterfaceAddressCacheTests_QueriesAgainAfterInvalidate_Test) {
+    FakeOperatingSystem os;
+    SystemUtils::InterfaceAddressCache cache(os.MakeQueryDelegate());
+    (void)cache.GetAddresses();
+    os.addresses.push_back(0xC0A80102);
+    cache.Invalidate();
+    ASSERT_EQ(os.addresses, cache.GetAddresses());
+    ASSERT_EQ(2, os.queries);
+}
+
+TEST(InterfaceAddressCacheTests, InterfaceAddressCacheTests_SubscribersToldOfChanges_Test) {
+    FakeOperatingSystem os;
+    SystemUtils::InterfaceAddressCache cache(os.MakeQueryDelegate());
+    size_t changes1 = 0;
+    size_t changes2 = 0;
+    const auto unsubscribe1 = cache.Subscribe([&changes1]{ ++changes1; });
+    const auto unsubscribe2 = cache.Subscribe([&changes2]{ ++changes2; });
+    cache.Invalidate();
+    ASSERT_EQ(1, changes1);
+    ASSERT_EQ(1, changes2);
+    unsubscribe1();
+    cache.Invalidate();
+    ASSERT_EQ(1, changes1);
+    ASSERT_EQ(2, changes2);
+    unsubscribe2();
+}
+
+TEST(InterfaceAddressCacheTests, InterfaceAddressCacheTests_UnsubscribeFromWithinDelegate_Test) {
+    FakeOperatingSystem os;
+    SystemUtils::InterfaceAddressCache cache(os.MakeQueryDelegate());
+    size_t changes = 0;
+    SystemUtils::InterfaceAddressCache::UnsubscribeDelegate unsubscribe;
+    unsubscribe = cache.Subscribe(
+        [&changes, &unsubscribe]{
+            ++changes;
+            unsubscribe();
+        }
+    );
+    cache.Invalidate();
+    cache.Invalidate();
+    ASSERT_EQ(1, changes);
+}
+
+TEST(InterfaceAddressCacheTests, InterfaceAddressCacheTests_UnsubscribeAfterCacheDestroyed_Test) {
+    FakeOperatingSystem os;
+    SystemUtils::InterfaceAddressCache::UnsubscribeDelegate unsubscribe;
+    {
+        SystemUtils::InterfaceAddressCache cache(os.MakeQueryDelegate());
+        unsubscribe = cache.Subscribe([]{});
+    }
+    unsubscribe();
+}
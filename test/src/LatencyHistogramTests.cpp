@@ -0,0 +1,47 @@
+/**
+ * @file LatencyHistogramTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::LatencyHistogram class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <LatencyHistogram.hpp>
+
+TEST(LatencyHistogramTests, LatencyHistogramTests_StartsEmpty_Test) {
+    SystemUtils::LatencyHistogram histogram;
+    const auto counts = histogram.GetCounts();
+    ASSERT_EQ(SystemUtils::LatencyHistogram::NUM_BUCKETS, counts.size());
+    for (auto count: counts) {
+        ASSERT_EQ(0, count);
+    }
+}
+
+TEST(LatencyHistogramTests, LatencyHistogramTests_BucketBounds_Test) {
+    SystemUtils::LatencyHistogram histogram;
+    histogram.Record(-1.0);
+    histogram.Record(0.0000005);
+    histogram.Record(0.000001);
+    histogram.Record(0.0000019);
+    histogram.Record(0.000002);
+    histogram.Record(0.000003);
+    histogram.Record(0.000004);
+    histogram.Record(0.001);
+    histogram.Record(1000000.0);
+    const auto counts = histogram.GetCounts();
+    EXPECT_EQ(2, counts[0]);
+    EXPECT_EQ(2, counts[1]);
+    EXPECT_EQ(2, counts[2]);
+    EXPECT_EQ(1, counts[3]);
+    EXPECT_EQ(1, counts[10]);
+    EXPECT_EQ(1, counts[SystemUtils::LatencyHistogram::NUM_BUCKETS - 1]);
+}
+
+TEST(LatencyHistogramTests, LatencyHistogramTests_Reset_Test) {
+    SystemUtils::LatencyHistogram histogram;
+    histogram.Record(0.001);
+    histogram.Reset();
+    ASSERT_EQ(0, histogram.GetCounts()[10]);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file MpscQueueTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::MpscQueue class template.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <MpscQueue.hpp>
+#include <set>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+TEST(MpscQueueTests, MpscQueueTests_CapacityRoundedUpToPowerOfTwo_Test) {
+    SystemUtils::MpscQueue< int > queue(5);
+    ASSERT_EQ(8, queue.GetCapacity());
+}
+
+TEST(MpscQueueTests, MpscQueueTests_PushThenPopInOrder_Test) {
+    SystemUtils::MpscQueue< int > queue(4);
+    ASSERT_TRUE(queue.TryPush(1));
+    ASSERT_TRUE(queue.TryPush(2));
+    ASSERT_TRUE(queue.TryPush(3));
+    ASSERT_EQ(3, queue.GetSize());
+    int element = 0;
+    ASSERT_TRUE(queue.TryPop(element));
+    ASSERT_EQ(1, element);
+    ASSERT_TRUE(queue.TryPop(element));
+    ASSERT_EQ(2, element);
+    ASSERT_TRUE(queue.TryPop(element));
+    ASSERT_EQ(3, element);
+    ASSERT_FALSE(queue.TryPop(element));
+    ASSERT_EQ(0, queue.GetSize());
+}
+
+TEST(MpscQueueTests, MpscQueueTests_PushFailsWhenFull_Test) {
+    SystemUtils::MpscQueue< std::vector< uint8_t > > queue(2);
+    ASSERT_TRUE(queue.TryPush(std::vector< uint8_t >{1}));
+    ASSERT_TRUE(queue.TryPush(std::vector< uint8_t >{2}));
+    std::vector< uint8_t > rejected{3, 4, 5};
+    ASSERT_FALSE(queue.TryPush(std::move(rejected)));
+    ASSERT_EQ((std::vector< uint8_t >{3, 4, 5}), rejected);
+    std::vector< uint8_t > element;
+    ASSERT_TRUE(queue.TryPop(element));
+    ASSERT_EQ((std::vector< uint8_t >{1}), element);
+    ASSERT_TRUE(queue.TryPush(std::move(rejected)));
+}
+
+TEST(MpscQueueTests, MpscQueueTests_ManyProducersOneConsumer_Test) {
+    SystemUtils::MpscQueue< int > queue(64);
+    constexpr int numProducers = 4;
+    constexpr int elementsPerProducer = 10000;
+    std::vector< std::thread > producers;
+    for (int i = 0; i < numProducers; ++i) {
+        producers.emplace_back(
+            [&queue, i]{
+                for (int j = 0; j < elementsPerProducer; ++j) {
+                    int element = i * elementsPerProducer + j;
+                    while (!queue.TryPush(std::move(element))) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        );
+    }
+    std::set< int > received;
+    std::vector< int > lastFromProducer(numProducers, -1);
+    while (received.size() < numProducers * elementsPerProducer) {
+        int element;
+        if (queue.TryPop(element)) {
+            const auto producer = element / elementsPerProducer;
+            ASSERT_LT(lastFromProducer[producer], element);
+            lastFromProducer[producer] = element;
+            (void)received.insert(element);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer: producers) {
+        producer.join();
+    }
+    ASSERT_EQ(numProducers * elementsPerProducer, received.size());
+}
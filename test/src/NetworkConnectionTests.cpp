@@ -11,6 +11,7 @@
 #include <condition_variable>
 #include <SystemUtils/NetworkConnection.hpp>
 #include <SystemUtils/NetworkEndPoint.hpp>
+#include <SystemUtils/Time.hpp>
 #include <StringUtils/StringUtils.hpp>
 
 #ifdef _WIN32
@@ -567,4 +568,146 @@ TEST_F(NetworkConnectionTests, NetworkConnectionTests_CloseConnection_Test) {
     client.Close();
     ASSERT_TRUE(ownerConnectionServer.AwaitDisconnection());
     ASSERT_TRUE(ownerConnectionServer.connectionBroken);
-}
\ No newline at end of file
+}
+
+TEST_F(NetworkConnectionTests, NetworkConnectionTests_SendingMessagePaced_Test) {
+    SystemUtils::NetworkEndPoint server;
+    Owner serverConnectionOwner;
+    std::vector< std::shared_ptr< SystemUtils::NetworkConnection > > clients;
+    std::mutex callbackMutex;
+    const auto newConnectionDelegate = [&clients, &callbackMutex, &serverConnectionOwner](
+        std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+    ){
+        std::unique_lock< std::mutex > lock(callbackMutex);
+        clients.push_back(newConnection);
+        ASSERT_TRUE(
+            newConnection->Process(
+                [&serverConnectionOwner](const std::vector< uint8_t >& message){
+                    serverConnectionOwner.NetworkConnectionMessageReceived(message);
+                },
+                [&serverConnectionOwner](bool graceful){
+                    serverConnectionOwner.NetworkConnectionBroken(graceful);
+                }
+            )
+        );
+    };
+    const auto packetReceiveDelegate = [](
+        uint32_t address,
+        uint16_t port,
+        const std::vector<uint8_t>& body
+    ){
+    };
+    ASSERT_TRUE(
+        server.Open(
+            newConnectionDelegate,
+            packetReceiveDelegate,
+            SystemUtils::NetworkEndPoint::Mode::Connection,
+            0,
+            0,
+            0
+        )
+    );
+
+    // Pace the client to 20000 bytes per second.
+    SystemUtils::NetworkConnection::PacingPolicy policy;
+    policy.bytesPerSecond = 20000.0;
+    policy.burstBytes = 1000.0;
+    client.SetPacing(policy);
+    ASSERT_TRUE(client.Connect(0x7F000001, server.GetBoundPort()));
+    auto clientConnectionOwner = clientOwner;
+    ASSERT_TRUE(client.Process(
+        [clientConnectionOwner](const std::vector< uint8_t >& message ){
+            clientConnectionOwner->NetworkConnectionMessageReceived(message);
+        },
+        [clientConnectionOwner](bool graceful){
+            clientConnectionOwner->NetworkConnectionBroken(graceful);
+        }
+    ));
+
+    // Send more than one burst, and verify it's spread out,
+    // unless the operating system is doing the pacing.
+    SystemUtils::Time clock;
+    const auto start = clock.GetTime();
+    const std::vector< uint8_t > message(5000, 0x5A);
+    client.SendMessage(message);
+    ASSERT_TRUE(serverConnectionOwner.AwaitStream(message.size()));
+    ASSERT_EQ(message, serverConnectionOwner.streamReceived);
+    const auto statistics = client.GetPacingStatistics();
+    EXPECT_EQ(message.size(), statistics.bytesSent);
+    if (!statistics.offloaded) {
+        EXPECT_GE(clock.GetTime() - start, 0.15);
+        EXPECT_GT(statistics.throttles, 0);
+        EXPECT_GT(statistics.throttledTime, 0.0);
+    }
+}
+
+TEST_F(NetworkConnectionTests, NetworkConnectionTests_SendingMessageLargerThanSendBufferPaced_Test) {
+    SystemUtils::NetworkEndPoint server;
+    Owner serverConnectionOwner;
+    std::vector< std::shared_ptr< SystemUtils::NetworkConnection > > clients;
+    std::mutex callbackMutex;
+    const auto newConnectionDelegate = [&clients, &callbackMutex, &serverConnectionOwner](
+        std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+    ){
+        std::unique_lock< std::mutex > lock(callbackMutex);
+        clients.push_back(newConnection);
+        ASSERT_TRUE(
+            newConnection->Process(
+                [&serverConnectionOwner](const std::vector< uint8_t >& message){
+                    serverConnectionOwner.NetworkConnectionMessageReceived(message);
+                },
+                [&serverConnectionOwner](bool graceful){
+                    serverConnectionOwner.NetworkConnectionBroken(graceful);
+                }
+            )
+        );
+    };
+    const auto packetReceiveDelegate = [](
+        uint32_t,
+        uint16_t,
+        const std::vector<uint8_t>&
+    ){
+    };
+    ASSERT_TRUE(
+        server.Open(
+            newConnectionDelegate,
+            packetReceiveDelegate,
+            SystemUtils::NetworkEndPoint::Mode::Connection,
+            0,
+            0,
+            0
+        )
+    );
+
+    // Pace the client fast enough to finish quickly, but send much
+    // more than fits in the socket send buffer, so that sends block
+    // whether the pacing is done by the operating system or not.
+    SystemUtils::NetworkConnection::PacingPolicy policy;
+    policy.bytesPerSecond = 4000000.0;
+    policy.burstBytes = 65536.0;
+    client.SetPacing(policy);
+    ASSERT_TRUE(client.Connect(0x7F000001, server.GetBoundPort()));
+    auto clientConnectionOwner = clientOwner;
+    ASSERT_TRUE(client.Process(
+        [clientConnectionOwner](const std::vector< uint8_t >& message ){
+            clientConnectionOwner->NetworkConnectionMessageReceived(message);
+        },
+        [clientConnectionOwner](bool graceful){
+            clientConnectionOwner->NetworkConnectionBroken(graceful);
+        }
+    ));
+    std::vector< uint8_t > message(1024 * 1024);
+    for (size_t i = 0; i < message.size(); ++i) {
+        message[i] = (uint8_t)i;
+    }
+    client.SendMessage(message);
+    for (int i = 0; i < 5; ++i) {
+        if (serverConnectionOwner.AwaitStream(message.size())) {
+            break;
+        }
+    }
+    ASSERT_EQ(message, serverConnectionOwner.streamReceived);
+    EXPECT_FALSE(clientOwner->connectionBroken);
+    EXPECT_FALSE(serverConnectionOwner.connectionBroken);
+    EXPECT_TRUE(client.IsConnected());
+}
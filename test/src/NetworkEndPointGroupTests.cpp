@@ -0,0 +1,181 @@
+/**
+ * @file NetworkEndPointGroupTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::NetworkEndPointGroup class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <SystemUtils/NetworkEndPoint.hpp>
+#include <SystemUtils/NetworkEndPointGroup.hpp>
+
+#ifdef _WIN32
+/**
+ * WinSock2.h should be included first because if Windows.h is
+ * included before it, WinSock.h gets included which conflicts
+ * with WinSock2.h.
+ *
+ * Windows.h should always be included next because other Windows header
+ * files, such as KnownFolders.h, don't always define things properly if
+ * you don't include Windows.h beforhand.
+*/
+#include <WinSock2.h>
+#include <Windows.h>
+#include <WS2tcpip.h>
+#pragma comment(lib, "ws2_32")
+#undef ERROR
+#undef SendMessage
+#undef min
+#undef max
+#else
+#include <sys/socket.h>
+#endif /* _WIN32 or POSIX */
+
+namespace {
+
+    /**
+     * This is used to receive callbacks from the units under test.
+     */
+    struct Owner {
+        /**
+         * This is used to synchronize access to the class.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wait for, or signal, a condition upon
+         * which that the owner might be waiting.
+         */
+        std::condition_variable_any condition;
+
+        /**
+         * These are the bound ports of the endpoints
+         * which have received a datagram.
+         */
+        std::set< uint16_t > portsReceived;
+
+        /**
+         * This method waits up to a second for datagrams
+         * to be received by the given number of endpoints.
+         *
+         * @param[in] numEndPoints
+         *      This is the number of endpoints expected
+         *      to receive a datagram.
+         *
+         * @return
+         *      An indication of whether or not the datagrams
+         *      were received is returned.
+         */
+        bool AwaitPackets(size_t numEndPoints) {
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            return condition.wait_for(
+                lock,
+                std::chrono::seconds(1),
+                [this, numEndPoints]{
+                    return (portsReceived.size() >= numEndPoints);
+                }
+            );
+        }
+
+        /**
+         * This is called whenever an endpoint receives a datagram.
+         */
+        void PacketReceived(uint16_t port) {
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            (void)portsReceived.insert(port);
+            condition.notify_all();
+        }
+    };
+
+}
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct NetworkEndPointGroupTests : public ::testing::Test {
+    /**
+     * This keeps track of whether or not WSAStartup succeeded,
+     * because if so we need to call WSACleanup upon teardown.
+     */
+    bool wsaStarted = false;
+
+    virtual void SetUp() {
+#if _WIN32
+        WSADATA wsaData;
+        if (!WSAStartup(MAKEWORD(2, 0), &wsaData)) {
+            wsaStarted = true;
+        }
+#endif /* _WIN32 */
+    }
+
+    virtual void TearDown() {
+#if _WIN32
+        if (wsaStarted) {
+            (void)WSACleanup();
+        }
+#endif /* _WIN32 */
+    }
+};
+
+TEST_F(NetworkEndPointGroupTests, NetworkEndPointGroupTests_MembersReceiveOnSharedThread_Test) {
+    // Set up two endpoints processed by one group.
+    SystemUtils::NetworkEndPointGroup group;
+    Owner owner;
+    SystemUtils::NetworkEndPoint endPoints[2];
+    for (auto& endPoint: endPoints) {
+        endPoint.JoinGroup(group);
+        const auto endPointPointer = &endPoint;
+        ASSERT_TRUE(
+            endPoint.Open(
+                [](std::shared_ptr< SystemUtils::NetworkConnection >){},
+                [&owner, endPointPointer](
+                    uint32_t,
+                    uint16_t,
+                    const std::vector< uint8_t >&
+                ){ owner.PacketReceived(endPointPointer->GetBoundPort()); },
+                SystemUtils::NetworkEndPoint::Mode::Datagram,
+                0,
+                0,
+                0
+            )
+        );
+    }
+    ASSERT_EQ(2, group.GetMemberCount());
+
+    // Send a datagram to each endpoint.
+    auto sender = socket(AF_INET, SOCK_DGRAM, 0);
+    const std::vector< uint8_t > testPacket{ 0x12, 0x34, 0x56, 0x78 };
+    for (auto& endPoint: endPoints) {
+        struct sockaddr_in receiverAddress;
+        (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+        receiverAddress.sin_family = AF_INET;
+        receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+        receiverAddress.sin_port = htons(endPoint.GetBoundPort());
+        (void)sendto(
+            sender,
+            (const char*)testPacket.data(),
+            (int)testPacket.size(),
+            0,
+            (const sockaddr*)&receiverAddress,
+            sizeof(receiverAddress)
+        );
+    }
+
+    // Verify both endpoints received their datagrams.
+    ASSERT_TRUE(owner.AwaitPackets(2));
+
+    // Verify members leave the group when closed.
+    endPoints[0].Close();
+    ASSERT_EQ(1, group.GetMemberCount());
+    endPoints[1].Close();
+    ASSERT_EQ(0, group.GetMemberCount());
+#if _WIN32
+    (void)closesocket(sender);
+#endif /* _WIN32 */
+}
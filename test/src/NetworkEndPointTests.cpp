@@ -10,7 +10,11 @@
 #include <gtest/gtest.h>
 #include <condition_variable>
 #include <mutex>
+#include <numeric>
+#include <thread>
 #include <SystemUtils/NetworkEndPoint.hpp>
+#include <SystemUtils/Subprocess.hpp>
+#include <SystemUtils/Time.hpp>
 
 #ifdef _WIN32
 /**
@@ -542,3 +546,689 @@ TEST_F(NetworkEndPointTests, NetworkEndPointTests_ConnectionReceiving_Test) {
     owner.AwaitStream(testPacket.size());
     ASSERT_EQ(testPacket, owner.streamReceived);
 }
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_DatagramSendingMovedAndShared_Test) {
+    auto receiver = socket(
+        AF_INET,
+        SOCK_DGRAM,
+        0
+    );
+#if _WIN32
+    ASSERT_FALSE(receiver == INVALID_SOCKET);
+#else   /* POSIX */
+    ASSERT_FALSE(receiver < 0);
+#endif /* _WIN32 or POSIX */
+
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = 0;
+    receiverAddress.sin_port = 0;
+    ASSERT_TRUE(bind(receiver, (struct  sockaddr*)&receiverAddress, sizeof(receiverAddress)) == 0);
+    int receiverAddressLength = sizeof(receiverAddress);
+    uint16_t port;
+    ASSERT_TRUE(getsockname(receiver, (struct sockaddr*)&receiverAddress, &receiverAddressLength) == 0);
+    port = ntohs(receiverAddress.sin_port);
+
+    //Set up the NetworkEndPoint.
+    SystemUtils::NetworkEndPoint endPoint;
+    Owner owner;
+    endPoint.Open(
+        [&owner](
+            std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+        ){ owner.NetworkEndPointNewConnection(newConnection); },
+        [&owner](
+            uint32_t address,
+            uint16_t port,
+            const std::vector< uint8_t >& body
+        ){ owner.NetworkEndPointPacketReceived(address, port, body); },
+        SystemUtils::NetworkEndPoint::Mode::Datagram,
+        0,
+        0,
+        0
+    );
+
+    // Test sending a moved datagram, and then a shared one.
+    endPoint.SendPacket(0x7F000001, port, std::vector< uint8_t >{ 0x12, 0x34 });
+    const auto sharedPacket = std::make_shared< const std::vector< uint8_t > >(
+        std::vector< uint8_t >{ 0x56, 0x78, 0x9A }
+    );
+    endPoint.SendPacket(0x7F000001, port, sharedPacket);
+
+    // Verify that we received both datagrams, in order.
+    for (const auto& expectedPacket: {
+        std::vector< uint8_t >{ 0x12, 0x34 },
+        *sharedPacket
+    }) {
+        struct sockaddr_in senderAddress;
+        int senderAddressSize = sizeof(senderAddress);
+        std::vector< uint8_t > buffer(16);
+        const int amountReceived = recvfrom(
+            receiver,
+            (char*)buffer.data(),
+            (int)buffer.size(),
+            0,
+            (struct sockaddr*)&senderAddress,
+            &senderAddressSize
+        );
+        ASSERT_EQ(expectedPacket.size(), amountReceived);
+        buffer.resize(amountReceived);
+        ASSERT_EQ(expectedPacket, buffer);
+    }
+    ASSERT_EQ(0, endPoint.GetSendPacketsDropped());
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_SendQueueOverflowPolicy_Test) {
+    // With the endpoint not yet open, nothing drains the send queue.
+    SystemUtils::NetworkEndPoint endPoint;
+    endPoint.SetSendQueueLimit(2, SystemUtils::NetworkEndPoint::SendQueueOverflowPolicy::DropNewest);
+    for (uint8_t i = 0; i < 5; ++i) {
+        endPoint.SendPacket(0x7F000001, 1234, std::vector< uint8_t >{ i });
+    }
+    ASSERT_EQ(3, endPoint.GetSendPacketsDropped());
+
+    SystemUtils::NetworkEndPoint endPoint2;
+    endPoint2.SetSendQueueLimit(2, SystemUtils::NetworkEndPoint::SendQueueOverflowPolicy::DropOldest);
+    for (uint8_t i = 0; i < 5; ++i) {
+        endPoint2.SendPacket(0x7F000001, 1234, std::vector< uint8_t >{ i });
+    }
+    ASSERT_EQ(3, endPoint2.GetSendPacketsDropped());
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_DatagramReceivingShared_Test) {
+     auto sender = socket(
+        AF_INET,
+        SOCK_DGRAM,
+        0
+    );
+#if _WIN32
+    ASSERT_FALSE(sender == INVALID_SOCKET);
+#else   /* POSIX */
+    ASSERT_FALSE(sender < 0);
+#endif /* _WIN32 or POSIX */
+
+    struct sockaddr_in senderAddress;
+    (void)memset(&senderAddress, 0, sizeof(senderAddress));
+    senderAddress.sin_family = AF_INET;
+    senderAddress.sin_addr.S_un.S_addr = 0;
+    senderAddress.sin_port = 0;
+    ASSERT_TRUE(bind(sender, (struct  sockaddr*)&senderAddress, sizeof(senderAddress)) == 0);
+    int senderAddressLength = sizeof(senderAddress);
+    ASSERT_TRUE(getsockname(sender, (struct sockaddr*)&senderAddress, &senderAddressLength) == 0);
+
+    //Set up the NetworkEndPoint, keeping a reference to each packet received.
+    SystemUtils::NetworkEndPoint endPoint;
+    Owner owner;
+    std::vector< SystemUtils::NetworkEndPoint::SharedBuffer > bodiesKept;
+    endPoint.Open(
+        [&owner](
+            std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+        ){ owner.NetworkEndPointNewConnection(newConnection); },
+        [&owner, &bodiesKept](
+            uint32_t address,
+            uint16_t port,
+            SystemUtils::NetworkEndPoint::SharedBuffer body
+        ){
+            {
+                std::unique_lock< decltype(owner.mutex) > lock(owner.mutex);
+                bodiesKept.push_back(body);
+            }
+            owner.NetworkEndPointPacketReceived(address, port, *body);
+        },
+        SystemUtils::NetworkEndPoint::Mode::Datagram,
+        0,
+        0,
+        0
+    );
+
+    // Test receiving a datagram at the unit under test
+    const std::vector< uint8_t > testPacket{ 0x12, 0x34, 0x56, 0x78 };
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+    receiverAddress.sin_port = htons(endPoint.GetBoundPort());
+    (void)sendto(
+        sender,
+        (const char*)testPacket.data(),
+        (int)testPacket.size(),
+        0,
+        (const sockaddr*)&receiverAddress,
+        sizeof(receiverAddress)
+    );
+
+    //Verify that we received the datagram, and may keep it.
+    ASSERT_TRUE(owner.AwaitPacket());
+    endPoint.Close();
+    ASSERT_EQ(1, bodiesKept.size());
+    ASSERT_EQ(testPacket, *bodiesKept[0]);
+    ASSERT_EQ(0, endPoint.GetReceivePacketsTruncated());
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_AdmissionPolicyRefusesExcessConnections_Test) {
+    //Set up the NetworkEndPoint.
+    SystemUtils::NetworkEndPoint endPoint;
+    SystemUtils::NetworkEndPoint::AdmissionPolicy policy;
+    policy.maxConnections = 1;
+    endPoint.SetAdmissionPolicy(policy);
+    Owner owner;
+    ASSERT_TRUE(
+        endPoint.Open(
+            [&owner](
+                std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+            ){ owner.NetworkEndPointNewConnection(newConnection); },
+            [&owner](
+                uint32_t address,
+                uint16_t port,
+                const std::vector< uint8_t >& body
+            ){ owner.NetworkEndPointPacketReceived(address, port, body); },
+            SystemUtils::NetworkEndPoint::Mode::Connection,
+            0,
+            0,
+            0
+        )
+    );
+
+    //Connect to the NetworkEndPoint twice.
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+    receiverAddress.sin_port = htons(endPoint.GetBoundPort());
+    auto client1 = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE(
+        connect(
+            client1,
+            (const sockaddr*)&receiverAddress,
+            sizeof(receiverAddress)
+        ) == 0
+    );
+    ASSERT_TRUE(owner.AwaitConnection());
+    auto client2 = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_FALSE(
+        connect(
+            client2,
+            (const sockaddr*)&receiverAddress,
+            sizeof(receiverAddress)
+        ) == 0
+    );
+
+    // Verify that only the first connection was admitted.
+    const auto statistics = endPoint.GetAdmissionStatistics();
+    EXPECT_EQ(1, statistics.admitted);
+    EXPECT_EQ(1, statistics.rejectedTooManyConnections);
+    EXPECT_EQ(1, statistics.connectionsOpen);
+    EXPECT_EQ(1, owner.connections.size());
+#if _WIN32
+    (void)closesocket(client1);
+    (void)closesocket(client2);
+#endif /* _WIN32 */
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_DatagramReceivingTimestamped_Test) {
+    auto sender = socket(
+        AF_INET,
+        SOCK_DGRAM,
+        0
+    );
+#if _WIN32
+    ASSERT_FALSE(sender == INVALID_SOCKET);
+#else   /* POSIX */
+    ASSERT_FALSE(sender < 0);
+#endif /* _WIN32 or POSIX */
+
+    //Set up the NetworkEndPoint, remembering when each packet arrived.
+    SystemUtils::NetworkEndPoint endPoint;
+    SystemUtils::Time clock;
+    Owner owner;
+    std::vector< double > receiveTimes;
+    std::vector< double > deliveryTimes;
+    ASSERT_TRUE(
+        endPoint.Open(
+            [&owner](
+                std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+            ){ owner.NetworkEndPointNewConnection(newConnection); },
+            [&owner, &clock, &receiveTimes, &deliveryTimes](
+                uint32_t address,
+                uint16_t port,
+                SystemUtils::NetworkEndPoint::SharedBuffer body,
+                double receiveTime
+            ){
+                {
+                    std::unique_lock< decltype(owner.mutex) > lock(owner.mutex);
+                    receiveTimes.push_back(receiveTime);
+                    deliveryTimes.push_back(clock.GetTime());
+                }
+                owner.NetworkEndPointPacketReceived(address, port, *body);
+            },
+            SystemUtils::NetworkEndPoint::Mode::Datagram,
+            0,
+            0,
+            0
+        )
+    );
+
+    // Test receiving a datagram at the unit under test
+    const std::vector< uint8_t > testPacket{ 0x12, 0x34, 0x56, 0x78 };
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+    receiverAddress.sin_port = htons(endPoint.GetBoundPort());
+    const auto sendTime = clock.GetTime();
+    (void)sendto(
+        sender,
+        (const char*)testPacket.data(),
+        (int)testPacket.size(),
+        0,
+        (const sockaddr*)&receiverAddress,
+        sizeof(receiverAddress)
+    );
+
+    //Verify that the datagram was timestamped between sending and delivery.
+    ASSERT_TRUE(owner.AwaitPacket());
+    endPoint.Close();
+    ASSERT_EQ(1, receiveTimes.size());
+    EXPECT_LE(sendTime, receiveTimes[0]);
+    EXPECT_LE(receiveTimes[0], deliveryTimes[0]);
+    const auto histogram = endPoint.GetReceiveLatencyHistogram();
+    EXPECT_EQ(1, std::accumulate(histogram.begin(), histogram.end(), (uint64_t)0));
+#if _WIN32
+    (void)closesocket(sender);
+#endif /* _WIN32 */
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_DatagramReceivingBusyPoll_Test) {
+    auto sender = socket(
+        AF_INET,
+        SOCK_DGRAM,
+        0
+    );
+#if _WIN32
+    ASSERT_FALSE(sender == INVALID_SOCKET);
+#else   /* POSIX */
+    ASSERT_FALSE(sender < 0);
+#endif /* _WIN32 or POSIX */
+
+    //Set up the NetworkEndPoint in busy poll mode.
+    SystemUtils::NetworkEndPoint endPoint;
+    endPoint.SetBusyPoll(0.01);
+    Owner owner;
+    ASSERT_TRUE(
+        endPoint.Open(
+            [&owner](
+                std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+            ){ owner.NetworkEndPointNewConnection(newConnection); },
+            [&owner](
+                uint32_t address,
+                uint16_t port,
+                const std::vector< uint8_t >& body
+            ){ owner.NetworkEndPointPacketReceived(address, port, body); },
+            SystemUtils::NetworkEndPoint::Mode::Datagram,
+            0,
+            0,
+            0
+        )
+    );
+
+    // Test receiving a datagram at the unit under test
+    const std::vector< uint8_t > testPacket{ 0x12, 0x34, 0x56, 0x78 };
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+    receiverAddress.sin_port = htons(endPoint.GetBoundPort());
+    (void)sendto(
+        sender,
+        (const char*)testPacket.data(),
+        (int)testPacket.size(),
+        0,
+        (const sockaddr*)&receiverAddress,
+        sizeof(receiverAddress)
+    );
+
+    //Verify that we received the datagram, and spent some time polling.
+    ASSERT_TRUE(owner.AwaitPacket());
+    endPoint.Close();
+    ASSERT_EQ(testPacket, owner.packetsReceived[0].body);
+    EXPECT_GT(endPoint.GetBusyPollStatistics().spinTime, 0.0);
+#if _WIN32
+    (void)closesocket(sender);
+#endif /* _WIN32 */
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_HandOffListeningSocket_Test) {
+    //Set up the NetworkEndPoint which will hand off its socket.
+    SystemUtils::NetworkEndPoint oldEndPoint;
+    Owner oldOwner;
+    ASSERT_TRUE(
+        oldEndPoint.Open(
+            [&oldOwner](
+                std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+            ){ oldOwner.NetworkEndPointNewConnection(newConnection); },
+            [&oldOwner](
+                uint32_t address,
+                uint16_t port,
+                const std::vector< uint8_t >& body
+            ){ oldOwner.NetworkEndPointPacketReceived(address, port, body); },
+            SystemUtils::NetworkEndPoint::Mode::Connection,
+            0,
+            0,
+            0
+        )
+    );
+    const auto port = oldEndPoint.GetBoundPort();
+
+    // Hand off the socket to a NetworkEndPoint taking it over.
+    // The same process plays both parts here.
+    SystemUtils::NetworkEndPoint newEndPoint;
+    Owner newOwner;
+    bool openedFromExisting = false;
+    std::thread taker(
+        [&newEndPoint, &newOwner, &openedFromExisting]{
+            openedFromExisting = newEndPoint.OpenFromExisting(
+                [&newOwner](
+                    std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+                ){ newOwner.NetworkEndPointNewConnection(newConnection); },
+                [&newOwner](
+                    uint32_t address,
+                    uint16_t port,
+                    const std::vector< uint8_t >& body
+                ){ newOwner.NetworkEndPointPacketReceived(address, port, body); },
+                1.0
+            );
+        }
+    );
+    const auto handedOff = oldEndPoint.HandOff(
+        SystemUtils::Subprocess::GetCurrentProcessId(),
+        1.0
+    );
+    taker.join();
+    ASSERT_TRUE(handedOff);
+    ASSERT_TRUE(openedFromExisting);
+    EXPECT_EQ(port, newEndPoint.GetBoundPort());
+
+    // Verify that connections now go to the new NetworkEndPoint.
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+    receiverAddress.sin_port = htons(port);
+    auto client = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE(
+        connect(
+            client,
+            (const sockaddr*)&receiverAddress,
+            sizeof(receiverAddress)
+        ) == 0
+    );
+    ASSERT_TRUE(newOwner.AwaitConnection());
+    EXPECT_EQ(0, oldOwner.connections.size());
+#if _WIN32
+    (void)closesocket(client);
+#endif /* _WIN32 */
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_DatagramSendingPaced_Test) {
+    auto receiver = socket(
+        AF_INET,
+        SOCK_DGRAM,
+        0
+    );
+#if _WIN32
+    ASSERT_FALSE(receiver == INVALID_SOCKET);
+#else   /* POSIX */
+    ASSERT_FALSE(receiver < 0);
+#endif /* _WIN32 or POSIX */
+
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = 0;
+    receiverAddress.sin_port = 0;
+    ASSERT_TRUE(bind(receiver, (struct  sockaddr*)&receiverAddress, sizeof(receiverAddress)) == 0);
+    int receiverAddressLength = sizeof(receiverAddress);
+    ASSERT_TRUE(getsockname(receiver, (struct sockaddr*)&receiverAddress, &receiverAddressLength) == 0);
+    const auto port = ntohs(receiverAddress.sin_port);
+
+    //Set up the NetworkEndPoint, pacing it to 10000 bytes per second.
+    SystemUtils::NetworkEndPoint endPoint;
+    SystemUtils::NetworkEndPoint::PacingPolicy policy;
+    policy.bytesPerSecond = 10000.0;
+    policy.burstBytes = 1000.0;
+    endPoint.SetPacing(policy);
+    Owner owner;
+    ASSERT_TRUE(
+        endPoint.Open(
+            [&owner](
+                std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+            ){ owner.NetworkEndPointNewConnection(newConnection); },
+            [&owner](
+                uint32_t address,
+                uint16_t port,
+                const std::vector< uint8_t >& body
+            ){ owner.NetworkEndPointPacketReceived(address, port, body); },
+            SystemUtils::NetworkEndPoint::Mode::Datagram,
+            0,
+            0,
+            0
+        )
+    );
+
+    // Send a burst of datagrams, and verify they're spread out.
+    SystemUtils::Time clock;
+    const auto start = clock.GetTime();
+    const std::vector< uint8_t > testPacket(1000, 0x5A);
+    for (size_t i = 0; i < 5; ++i) {
+        endPoint.SendPacket(0x7F000001, port, testPacket);
+    }
+    std::vector< uint8_t > buffer(testPacket.size() * 2);
+    for (size_t i = 0; i < 5; ++i) {
+        const int amountReceived = recv(
+            receiver,
+            (char*)buffer.data(),
+            (int)buffer.size(),
+            0
+        );
+        ASSERT_EQ(testPacket.size(), amountReceived);
+    }
+    EXPECT_GE(clock.GetTime() - start, 0.35);
+    const auto statistics = endPoint.GetPacingStatistics();
+    EXPECT_EQ(5000, statistics.bytesSent);
+    EXPECT_GT(statistics.throttles, 0);
+    EXPECT_GT(statistics.throttledTime, 0.0);
+    EXPECT_FALSE(statistics.offloaded);
+#if _WIN32
+    (void)closesocket(receiver);
+#endif /* _WIN32 */
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_MulticastSendingPaced_Test) {
+    auto receiver = socket(
+        AF_INET,
+        SOCK_DGRAM,
+        0
+    );
+#if _WIN32
+    ASSERT_FALSE(receiver == INVALID_SOCKET);
+#else   /* POSIX */
+    ASSERT_FALSE(receiver < 0);
+#endif /* _WIN32 or POSIX */
+
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = 0;
+    receiverAddress.sin_port = 0;
+    ASSERT_TRUE(bind(receiver, (struct  sockaddr*)&receiverAddress, sizeof(receiverAddress)) == 0);
+    int receiverAddressLength = sizeof(receiverAddress);
+    ASSERT_TRUE(getsockname(receiver, (struct sockaddr*)&receiverAddress, &receiverAddressLength) == 0);
+    const auto port = ntohs(receiverAddress.sin_port);
+
+    // Set up a multicast sending NetworkEndPoint on the loopback
+    // interface, pacing it to 10000 bytes per second.
+    SystemUtils::NetworkEndPoint endPoint;
+    SystemUtils::NetworkEndPoint::PacingPolicy policy;
+    policy.bytesPerSecond = 10000.0;
+    policy.burstBytes = 1000.0;
+    endPoint.SetPacing(policy);
+    ASSERT_TRUE(
+        endPoint.Open(
+            [](
+                std::shared_ptr< SystemUtils::NetworkConnection >
+            ){},
+            [](
+                uint32_t,
+                uint16_t,
+                const std::vector< uint8_t >&
+            ){},
+            SystemUtils::NetworkEndPoint::Mode::MulticastSend,
+            0x7F000001,
+            0,
+            0
+        )
+    );
+
+    // Send a burst of datagrams, and verify they're spread out.
+    // They're sent to a unicast receiver, so that the test doesn't
+    // depend on how the host routes multicast traffic.
+    SystemUtils::Time clock;
+    const auto start = clock.GetTime();
+    const std::vector< uint8_t > testPacket(1000, 0x5A);
+    for (size_t i = 0; i < 5; ++i) {
+        endPoint.SendPacket(0x7F000001, port, testPacket);
+    }
+    std::vector< uint8_t > buffer(testPacket.size() * 2);
+    for (size_t i = 0; i < 5; ++i) {
+        const int amountReceived = recv(
+            receiver,
+            (char*)buffer.data(),
+            (int)buffer.size(),
+            0
+        );
+        ASSERT_EQ(testPacket.size(), amountReceived);
+    }
+    EXPECT_GE(clock.GetTime() - start, 0.35);
+    const auto statistics = endPoint.GetPacingStatistics();
+    EXPECT_EQ(5000, statistics.bytesSent);
+    EXPECT_GT(statistics.throttles, 0);
+    EXPECT_GT(statistics.throttledTime, 0.0);
+#if _WIN32
+    (void)closesocket(receiver);
+#endif /* _WIN32 */
+}
+
+TEST_F(NetworkEndPointTests, NetworkEndPointTests_DatagramSessions_Test) {
+    //Set up the NetworkEndPoint, keeping a session for each peer.
+    SystemUtils::NetworkEndPoint endPoint;
+    Owner owner;
+    Owner sessionOwners[2];
+    std::mutex sessionsMutex;
+    std::condition_variable sessionsCondition;
+    std::vector< uint16_t > sessionPorts;
+    std::vector< uint16_t > closedSessionPorts;
+    endPoint.EnableSessions(
+        [&sessionOwners, &sessionsMutex, &sessionPorts](
+            uint32_t address,
+            uint16_t port
+        ) -> SystemUtils::NetworkEndPoint::SharedPacketReceivedDelegate {
+            std::lock_guard< std::mutex > lock(sessionsMutex);
+            if (sessionPorts.size() >= 2) {
+                return nullptr;
+            }
+            auto& sessionOwner = sessionOwners[sessionPorts.size()];
+            sessionPorts.push_back(port);
+            return [&sessionOwner](
+                uint32_t address,
+                uint16_t port,
+                SystemUtils::NetworkEndPoint::SharedBuffer body
+            ){ sessionOwner.NetworkEndPointPacketReceived(address, port, *body); };
+        },
+        [&sessionsMutex, &sessionsCondition, &closedSessionPorts](
+            uint32_t address,
+            uint16_t port
+        ){
+            std::lock_guard< std::mutex > lock(sessionsMutex);
+            closedSessionPorts.push_back(port);
+            sessionsCondition.notify_all();
+        },
+        0.2
+    );
+    ASSERT_TRUE(
+        endPoint.Open(
+            [&owner](
+                std::shared_ptr< SystemUtils::NetworkConnection > newConnection
+            ){ owner.NetworkEndPointNewConnection(newConnection); },
+            [&owner](
+                uint32_t address,
+                uint16_t port,
+                const std::vector< uint8_t >& body
+            ){ owner.NetworkEndPointPacketReceived(address, port, body); },
+            SystemUtils::NetworkEndPoint::Mode::Datagram,
+            0,
+            0,
+            0
+        )
+    );
+
+    // Send a datagram to the unit under test from each of two peers.
+    struct sockaddr_in receiverAddress;
+    (void)memset(&receiverAddress, 0, sizeof(receiverAddress));
+    receiverAddress.sin_family = AF_INET;
+    receiverAddress.sin_addr.S_un.S_addr = htonl(0x7F000001);
+    receiverAddress.sin_port = htons(endPoint.GetBoundPort());
+    decltype(socket(AF_INET, SOCK_DGRAM, 0)) peers[2];
+    uint16_t peerPorts[2];
+    for (size_t i = 0; i < 2; ++i) {
+        peers[i] = socket(AF_INET, SOCK_DGRAM, 0);
+        struct sockaddr_in peerAddress;
+        (void)memset(&peerAddress, 0, sizeof(peerAddress));
+        peerAddress.sin_family = AF_INET;
+        ASSERT_TRUE(bind(peers[i], (struct sockaddr*)&peerAddress, sizeof(peerAddress)) == 0);
+        int peerAddressLength = sizeof(peerAddress);
+        ASSERT_TRUE(getsockname(peers[i], (struct sockaddr*)&peerAddress, &peerAddressLength) == 0);
+        peerPorts[i] = ntohs(peerAddress.sin_port);
+        const std::vector< uint8_t > testPacket{ 0x12, (uint8_t)i };
+        (void)sendto(
+            peers[i],
+            (const char*)testPacket.data(),
+            (int)testPacket.size(),
+            0,
+            (const sockaddr*)&receiverAddress,
+            sizeof(receiverAddress)
+        );
+        ASSERT_TRUE(sessionOwners[i].AwaitPacket());
+        EXPECT_EQ(testPacket, sessionOwners[i].packetsReceived[0].body);
+        EXPECT_EQ(peerPorts[i], sessionOwners[i].packetsReceived[0].port);
+    }
+    EXPECT_EQ(2, endPoint.GetSessionCount());
+    EXPECT_TRUE(owner.packetsReceived.empty());
+
+    // Verify that replies go through the session queues.
+    for (size_t i = 0; i < 2; ++i) {
+        const std::vector< uint8_t > reply{ 0x34, (uint8_t)i };
+        endPoint.SendPacket(0x7F000001, peerPorts[i], reply);
+        std::vector< uint8_t > buffer(16);
+        const int amountReceived = recv(peers[i], (char*)buffer.data(), (int)buffer.size(), 0);
+        ASSERT_EQ(reply.size(), amountReceived);
+        buffer.resize(amountReceived);
+        EXPECT_EQ(reply, buffer);
+    }
+
+    // Verify that the sessions end once they're idle.
+    {
+        std::unique_lock< std::mutex > lock(sessionsMutex);
+        ASSERT_TRUE(
+            sessionsCondition.wait_for(
+                lock,
+                std::chrono::seconds(2),
+                [&closedSessionPorts]{ return (closedSessionPorts.size() == 2); }
+            )
+        );
+    }
+    EXPECT_EQ(0, endPoint.GetSessionCount());
+#if _WIN32
+    (void)closesocket(peers[0]);
+    (void)closesocket(peers[1]);
+#endif /* _WIN32 */
+}
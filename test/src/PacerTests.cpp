@@ -0,0 +1,73 @@
+/**
+ * @file PacerTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::Pacer class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <Pacer.hpp>
+
+TEST(PacerTests, PacerTests_UnlimitedByDefault_Test) {
+    SystemUtils::Pacer pacer;
+    ASSERT_FALSE(pacer.IsLimited());
+    double wait = 0.0;
+    ASSERT_EQ(1000000, pacer.Allow(0.0, 1000000, false, wait));
+    pacer.Consume(0.0, 1000000);
+    const auto statistics = pacer.GetStatistics(0.0);
+    EXPECT_EQ(1000000, statistics.bytesSent);
+    EXPECT_EQ(0, statistics.throttles);
+}
+
+TEST(PacerTests, PacerTests_PartialSendsLimitedToAvailable_Test) {
+    SystemUtils::Pacer pacer;
+    pacer.SetRate(1000.0, 500.0);
+    ASSERT_TRUE(pacer.IsLimited());
+    double wait = 0.0;
+    ASSERT_EQ(500, pacer.Allow(0.0, 2000, false, wait));
+    pacer.Consume(0.0, 500);
+    ASSERT_EQ(0, pacer.Allow(0.0, 1500, false, wait));
+    EXPECT_DOUBLE_EQ(0.001, wait);
+    ASSERT_EQ(250, pacer.Allow(0.25, 1500, false, wait));
+}
+
+TEST(PacerTests, PacerTests_WholeDatagramsWaitForRoom_Test) {
+    SystemUtils::Pacer pacer;
+    pacer.SetRate(1000.0, 1500.0);
+    double wait = 0.0;
+    ASSERT_EQ(1000, pacer.Allow(0.0, 1000, true, wait));
+    pacer.Consume(0.0, 1000);
+    ASSERT_EQ(0, pacer.Allow(0.0, 1000, true, wait));
+    EXPECT_DOUBLE_EQ(0.5, wait);
+    ASSERT_EQ(1000, pacer.Allow(0.5, 1000, true, wait));
+}
+
+TEST(PacerTests, PacerTests_OversizedDatagramSentOnFullBurst_Test) {
+    SystemUtils::Pacer pacer;
+    pacer.SetRate(1000.0, 1000.0);
+    double wait = 0.0;
+    ASSERT_EQ(3000, pacer.Allow(0.0, 3000, true, wait));
+    pacer.Consume(0.0, 3000);
+    ASSERT_EQ(0, pacer.Allow(2.0, 3000, true, wait));
+    EXPECT_DOUBLE_EQ(1.0, wait);
+    ASSERT_EQ(3000, pacer.Allow(3.0, 3000, true, wait));
+}
+
+TEST(PacerTests, PacerTests_ThrottledTimeMeasured_Test) {
+    SystemUtils::Pacer pacer;
+    pacer.SetRate(100.0, 100.0);
+    double wait = 0.0;
+    pacer.Consume(0.0, 100);
+    ASSERT_EQ(0, pacer.Allow(0.0, 100, true, wait));
+    ASSERT_EQ(0, pacer.Allow(0.5, 100, true, wait));
+    auto statistics = pacer.GetStatistics(0.75);
+    EXPECT_EQ(1, statistics.throttles);
+    EXPECT_DOUBLE_EQ(0.75, statistics.throttledTime);
+    ASSERT_EQ(100, pacer.Allow(1.0, 100, true, wait));
+    statistics = pacer.GetStatistics(2.0);
+    EXPECT_EQ(1, statistics.throttles);
+    EXPECT_DOUBLE_EQ(1.0, statistics.throttledTime);
+    EXPECT_EQ(100, statistics.bytesSent);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file PeerTableTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::PeerTable class template.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <PeerTable.hpp>
+#include <stdlib.h>
+
+TEST(PeerTableTests, PeerTableTests_InsertFindErase_Test) {
+    SystemUtils::PeerTable< int > table;
+    ASSERT_EQ(nullptr, table.Find(0x7F000001, 1234));
+    (void)table.Insert(0x7F000001, 1234, 42);
+    (void)table.Insert(0x7F000001, 1235, 43);
+    ASSERT_EQ(2, table.GetSize());
+    ASSERT_NE(nullptr, table.Find(0x7F000001, 1234));
+    EXPECT_EQ(42, *table.Find(0x7F000001, 1234));
+    EXPECT_EQ(43, *table.Find(0x7F000001, 1235));
+    EXPECT_EQ(nullptr, table.Find(0x7F000002, 1234));
+    (void)table.Insert(0x7F000001, 1234, 44);
+    EXPECT_EQ(2, table.GetSize());
+    EXPECT_EQ(44, *table.Find(0x7F000001, 1234));
+    EXPECT_TRUE(table.Erase(0x7F000001, 1234));
+    EXPECT_FALSE(table.Erase(0x7F000001, 1234));
+    EXPECT_EQ(nullptr, table.Find(0x7F000001, 1234));
+    EXPECT_EQ(43, *table.Find(0x7F000001, 1235));
+    EXPECT_EQ(1, table.GetSize());
+}
+
+TEST(PeerTableTests, PeerTableTests_MatchesMapUnderChurn_Test) {
+    SystemUtils::PeerTable< int > table;
+    std::map< std::pair< uint32_t, uint16_t >, int > reference;
+    srand(1);
+    for (int i = 0; i < 20000; ++i) {
+        const auto address = (uint32_t)(0x0A000000 + rand() % 64);
+        const auto port = (uint16_t)(rand() % 16);
+        const auto key = std::make_pair(address, port);
+        if (rand() % 3 == 0) {
+            ASSERT_EQ(reference.erase(key) == 1, table.Erase(address, port));
+        } else {
+            (void)table.Insert(address, port, i);
+            reference[key] = i;
+        }
+        ASSERT_EQ(reference.size(), table.GetSize());
+    }
+    for (uint32_t address = 0x0A000000; address < 0x0A000040; ++address) {
+        for (uint16_t port = 0; port < 16; ++port) {
+            const auto entry = reference.find(std::make_pair(address, port));
+            const auto value = table.Find(address, port);
+            if (entry == reference.end()) {
+                ASSERT_EQ(nullptr, value);
+            } else {
+                ASSERT_NE(nullptr, value);
+                ASSERT_EQ(entry->second, *value);
+            }
+        }
+    }
+}
+
+TEST(PeerTableTests, PeerTableTests_EraseIf_Test) {
+    SystemUtils::PeerTable< int > table;
+    for (uint16_t port = 0; port < 100; ++port) {
+        (void)table.Insert(0x7F000001, port, port);
+    }
+    EXPECT_EQ(
+        50,
+        table.EraseIf(
+            [](uint32_t, uint16_t, int value){
+                return (value % 2 == 0);
+            }
+        )
+    );
+    EXPECT_EQ(50, table.GetSize());
+    for (uint16_t port = 0; port < 100; ++port) {
+        EXPECT_EQ((port % 2 == 0), (table.Find(0x7F000001, port) == nullptr));
+    }
+    table.Clear();
+    EXPECT_EQ(0, table.GetSize());
+    EXPECT_EQ(nullptr, table.Find(0x7F000001, 1));
+}
@@ -0,0 +1,102 @@
+/**
+ * @file ResourceBundleTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::ResourceBundle class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <SystemUtils/File.hpp>
+#include <SystemUtils/ResourceBundle.hpp>
+#include <vector>
+
+struct ResourceBundleTests: public ::testing::Test
+{
+    std::string testDirectoryPath;
+
+    virtual void SetUp() {
+        testDirectoryPath = SystemUtils::File::GetExeParentDirectory() + "/testResourceBundleDirectory";
+        ASSERT_TRUE(SystemUtils::File::CreateDirectory(testDirectoryPath));
+    }
+
+    virtual void TearDown() {
+        ASSERT_TRUE(SystemUtils::File::DeleteDirectory(testDirectoryPath));
+    }
+
+    /**
+     * This method makes a file in the test directory
+     * with the given name and contents.
+     *
+     * @param[in] name
+     *      This is the name of the file to make.
+     *
+     * @param[in] contents
+     *      These are the contents to put in the file.
+     *
+     * @return
+     *      The path to the file is returned.
+     */
+    std::string MakeFile(const std::string& name, const std::string& contents) {
+        const auto path = testDirectoryPath + "/" + name;
+        SystemUtils::File file(path);
+        EXPECT_TRUE(file.OpenReadWrite());
+        EXPECT_EQ(contents.length(), file.Write(contents.data(), contents.length()));
+        return path;
+    }
+};
+
+TEST_F(ResourceBundleTests, ResourceBundleTests_PackAndOpen_Test) {
+    const std::map< std::string, std::string > resources{
+        {"config/settings.json", MakeFile("settings.json", "{\"answer\": 42}")},
+        {"empty", MakeFile("empty.txt", "")},
+        {"greeting.txt", MakeFile("greeting.txt", "Hello, World!")},
+    };
+    const auto bundlePath = testDirectoryPath + "/bundle.bin";
+    ASSERT_TRUE(SystemUtils::ResourceBundle::Pack(resources, bundlePath));
+    SystemUtils::ResourceBundle bundle;
+    ASSERT_TRUE(bundle.Open(bundlePath));
+    EXPECT_EQ(
+        (std::vector< std::string >{"config/settings.json", "empty", "greeting.txt"}),
+        bundle.GetResourceNames()
+    );
+    EXPECT_TRUE(bundle.HasResource("empty"));
+    EXPECT_FALSE(bundle.HasResource("greeting"));
+    EXPECT_FALSE(bundle.HasResource("missing"));
+    EXPECT_TRUE(bundle.GetResource("missing") == nullptr);
+    auto greeting = bundle.GetResource("greeting.txt");
+    ASSERT_FALSE(greeting == nullptr);
+    ASSERT_EQ(13, greeting->GetSize());
+    SystemUtils::IFile::Buffer buffer(5);
+    ASSERT_EQ(5, greeting->Read(buffer));
+    EXPECT_EQ("Hello", std::string(buffer.begin(), buffer.end()));
+    EXPECT_EQ(5, greeting->GetPosition());
+    EXPECT_EQ(0, greeting->Write(buffer));
+    const auto empty = bundle.GetResource("empty");
+    ASSERT_FALSE(empty == nullptr);
+    EXPECT_EQ(0, empty->GetSize());
+    const auto settings = bundle.GetResource("config/settings.json");
+    ASSERT_FALSE(settings == nullptr);
+    std::string settingsContents((size_t)settings->GetSize(), 0);
+    ASSERT_EQ(settingsContents.length(), settings->ReadAt(0, &settingsContents[0], settingsContents.length()));
+    EXPECT_EQ("{\"answer\": 42}", settingsContents);
+
+    // Resources stay readable after the bundle is closed.
+    bundle.Close();
+    EXPECT_FALSE(bundle.HasResource("greeting.txt"));
+    std::string rest(8, 0);
+    ASSERT_EQ(rest.length(), greeting->Read(&rest[0], rest.length()));
+    EXPECT_EQ(", World!", rest);
+    EXPECT_EQ(0, greeting->Read(&rest[0], rest.length()));
+    greeting.reset();
+}
+
+TEST_F(ResourceBundleTests, ResourceBundleTests_OpenInvalidBundle_Test) {
+    SystemUtils::ResourceBundle bundle;
+    EXPECT_FALSE(bundle.Open(testDirectoryPath + "/missing.bin"));
+    EXPECT_FALSE(bundle.Open(MakeFile("notABundle.bin", "This is not a bundle at all.")));
+    EXPECT_TRUE(bundle.GetResourceNames().empty());
+}
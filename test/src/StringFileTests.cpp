@@ -167,6 +167,96 @@ TEST(StringFileTests, StringFileTests_Remove_Test) {
     ASSERT_EQ("", (std::string)sf);
 }
 
+TEST(StringFileTests, StringFileTests_RemoveInterleavedWithWrites_Test) {
+    SystemUtils::StringFile sf;
+    std::string expected;
+    for (size_t i = 0; i < 100; ++i) {
+        const std::string chunk = std::to_string(i) + ",";
+        sf.SetPosition(sf.GetSize());
+        ASSERT_EQ(chunk.length(), sf.Write(chunk.data(), chunk.length()));
+        expected += chunk;
+        if ((i % 3) == 2) {
+            sf.Remove(4);
+            expected.erase(0, 4);
+        }
+        ASSERT_EQ(expected.length(), sf.GetSize());
+        ASSERT_EQ(expected, (std::string)sf);
+    }
+    sf.SetPosition(0);
+    std::string contents(expected.length(), '\0');
+    ASSERT_EQ(expected.length(), sf.Read(&contents[0], contents.length()));
+    EXPECT_EQ(expected, contents);
+}
 
+TEST(StringFileTests, StringFileTests_LargerThan64KiB_Test) {
+    const size_t size = 3 * 65536 + 17;
+    std::vector< uint8_t > data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = (uint8_t)(i * 7);
+    }
+    SystemUtils::StringFile sf;
+    ASSERT_EQ(size, sf.Write(data.data(), size));
+    EXPECT_EQ(size, sf.GetSize());
+    EXPECT_EQ(size, sf.GetPosition());
+    sf.SetPosition(0);
+    std::vector< uint8_t > readBack(size);
+    ASSERT_EQ(size, sf.Read(readBack.data(), size));
+    EXPECT_EQ(data, readBack);
+    sf.Remove(65536);
+    EXPECT_EQ(size - 65536, sf.GetSize());
+    uint8_t byte;
+    ASSERT_EQ(1, sf.ReadAt(0, &byte, 1));
+    EXPECT_EQ(data[65536], byte);
+}
 
+TEST(StringFileTests, StringFileTests_ReadAtWriteAt_Test) {
+    SystemUtils::StringFile sf("Hello, World!");
+    sf.SetPosition(3);
+    char buffer[5];
+    ASSERT_EQ(5, sf.ReadAt(7, buffer, sizeof(buffer)));
+    EXPECT_EQ("World", std::string(buffer, sizeof(buffer)));
+    EXPECT_EQ(3, sf.ReadAt(10, buffer, sizeof(buffer)));
+    EXPECT_EQ("ld!", std::string(buffer, 3));
+    EXPECT_EQ(0, sf.ReadAt(13, buffer, sizeof(buffer)));
+    EXPECT_EQ(0, sf.ReadAt(100, buffer, sizeof(buffer)));
+    ASSERT_EQ(5, sf.WriteAt(0, "Howdy", 5));
+    ASSERT_EQ(2, sf.WriteAt(15, "!!", 2));
+    EXPECT_EQ(3, sf.GetPosition());
+    EXPECT_EQ(std::string("Howdy, World!\0\0!!", 17), (std::string)sf);
+}
 
+TEST(StringFileTests, StringFileTests_ReadVWriteV_Test) {
+    SystemUtils::StringFile sf;
+    const std::string header = "HDR:";
+    const std::string payload = "Hello, World!";
+    ASSERT_EQ(
+        header.length() + payload.length(),
+        sf.WriteV({
+            {header.data(), header.length()},
+            {nullptr, 0},
+            {payload.data(), payload.length()},
+        })
+    );
+    EXPECT_EQ(header.length() + payload.length(), sf.GetPosition());
+    EXPECT_EQ(2, sf.WriteVAt(1, {{"d", 1}, {"r", 1}}));
+    EXPECT_EQ(header.length() + payload.length(), sf.GetPosition());
+    sf.SetPosition(0);
+    char first[2];
+    char second[7];
+    char third[20];
+    EXPECT_EQ(
+        17,
+        sf.ReadV({
+            {first, sizeof(first)},
+            {second, sizeof(second)},
+            {third, sizeof(third)},
+        })
+    );
+    EXPECT_EQ("Hd", std::string(first, sizeof(first)));
+    EXPECT_EQ("r:Hello", std::string(second, sizeof(second)));
+    EXPECT_EQ(", World!", std::string(third, 8));
+    EXPECT_EQ(17, sf.GetPosition());
+    EXPECT_EQ(9, sf.ReadVAt(4, {{second, 5}, {third, 4}}));
+    EXPECT_EQ("Hello", std::string(second, 5));
+    EXPECT_EQ(", Wo", std::string(third, 4));
+}
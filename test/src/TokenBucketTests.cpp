@@ -0,0 +1,65 @@
+/**
+ * @file TokenBucketTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::TokenBucket class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <TokenBucket.hpp>
+
+TEST(TokenBucketTests, TokenBucketTests_UnlimitedByDefault_Test) {
+    SystemUtils::TokenBucket bucket;
+    ASSERT_FALSE(bucket.IsLimited());
+    for (size_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(bucket.TryTake(0.0));
+    }
+}
+
+TEST(TokenBucketTests, TokenBucketTests_BurstUpToCapacity_Test) {
+    SystemUtils::TokenBucket bucket(10.0, 3.0);
+    ASSERT_TRUE(bucket.IsLimited());
+    ASSERT_TRUE(bucket.TryTake(5.0));
+    ASSERT_TRUE(bucket.TryTake(5.0));
+    ASSERT_TRUE(bucket.TryTake(5.0));
+    ASSERT_FALSE(bucket.TryTake(5.0));
+}
+
+TEST(TokenBucketTests, TokenBucketTests_RefillsAtRate_Test) {
+    SystemUtils::TokenBucket bucket(10.0, 2.0);
+    ASSERT_TRUE(bucket.TryTake(1.0));
+    ASSERT_TRUE(bucket.TryTake(1.0));
+    ASSERT_FALSE(bucket.TryTake(1.05));
+    ASSERT_TRUE(bucket.TryTake(1.1));
+    ASSERT_FALSE(bucket.TryTake(1.1));
+    ASSERT_TRUE(bucket.TryTake(100.0));
+    ASSERT_TRUE(bucket.TryTake(100.0));
+    ASSERT_FALSE(bucket.TryTake(100.0));
+}
+
+TEST(TokenBucketTests, TokenBucketTests_TakeSeveralTokens_Test) {
+    SystemUtils::TokenBucket bucket(100.0, 1500.0);
+    ASSERT_TRUE(bucket.TryTake(0.0, 1000.0));
+    ASSERT_FALSE(bucket.TryTake(0.0, 1000.0));
+    ASSERT_TRUE(bucket.TryTake(5.0, 1000.0));
+}
+
+TEST(TokenBucketTests, TokenBucketTests_TakeIntoDebt_Test) {
+    SystemUtils::TokenBucket bucket(100.0, 1000.0);
+    bucket.Take(0.0, 1500.0);
+    ASSERT_EQ(-500.0, bucket.GetAvailable(0.0));
+    ASSERT_FALSE(bucket.TryTake(4.0, 1.0));
+    ASSERT_EQ(0.0, bucket.GetAvailable(5.0));
+    ASSERT_TRUE(bucket.TryTake(6.0, 100.0));
+}
+
+TEST(TokenBucketTests, TokenBucketTests_WaitTime_Test) {
+    SystemUtils::TokenBucket bucket(100.0, 1000.0);
+    ASSERT_EQ(0.0, bucket.GetWaitTime(0.0, 1000.0));
+    ASSERT_TRUE(bucket.TryTake(0.0, 1000.0));
+    ASSERT_EQ(2.0, bucket.GetWaitTime(0.0, 200.0));
+    ASSERT_EQ(10.0, bucket.GetWaitTime(0.0, 5000.0));
+    ASSERT_EQ(1.0, bucket.GetWaitTime(1.0, 200.0));
+}
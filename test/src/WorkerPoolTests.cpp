@@ -0,0 +1,62 @@
+/**
+ * @file WorkerPoolTests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::WorkerPool class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <WorkerPool.hpp>
+
+TEST(WorkerPoolTests, WorkerPoolTests_RunsPostedTasks_Test) {
+    SystemUtils::WorkerPool pool(4);
+    std::atomic< int > sum(0);
+    for (int i = 1; i <= 100; ++i) {
+        pool.Post([&sum, i]{ sum += i; });
+    }
+    pool.Wait();
+    EXPECT_EQ(5050, sum);
+}
+
+TEST(WorkerPoolTests, WorkerPoolTests_WaitsForTasksPostedByTasks_Test) {
+    SystemUtils::WorkerPool pool(3);
+    std::atomic< int > count(0);
+    std::function< void(int) > spawn;
+    spawn = [&pool, &count, &spawn](int depth){
+        ++count;
+        if (depth < 8) {
+            pool.Post([&spawn, depth]{ spawn(depth + 1); });
+            pool.Post([&spawn, depth]{ spawn(depth + 1); });
+        }
+    };
+    pool.Post([&spawn]{ spawn(0); });
+    pool.Wait();
+    EXPECT_EQ(511, count);
+}
+
+TEST(WorkerPoolTests, WorkerPoolTests_UsesSeveralThreads_Test) {
+    SystemUtils::WorkerPool pool(4);
+    std::mutex mutex;
+    std::set< std::thread::id > threadIds;
+    std::atomic< int > started(0);
+    for (int i = 0; i < 4; ++i) {
+        pool.Post(
+            [&]{
+                ++started;
+                while (started < 4) {
+                    std::this_thread::yield();
+                }
+                std::lock_guard< std::mutex > lock(mutex);
+                (void)threadIds.insert(std::this_thread::get_id());
+            }
+        );
+    }
+    pool.Wait();
+    EXPECT_EQ(4, threadIds.size());
+}
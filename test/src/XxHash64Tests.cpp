@@ -0,0 +1,82 @@
+/**
+ * @file XxHash64Tests.cpp
+ *
+ * This module contains the unit tests of the
+ * SystemUtils::XxHash64 class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+#include <SystemUtils/StringFile.hpp>
+#include <SystemUtils/XxHash64.hpp>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function returns the test pattern used to check
+     * hashes of larger amounts of data.
+     *
+     * @return
+     *      The test pattern is returned.
+     */
+    std::vector< uint8_t > MakePattern() {
+        std::vector< uint8_t > pattern(10240);
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            pattern[i] = (uint8_t)i;
+        }
+        return pattern;
+    }
+
+}
+
+TEST(XxHash64Tests, XxHash64Tests_KnownValues_Test) {
+    EXPECT_EQ(0xEF46DB3751D8E999ULL, SystemUtils::XxHash64::Compute(nullptr, 0));
+    EXPECT_EQ(0x44BC2CF5AD770999ULL, SystemUtils::XxHash64::Compute("abc", 3));
+    EXPECT_EQ(0x8CB841DB40E6AE83ULL, SystemUtils::XxHash64::Compute("123456789", 9));
+    const auto pattern = MakePattern();
+    EXPECT_EQ(0x58B820AA7970DBE2ULL, SystemUtils::XxHash64::Compute(pattern.data(), pattern.size()));
+    EXPECT_EQ(0x4CB9B11211D5B1A0ULL, SystemUtils::XxHash64::Compute(pattern.data(), 1024, 42));
+}
+
+TEST(XxHash64Tests, XxHash64Tests_StreamedInPieces_Test) {
+    const auto pattern = MakePattern();
+    SystemUtils::XxHash64 hash;
+    size_t offset = 0;
+    for (size_t pieceSize = 1; offset < pattern.size(); ++pieceSize) {
+        const auto amount = std::min(pieceSize, pattern.size() - offset);
+        hash.Update(pattern.data() + offset, amount);
+        offset += amount;
+    }
+    EXPECT_EQ(0x58B820AA7970DBE2ULL, hash.GetValue());
+    hash.Reset();
+    EXPECT_EQ(0xEF46DB3751D8E999ULL, hash.GetValue());
+}
+
+TEST(XxHash64Tests, XxHash64Tests_FromFile_Test) {
+    SystemUtils::StringFile file(MakePattern());
+    SystemUtils::XxHash64 hash;
+    ASSERT_TRUE(hash.Update(file));
+    EXPECT_EQ(0x58B820AA7970DBE2ULL, hash.GetValue());
+    EXPECT_FALSE(hash.Update(file, 10000, 1000));
+}
+
+TEST(XxHash64Tests, XxHash64Tests_ChunksInParallel_Test) {
+    SystemUtils::StringFile file(MakePattern());
+    std::vector< uint64_t > hashes;
+    ASSERT_TRUE(SystemUtils::XxHash64::ComputeChunks(file, hashes, 0, 0, 3, 4096));
+    EXPECT_EQ(
+        (std::vector< uint64_t >{
+            0x0F6E64BE186AF6A4ULL,
+            0x0F6E64BE186AF6A4ULL,
+            0x68534A48B7BF5F4DULL,
+        }),
+        hashes
+    );
+    std::vector< uint64_t > serialHashes;
+    ASSERT_TRUE(SystemUtils::XxHash64::ComputeChunks(file, serialHashes, 0, 0, 1, 4096));
+    EXPECT_EQ(hashes, serialHashes);
+}
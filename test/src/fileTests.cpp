@@ -7,7 +7,11 @@
  * © 2024 by Hatem Nabli
 */
 
+#include <algorithm>
 #include <set>
+#include <string.h>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <SystemUtils/File.hpp>
 
@@ -205,3 +209,357 @@ TEST_F(FileTests, FileTests_WriteAndReadBack__Test) {
     ASSERT_EQ(testString.length(), file.Read(buffer));
     ASSERT_EQ(testString, std::string(buffer.begin(), buffer.end()));
 }
+
+TEST_F(FileTests, FileTests_MapReadOnly_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const std::string testString = "Hello, World!\r\n";
+    ASSERT_EQ(testString.length(), file.Write(testString.data(), testString.length()));
+    file.Close();
+    ASSERT_TRUE(file.OpenReadOnly());
+    ASSERT_TRUE(file.Map(0, 0, SystemUtils::File::MapMode::SharedWritable) == nullptr);
+    const auto view = file.Map(7, 5, SystemUtils::File::MapMode::ReadOnly, true);
+    ASSERT_FALSE(view == nullptr);
+    ASSERT_EQ(5, view->GetSize());
+    ASSERT_EQ("World", std::string((const char*)view->GetData(), view->GetSize()));
+    const auto wholeView = file.Map(0, 0, SystemUtils::File::MapMode::ReadOnly);
+    ASSERT_FALSE(wholeView == nullptr);
+    ASSERT_EQ(testString, std::string((const char*)wholeView->GetData(), wholeView->GetSize()));
+
+    // Verify that views are unmapped when the file is closed.
+    file.Close();
+    EXPECT_TRUE(view->GetData() == nullptr);
+    EXPECT_EQ(0, view->GetSize());
+    EXPECT_TRUE(wholeView->GetData() == nullptr);
+}
+
+TEST_F(FileTests, FileTests_MapSharedWritable_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const auto view = file.Map(0, 13, SystemUtils::File::MapMode::SharedWritable);
+    ASSERT_FALSE(view == nullptr);
+    ASSERT_EQ(13, file.GetSize());
+    const std::string testString = "Hello, World!";
+    (void)memcpy(view->GetData(), testString.data(), testString.length());
+    ASSERT_TRUE(view->Flush(7, 5));
+    ASSERT_TRUE(view->Flush());
+    view->Unmap();
+    EXPECT_TRUE(view->GetData() == nullptr);
+    EXPECT_FALSE(view->Flush());
+
+    // Verify that the writes went to the file.
+    SystemUtils::IFile::Buffer buffer(testString.length());
+    file.SetPosition(0);
+    ASSERT_EQ(testString.length(), file.Read(buffer));
+    ASSERT_EQ(testString, std::string(buffer.begin(), buffer.end()));
+}
+
+TEST_F(FileTests, FileTests_ReadAtWriteAt_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const std::string testString = "Hello, World!";
+    ASSERT_EQ(testString.length(), file.WriteAt(0, testString.data(), testString.length()));
+    ASSERT_EQ(0, file.GetPosition());
+    ASSERT_EQ(2, file.WriteAt(15, "!!", 2));
+    ASSERT_EQ(17, file.GetSize());
+    file.SetPosition(3);
+    char buffer[5];
+    ASSERT_EQ(5, file.ReadAt(7, buffer, sizeof(buffer)));
+    EXPECT_EQ("World", std::string(buffer, sizeof(buffer)));
+    EXPECT_EQ(2, file.ReadAt(15, buffer, sizeof(buffer)));
+    EXPECT_EQ(0, file.ReadAt(100, buffer, sizeof(buffer)));
+    EXPECT_EQ(3, file.GetPosition());
+    ASSERT_EQ(2, file.Read(buffer, 2));
+    EXPECT_EQ("lo", std::string(buffer, 2));
+    EXPECT_EQ(5, file.GetPosition());
+}
+
+TEST_F(FileTests, FileTests_ConcurrentReadAt_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    std::vector< uint8_t > contents(1024 * 1024);
+    for (size_t i = 0; i < contents.size(); ++i) {
+        contents[i] = (uint8_t)(i * 7 + i / 256);
+    }
+    ASSERT_EQ(contents.size(), file.Write(contents.data(), contents.size()));
+    const size_t numThreads = 8;
+    const size_t chunkSize = contents.size() / numThreads;
+    std::vector< std::vector< uint8_t > > chunks(numThreads);
+    std::vector< std::thread > threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(
+            [&file, &chunks, chunkSize, i]{
+                chunks[i].resize(chunkSize);
+                (void)file.ReadAt(i * chunkSize, chunks[i].data(), chunkSize);
+            }
+        );
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < numThreads; ++i) {
+        EXPECT_TRUE(
+            std::equal(
+                chunks[i].begin(),
+                chunks[i].end(),
+                contents.begin() + i * chunkSize
+            )
+        ) << "chunk " << i;
+    }
+    EXPECT_EQ(contents.size(), file.GetPosition());
+}
+
+TEST_F(FileTests, FileTests_CopyDirectoryWithProgress_Test) {
+    const std::string sourcePath = testDirectoryPath + "/source";
+    uint64_t totalBytes = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            SystemUtils::File file(
+                sourcePath + "/dir" + std::to_string(i)
+                + "/deeper/file" + std::to_string(j) + ".txt"
+            );
+            ASSERT_TRUE(file.OpenReadWrite());
+            const auto contents = std::to_string(i * 100 + j);
+            ASSERT_EQ(contents.length(), file.Write(contents.data(), contents.length()));
+            totalBytes += contents.length();
+        }
+    }
+    const std::string destinationPath = testDirectoryPath + "/destination";
+    std::vector< SystemUtils::File::CopyProgress > reports;
+    const auto progressDelegate = [&reports](const SystemUtils::File::CopyProgress& progress){
+        reports.push_back(progress);
+    };
+    ASSERT_TRUE(SystemUtils::File::CopyDirectory(sourcePath, destinationPath, progressDelegate));
+    ASSERT_EQ(40, reports.size());
+    EXPECT_EQ(40, reports.back().filesCopied);
+    EXPECT_EQ(0, reports.back().filesSkipped);
+    EXPECT_EQ(totalBytes, reports.back().bytesCopied);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            SystemUtils::File file(
+                destinationPath + "/dir" + std::to_string(i)
+                + "/deeper/file" + std::to_string(j) + ".txt"
+            );
+            ASSERT_TRUE(file.OpenReadOnly());
+            SystemUtils::IFile::Buffer buffer((size_t)file.GetSize());
+            ASSERT_EQ(buffer.size(), file.Read(buffer));
+            EXPECT_EQ(std::to_string(i * 100 + j), std::string(buffer.begin(), buffer.end()));
+        }
+    }
+
+    // Copying again skips all the files, except one changed in between.
+    {
+        SystemUtils::File file(sourcePath + "/dir2/deeper/file3.txt");
+        ASSERT_TRUE(file.OpenReadWrite());
+        ASSERT_EQ(3, file.WriteAt(3, "abc", 3));
+    }
+    reports.clear();
+    ASSERT_TRUE(SystemUtils::File::CopyDirectory(sourcePath, destinationPath, progressDelegate));
+    ASSERT_EQ(40, reports.size());
+    EXPECT_EQ(1, reports.back().filesCopied);
+    EXPECT_EQ(39, reports.back().filesSkipped);
+    EXPECT_EQ(6, reports.back().bytesCopied);
+}
+
+TEST_F(FileTests, FileTests_PreallocateAndSync_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const std::string testString = "Hello, World!";
+    ASSERT_EQ(testString.length(), file.Write(testString.data(), testString.length()));
+    ASSERT_TRUE(file.Preallocate(1024 * 1024));
+    EXPECT_EQ(testString.length(), file.GetSize());
+    ASSERT_TRUE(file.Preallocate(4));
+    EXPECT_EQ(testString.length(), file.GetSize());
+    EXPECT_TRUE(file.Sync());
+}
+
+TEST_F(FileTests, FileTests_DirectIo_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite(SystemUtils::File::CacheMode::Direct));
+    const auto blockSize = file.GetBlockSize();
+    ASSERT_GT(blockSize, 0);
+    auto output = file.AllocateBuffer(blockSize + 1);
+    ASSERT_EQ(blockSize * 2, output.GetSize());
+    EXPECT_EQ(0, (uintptr_t)output.GetData() % blockSize);
+    for (size_t i = 0; i < output.GetSize(); ++i) {
+        ((uint8_t*)output.GetData())[i] = (uint8_t)i;
+    }
+    ASSERT_EQ(output.GetSize(), file.WriteAt(0, output.GetData(), output.GetSize()));
+    auto input = file.AllocateBuffer(output.GetSize());
+    ASSERT_EQ(input.GetSize(), file.ReadAt(0, input.GetData(), input.GetSize()));
+    EXPECT_EQ(0, memcmp(output.GetData(), input.GetData(), input.GetSize()));
+    EXPECT_TRUE(file.GetLastError().empty());
+    EXPECT_EQ(0, file.ReadAt(1, input.GetData(), blockSize));
+    EXPECT_FALSE(file.GetLastError().empty());
+    EXPECT_EQ(0, file.ReadAt(0, input.GetData(), blockSize - 1));
+    EXPECT_EQ(0, file.ReadAt(0, (uint8_t*)input.GetData() + 1, blockSize));
+}
+
+TEST_F(FileTests, FileTests_Advise_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const std::string testString = "Hello, World!";
+    ASSERT_EQ(testString.length(), file.Write(testString.data(), testString.length()));
+    const auto view = file.Map(0, 0, SystemUtils::File::MapMode::ReadOnly);
+    ASSERT_FALSE(view == nullptr);
+    EXPECT_TRUE(file.Advise(SystemUtils::File::AccessHint::Sequential));
+    EXPECT_TRUE(file.Advise(SystemUtils::File::AccessHint::WillNeed, 0, 5));
+    EXPECT_TRUE(file.Advise(SystemUtils::File::AccessHint::DontNeed, 0, 5));
+    EXPECT_TRUE(view->Advise(SystemUtils::File::AccessHint::WillNeed));
+    EXPECT_TRUE(view->Advise(SystemUtils::File::AccessHint::DontNeed, 7));
+    EXPECT_TRUE(file.Advise(SystemUtils::File::AccessHint::Random));
+    EXPECT_EQ(testString, std::string((const char*)view->GetData(), view->GetSize()));
+    std::string readBack(testString.length(), 0);
+    ASSERT_EQ(testString.length(), file.ReadAt(0, &readBack[0], readBack.length()));
+    EXPECT_EQ(testString, readBack);
+    EXPECT_TRUE(view->Flush());
+    EXPECT_TRUE(file.Advise(SystemUtils::File::AccessHint::Normal));
+}
+
+TEST_F(FileTests, FileTests_GetMetadata_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    auto metadata = file.GetMetadata();
+    EXPECT_FALSE(metadata.exists);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const std::string testString = "Hello, World!";
+    ASSERT_EQ(testString.length(), file.Write(testString.data(), testString.length()));
+    metadata = file.GetMetadata();
+    EXPECT_TRUE(metadata.exists);
+    EXPECT_FALSE(metadata.isDirectory);
+    EXPECT_EQ(testString.length(), metadata.size);
+    EXPECT_NE(0, metadata.lastModifiedTime);
+    EXPECT_NE(0, metadata.changeTime);
+    file.Close();
+    const auto closedMetadata = file.GetMetadata();
+    EXPECT_TRUE(closedMetadata.exists);
+    EXPECT_EQ(metadata.size, closedMetadata.size);
+    EXPECT_EQ(metadata.fileId, closedMetadata.fileId);
+    EXPECT_EQ(metadata.deviceId, closedMetadata.deviceId);
+    EXPECT_EQ(
+        (time_t)(closedMetadata.lastModifiedTime / 1000000000),
+        file.GetLastModifiedTime()
+    );
+    const auto batch = SystemUtils::File::GetMetadata(
+        {testFilePath, testDirectoryPath, testDirectoryPath + "/missing.txt"},
+        2
+    );
+    ASSERT_EQ(3, batch.size());
+    EXPECT_TRUE(batch[0].exists);
+    EXPECT_EQ(metadata.fileId, batch[0].fileId);
+    EXPECT_TRUE(batch[1].exists);
+    EXPECT_TRUE(batch[1].isDirectory);
+    EXPECT_FALSE(batch[2].exists);
+}
+
+TEST_F(FileTests, FileTests_ReadVWriteV_Test) {
+    const std::string testFilePath = testDirectoryPath + "/toto.txt";
+    SystemUtils::File file(testFilePath);
+    ASSERT_TRUE(file.OpenReadWrite());
+    const std::string header = "HDR:";
+    std::vector< uint8_t > payload(100000);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = (uint8_t)i;
+    }
+    const std::string trailer = ":END";
+    const auto total = header.length() + payload.size() + trailer.length();
+    ASSERT_EQ(
+        total,
+        file.WriteV({
+            {header.data(), header.length()},
+            {payload.data(), payload.size()},
+            {trailer.data(), trailer.length()},
+        })
+    );
+    EXPECT_EQ(total, file.GetPosition());
+    EXPECT_EQ(total, file.GetSize());
+    std::string readHeader(header.length(), 0);
+    std::vector< uint8_t > readPayload(payload.size());
+    std::string readTrailer(trailer.length() + 10, 0);
+    EXPECT_EQ(
+        total,
+        file.ReadVAt(
+            0,
+            {
+                {&readHeader[0], readHeader.length()},
+                {readPayload.data(), readPayload.size()},
+                {&readTrailer[0], readTrailer.length()},
+            }
+        )
+    );
+    EXPECT_EQ(header, readHeader);
+    EXPECT_EQ(payload, readPayload);
+    EXPECT_EQ(trailer, readTrailer.substr(0, trailer.length()));
+    file.SetPosition(2);
+    char small[2];
+    EXPECT_EQ(4, file.ReadV({{small, 2}, {&readHeader[0], 2}}));
+    EXPECT_EQ("R:", std::string(small, 2));
+    EXPECT_EQ(6, file.GetPosition());
+}
+
+TEST_F(FileTests, FileTests_DeleteDirectoryParallel_Test) {
+    const std::string treePath = testDirectoryPath + "/tree";
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            SystemUtils::File file(
+                treePath + "/branch" + std::to_string(i) + "/twig" + std::to_string(j) + "/leaf.txt"
+            );
+            ASSERT_TRUE(file.OpenReadWrite());
+            ASSERT_EQ(4, file.Write("leaf", 4));
+        }
+    }
+    SystemUtils::File tree(treePath);
+    ASSERT_TRUE(tree.IsDirectory());
+    ASSERT_TRUE(SystemUtils::File::DeleteDirectory(treePath, 4));
+    EXPECT_FALSE(tree.IsExisting());
+    EXPECT_FALSE(SystemUtils::File::DeleteDirectory(treePath, 4));
+}
+
+TEST_F(FileTests, FileTests_DeleteDirectoryDeeperThanMaxPath_Test) {
+    // Build a chain of directories whose full path is much longer than
+    // MAX_PATH, by repeatedly moving the chain so far into a new
+    // directory, so that no path used to build it is itself long.
+    const std::string longName(50, 'd');
+    const std::string chainPath = testDirectoryPath + "/chain";
+    const std::string topPath = testDirectoryPath + "/top";
+    {
+        SystemUtils::File leaf(chainPath + "/leaf.txt");
+        ASSERT_TRUE(leaf.OpenReadWrite());
+        ASSERT_EQ(4, leaf.Write("leaf", 4));
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_TRUE(SystemUtils::File::CreateDirectory(topPath));
+        SystemUtils::File chain(chainPath);
+        ASSERT_TRUE(chain.Move(topPath + "/" + longName));
+        SystemUtils::File top(topPath);
+        ASSERT_TRUE(top.Move(chainPath));
+    }
+    ASSERT_TRUE(SystemUtils::File::DeleteDirectory(chainPath));
+    SystemUtils::File chain(chainPath);
+    EXPECT_FALSE(chain.IsExisting());
+}
+
+TEST_F(FileTests, FileTests_DeleteDirectoryInBackground_Test) {
+    const std::string treePath = testDirectoryPath + "/tree";
+    {
+        SystemUtils::File file(treePath + "/branch/leaf.txt");
+        ASSERT_TRUE(file.OpenReadWrite());
+        ASSERT_EQ(4, file.Write("leaf", 4));
+    }
+    ASSERT_TRUE(SystemUtils::File::DeleteDirectoryInBackground(treePath));
+    SystemUtils::File tree(treePath);
+    EXPECT_FALSE(tree.IsExisting());
+    ASSERT_TRUE(SystemUtils::File::CreateDirectory(treePath));
+    SystemUtils::File::WaitForBackgroundDeletions();
+    std::vector< std::string > names;
+    SystemUtils::File::ListDirectory(testDirectoryPath, names);
+    ASSERT_EQ(1, names.size());
+    EXPECT_EQ("/tree", names[0].substr(names[0].length() - 5));
+}
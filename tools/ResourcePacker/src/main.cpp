@@ -0,0 +1,61 @@
+/**
+ * @file main.cpp
+ *
+ * This module contains the ResourcePacker tool, which packs every
+ * file under a directory into a resource bundle, for use with the
+ * SystemUtils::ResourceBundle class.
+ *
+ * © 2024 by Hatem Nabli
+ */
+
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <SystemUtils/DirectoryIterator.hpp>
+#include <SystemUtils/ResourceBundle.hpp>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        (void)fprintf(stderr, "usage: ResourcePacker <bundle> <directory>\n");
+        return EXIT_FAILURE;
+    }
+    const std::string bundlePath = argv[1];
+    std::string directory = argv[2];
+    if (
+        !directory.empty()
+        && (directory.back() != '/')
+        && (directory.back() != '\\')
+    ) {
+        directory += '/';
+    }
+
+    // Each resource is named by its path relative to the
+    // directory, with forward slashes between its parts.
+    std::map< std::string, std::string > resources;
+    const auto walked = SystemUtils::DirectoryIterator::Walk(
+        directory,
+        [&](const SystemUtils::DirectoryIterator::Entry& entry){
+            if (entry.type == SystemUtils::DirectoryIterator::EntryType::File) {
+                auto name = entry.path.substr(directory.length());
+                for (auto& c: name) {
+                    if (c == '\\') {
+                        c = '/';
+                    }
+                }
+                resources[name] = entry.path;
+            }
+            return true;
+        }
+    );
+    if (!walked) {
+        (void)fprintf(stderr, "error: unable to list \"%s\"\n", directory.c_str());
+        return EXIT_FAILURE;
+    }
+    if (!SystemUtils::ResourceBundle::Pack(resources, bundlePath)) {
+        (void)fprintf(stderr, "error: unable to write \"%s\"\n", bundlePath.c_str());
+        return EXIT_FAILURE;
+    }
+    (void)printf("Packed %zu resources into \"%s\"\n", resources.size(), bundlePath.c_str());
+    return EXIT_SUCCESS;
+}